@@ -0,0 +1,66 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OSAttachmentDownload : NSObject
+
+// The caller's key for the download, such as the attachment identifier
+@property (strong, nonatomic, readonly) NSString *identifier;
+@property (strong, nonatomic, readonly) NSURL *URL;
+// The file to attach that the file block returned once the download finished, nil until then
+@property (strong, nonatomic, readonly, nullable) NSURL *fileURL;
+
+@end
+
+// Stores the downloaded file at location, which is removed once the block returns, and returns the file to attach
+// A 304 for a conditional request is passed on with an empty file. Called on the session's delegate queue
+typedef NSURL * _Nullable (^OSAttachmentFileBlock)(NSURL *URL, NSURLResponse *response, NSURL *location);
+
+/**
+ Downloads notification attachments concurrently on one shared session.
+ A batch blocks its caller until every download finished, its timeout passed or the downloads were cancelled,
+ and returns the downloads that finished. Downloads are cancelled as soon as they are known to be larger than
+ the size iOS accepts for their media type.
+ */
+@interface OSAttachmentDownloader : NSObject
+
++ (instancetype)sharedInstance;
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration maxBytesPerItem:(int64_t)maxBytesPerItem;
+
+- (NSArray<OSAttachmentDownload *> *)downloadRequests:(NSDictionary<NSString *, NSURLRequest *> *)requestsByIdentifier
+                                             timeout:(NSTimeInterval)timeout
+                                                file:(OSAttachmentFileBlock)fileBlock;
+
+// Cancels the downloads in flight, which makes a blocked batch return, and returns the ones that already finished
+- (NSArray<OSAttachmentDownload *> *)cancelDownloads;
+
+@end
+
+NS_ASSUME_NONNULL_END
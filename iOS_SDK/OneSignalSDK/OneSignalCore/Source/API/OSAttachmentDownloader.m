@@ -0,0 +1,239 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import "OSAttachmentDownloader.h"
+#import "OneSignalCommonDefines.h"
+#import "OneSignalLog.h"
+#import "OSMacros.h"
+
+@interface OSAttachmentDownloadBatch : NSObject
+@property (strong, nonatomic, nonnull) dispatch_group_t group;
+@property (strong, nonatomic, nonnull) NSArray<OSAttachmentDownload *> *downloads;
+@property (copy, nonatomic, nonnull) OSAttachmentFileBlock fileBlock;
+// Set once the batch returned, downloads finishing after that are discarded
+@property (nonatomic) BOOL closed;
+@end
+
+@implementation OSAttachmentDownloadBatch
+@end
+
+@interface OSAttachmentDownload ()
+@property (strong, nonatomic, readwrite) NSString *identifier;
+@property (strong, nonatomic, readwrite) NSURL *URL;
+@property (strong, nonatomic, readwrite, nullable) NSURL *fileURL;
+@property (strong, nonatomic) NSURLSessionDownloadTask *task;
+// Held until the task completes, so the group outlives every enter that is still to be balanced
+@property (strong, nonatomic) dispatch_group_t group;
+@property (weak, nonatomic) OSAttachmentDownloadBatch *batch;
+@end
+
+@implementation OSAttachmentDownload
+@end
+
+@interface OSAttachmentDownloader () <NSURLSessionDownloadDelegate>
+@end
+
+@implementation OSAttachmentDownloader {
+    NSURLSession *_session;
+    int64_t _maxBytesPerItem;
+    // Guarded by self
+    NSMutableDictionary<NSNumber *, OSAttachmentDownload *> *_downloadsByTask;
+    NSMutableSet<OSAttachmentDownloadBatch *> *_batches;
+}
+
++ (instancetype)sharedInstance {
+    static OSAttachmentDownloader *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        let configuration = NSURLSessionConfiguration.defaultSessionConfiguration;
+        // Media is only downloaded once per notification, keeping it in the URL cache would only use up the extension's memory
+        configuration.URLCache = nil;
+        configuration.timeoutIntervalForResource = MAX_NSE_ATTACHMENT_DOWNLOAD_SECONDS;
+        sharedInstance = [[OSAttachmentDownloader alloc] initWithSessionConfiguration:configuration maxBytesPerItem:MAX_NOTIFICATION_MEDIA_SIZE_BYTES];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration maxBytesPerItem:(int64_t)maxBytesPerItem {
+    if (self = [super init]) {
+        _maxBytesPerItem = maxBytesPerItem;
+        _downloadsByTask = [NSMutableDictionary new];
+        _batches = [NSMutableSet new];
+        let delegateQueue = [NSOperationQueue new];
+        delegateQueue.maxConcurrentOperationCount = 1;
+        delegateQueue.name = @"com.onesignal.attachmentDownloader";
+        _session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:delegateQueue];
+    }
+    return self;
+}
+
+- (NSArray<OSAttachmentDownload *> *)downloadRequests:(NSDictionary<NSString *, NSURLRequest *> *)requestsByIdentifier
+                                             timeout:(NSTimeInterval)timeout
+                                                file:(OSAttachmentFileBlock)fileBlock {
+    if (requestsByIdentifier.count == 0)
+        return @[];
+
+    let batch = [OSAttachmentDownloadBatch new];
+    batch.group = dispatch_group_create();
+    batch.fileBlock = fileBlock;
+
+    NSMutableArray<OSAttachmentDownload *> *downloads = [NSMutableArray new];
+    @synchronized (self) {
+        for (NSString *identifier in requestsByIdentifier) {
+            let download = [OSAttachmentDownload new];
+            download.identifier = identifier;
+            download.URL = requestsByIdentifier[identifier].URL;
+            download.task = [_session downloadTaskWithRequest:requestsByIdentifier[identifier]];
+            download.batch = batch;
+            download.group = batch.group;
+            _downloadsByTask[@(download.task.taskIdentifier)] = download;
+            dispatch_group_enter(batch.group);
+            [downloads addObject:download];
+        }
+        batch.downloads = downloads;
+        [_batches addObject:batch];
+    }
+
+    for (OSAttachmentDownload *download in downloads)
+        [download.task resume];
+
+    if (dispatch_group_wait(batch.group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC))) != 0)
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:@"Attachment downloads did not finish in time, showing the notification with the attachments that did"];
+
+    NSArray<OSAttachmentDownload *> *finished;
+    @synchronized (self) {
+        batch.closed = YES;
+        [_batches removeObject:batch];
+        finished = [self finishedDownloadsCancellingOthers:batch.downloads];
+    }
+    return finished;
+}
+
+- (NSArray<OSAttachmentDownload *> *)cancelDownloads {
+    NSMutableArray<OSAttachmentDownload *> *finished = [NSMutableArray new];
+    @synchronized (self) {
+        for (OSAttachmentDownloadBatch *batch in _batches)
+            [finished addObjectsFromArray:[self finishedDownloadsCancellingOthers:batch.downloads]];
+    }
+    return finished;
+}
+
+// Called while synchronized on self
+- (NSArray<OSAttachmentDownload *> *)finishedDownloadsCancellingOthers:(NSArray<OSAttachmentDownload *> *)downloads {
+    NSMutableArray<OSAttachmentDownload *> *finished = [NSMutableArray new];
+    for (OSAttachmentDownload *download in downloads) {
+        if (download.fileURL)
+            [finished addObject:download];
+        else
+            [download.task cancel];
+    }
+    return finished;
+}
+
+- (int64_t)maxBytesForResponse:(NSURLResponse *)response {
+    let MIMEType = response.MIMEType.lowercaseString;
+    int64_t maxBytes = _maxBytesPerItem;
+    if ([MIMEType hasPrefix:@"image/"])
+        maxBytes = MIN(maxBytes, MAX_NOTIFICATION_IMAGE_SIZE_BYTES);
+    else if ([MIMEType hasPrefix:@"audio/"])
+        maxBytes = MIN(maxBytes, MAX_NOTIFICATION_AUDIO_SIZE_BYTES);
+    return maxBytes;
+}
+
+- (OSAttachmentDownload *)downloadForTask:(NSURLSessionTask *)task {
+    @synchronized (self) {
+        return _downloadsByTask[@(task.taskIdentifier)];
+    }
+}
+
+#pragma mark NSURLSessionDownloadDelegate
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didWriteData:(int64_t)bytesWritten totalBytesWritten:(int64_t)totalBytesWritten totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite {
+    let maxBytes = [self maxBytesForResponse:downloadTask.response];
+    // Without a Content-Length the download is cancelled once it grows past the limit
+    if (totalBytesExpectedToWrite > maxBytes || totalBytesWritten > maxBytes) {
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Attachment at %@ is larger than %lld bytes, not downloading it", downloadTask.originalRequest.URL, maxBytes]];
+        [downloadTask cancel];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didFinishDownloadingToURL:(NSURL *)location {
+    let download = [self downloadForTask:downloadTask];
+    let response = downloadTask.response;
+    if (!download || !response)
+        return;
+
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        let statusCode = ((NSHTTPURLResponse *)response).statusCode;
+        if ((statusCode < 200 || statusCode >= 300) && statusCode != 304) {
+            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Attachment at %@ failed to download with status code %ld", download.URL, (long)statusCode]];
+            return;
+        }
+    }
+
+    NSNumber *size;
+    [location getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+    if (size.longLongValue > [self maxBytesForResponse:response])
+        return;
+
+    OSAttachmentFileBlock fileBlock;
+    @synchronized (self) {
+        let batch = download.batch;
+        if (!batch || batch.closed)
+            return;
+        fileBlock = batch.fileBlock;
+    }
+
+    // The file at location is removed once this returns, so it is stored here. The block may take file locks and copy,
+    // so it runs without holding self, which would stall cancelDownloads and the other delegate callbacks.
+    let fileURL = fileBlock(download.URL, response, location);
+
+    @synchronized (self) {
+        let batch = download.batch;
+        if (!batch || batch.closed) {
+            // Left to the block's owner to clean up, like any attachment file iOS does not take
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Attachment at %@ was stored after its notification was shown", download.URL]];
+            return;
+        }
+        download.fileURL = fileURL;
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    OSAttachmentDownload *download;
+    @synchronized (self) {
+        download = _downloadsByTask[@(task.taskIdentifier)];
+        [_downloadsByTask removeObjectForKey:@(task.taskIdentifier)];
+    }
+    if (!download)
+        return;
+    if (error && error.code != NSURLErrorCancelled)
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Encountered an error while attempting to download file with URL: %@", error]];
+    dispatch_group_leave(download.group);
+}
+
+@end
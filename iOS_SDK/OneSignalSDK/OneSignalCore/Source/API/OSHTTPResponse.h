@@ -0,0 +1,66 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The status, headers and body of a response, kept apart so the body is only decoded when, and how, it is read.
+ */
+@interface OSHTTPResponse : NSObject
+
+@property (nonatomic, readonly) NSInteger statusCode;
+@property (strong, nonatomic, readonly, nullable) NSDictionary *headers;
+@property (strong, nonatomic, readonly) NSData *data;
+
+// Looks up a header ignoring the case of its name
+- (NSString * _Nullable)valueForHeader:(NSString *)name;
+
+- (instancetype)initWithStatusCode:(NSInteger)statusCode headers:(NSDictionary * _Nullable)headers data:(NSData * _Nullable)data;
+// A response whose body is already decoded, ie: from mock clients
+- (instancetype)initWithStatusCode:(NSInteger)statusCode headers:(NSDictionary * _Nullable)headers JSONObject:(id _Nullable)JSONObject;
+
+/**
+ The body decoded with immutable containers on first access, or nil if the body is empty or not valid JSON.
+ Reading elements with `enumerateArrayForKey:usingBlock:` instead avoids holding the decoded body in memory at once.
+ */
+@property (nonatomic, readonly, nullable) id JSONObject;
+@property (strong, nonatomic, readonly, nullable) NSError *JSONError;
+
+/**
+ Decodes the elements of the array at `key` in the top level object one at a time, without decoding the rest of the body.
+ Returns false if the body is not an object with an array at `key`, or is not valid JSON up to where enumeration stopped.
+ */
+- (BOOL)enumerateArrayForKey:(NSString *)key usingBlock:(void (NS_NOESCAPE ^)(id element, BOOL *stop))block NS_SWIFT_NAME(enumerateArray(forKey:using:));
+
+@end
+
+typedef void (^OSResponseBlock)(OSHTTPResponse *response);
+
+NS_ASSUME_NONNULL_END
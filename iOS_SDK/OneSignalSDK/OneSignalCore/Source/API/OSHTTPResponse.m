@@ -0,0 +1,261 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSHTTPResponse.h"
+
+static void skipWhitespace(const uint8_t *bytes, NSUInteger length, NSUInteger *index) {
+    while (*index < length && (bytes[*index] == ' ' || bytes[*index] == '\t' || bytes[*index] == '\n' || bytes[*index] == '\r')) {
+        (*index)++;
+    }
+}
+
+// Moves past the string starting at index, which must be a quote
+static BOOL skipString(const uint8_t *bytes, NSUInteger length, NSUInteger *index, BOOL *escaped) {
+    (*index)++;
+    while (*index < length) {
+        uint8_t byte = bytes[(*index)++];
+        if (byte == '"') {
+            return true;
+        }
+        if (byte == '\\') {
+            if (escaped) {
+                *escaped = true;
+            }
+            (*index)++;
+        }
+    }
+    return false;
+}
+
+// Moves past the value starting at index, only checking enough to find where it ends
+static BOOL skipValue(const uint8_t *bytes, NSUInteger length, NSUInteger *index) {
+    if (*index >= length) {
+        return false;
+    }
+    uint8_t first = bytes[*index];
+    if (first == '"') {
+        return skipString(bytes, length, index, NULL);
+    }
+    if (first == '{' || first == '[') {
+        NSUInteger depth = 0;
+        while (*index < length) {
+            uint8_t byte = bytes[*index];
+            if (byte == '"') {
+                if (!skipString(bytes, length, index, NULL)) {
+                    return false;
+                }
+                continue;
+            }
+            if (byte == '{' || byte == '[') {
+                depth++;
+            } else if (byte == '}' || byte == ']') {
+                if (--depth == 0) {
+                    (*index)++;
+                    return true;
+                }
+            }
+            (*index)++;
+        }
+        return false;
+    }
+    NSUInteger start = *index;
+    while (*index < length && !strchr(",}] \t\n\r", bytes[*index])) {
+        (*index)++;
+    }
+    return *index > start;
+}
+
+@implementation OSHTTPResponse {
+    BOOL _decoded;
+    id _JSONObject;
+    NSError *_JSONError;
+}
+
+- (instancetype)initWithStatusCode:(NSInteger)statusCode headers:(NSDictionary *)headers data:(NSData *)data {
+    if (self = [super init]) {
+        _statusCode = statusCode;
+        _headers = headers;
+        _data = data ?: [NSData data];
+    }
+    return self;
+}
+
+- (instancetype)initWithStatusCode:(NSInteger)statusCode headers:(NSDictionary *)headers JSONObject:(id)JSONObject {
+    if (self = [self initWithStatusCode:statusCode headers:headers data:nil]) {
+        _decoded = true;
+        _JSONObject = JSONObject;
+    }
+    return self;
+}
+
+- (NSString *)valueForHeader:(NSString *)name {
+    for (id header in _headers) {
+        if ([header isKindOfClass:[NSString class]] && [header caseInsensitiveCompare:name] == NSOrderedSame) {
+            id value = _headers[header];
+            return [value isKindOfClass:[NSString class]] ? value : nil;
+        }
+    }
+    return nil;
+}
+
+- (id)JSONObject {
+    @synchronized (self) {
+        if (!_decoded) {
+            _decoded = true;
+            if (_data.length > 0) {
+                NSError *error;
+                _JSONObject = [NSJSONSerialization JSONObjectWithData:_data options:0 error:&error];
+                _JSONError = error;
+            }
+        }
+        return _JSONObject;
+    }
+}
+
+- (NSError *)JSONError {
+    [self JSONObject];
+    return _JSONError;
+}
+
+- (BOOL)enumerateArrayForKey:(NSString *)key usingBlock:(void (NS_NOESCAPE ^)(id element, BOOL *stop))block {
+    BOOL decoded;
+    @synchronized (self) {
+        decoded = _decoded;
+    }
+    if (decoded) {
+        return [self enumerateDecodedArrayForKey:key usingBlock:block];
+    }
+
+    const uint8_t *bytes = _data.bytes;
+    NSUInteger length = _data.length;
+    NSUInteger index = 0;
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+
+    skipWhitespace(bytes, length, &index);
+    if (index >= length || bytes[index++] != '{') {
+        return false;
+    }
+
+    while (true) {
+        skipWhitespace(bytes, length, &index);
+        if (index >= length || bytes[index] != '"') {
+            return false;
+        }
+        NSUInteger keyStart = index;
+        BOOL escaped = false;
+        if (!skipString(bytes, length, &index, &escaped)) {
+            return false;
+        }
+        BOOL matches;
+        if (escaped) {
+            NSData *quoted = [NSData dataWithBytesNoCopy:(void *)(bytes + keyStart) length:index - keyStart freeWhenDone:false];
+            matches = [[NSJSONSerialization JSONObjectWithData:quoted options:NSJSONReadingFragmentsAllowed error:nil] isEqual:key];
+        } else {
+            matches = index - keyStart - 2 == keyData.length && memcmp(bytes + keyStart + 1, keyData.bytes, keyData.length) == 0;
+        }
+
+        skipWhitespace(bytes, length, &index);
+        if (index >= length || bytes[index++] != ':') {
+            return false;
+        }
+        skipWhitespace(bytes, length, &index);
+
+        if (matches) {
+            return [self enumerateArrayAtIndex:index bytes:bytes length:length usingBlock:block];
+        }
+
+        if (!skipValue(bytes, length, &index)) {
+            return false;
+        }
+        skipWhitespace(bytes, length, &index);
+        // The end of the object means the key is missing
+        if (index >= length || bytes[index] != ',') {
+            return false;
+        }
+        index++;
+    }
+}
+
+- (BOOL)enumerateArrayAtIndex:(NSUInteger)index bytes:(const uint8_t *)bytes length:(NSUInteger)length usingBlock:(void (NS_NOESCAPE ^)(id element, BOOL *stop))block {
+    if (index >= length || bytes[index++] != '[') {
+        return false;
+    }
+    skipWhitespace(bytes, length, &index);
+    if (index < length && bytes[index] == ']') {
+        return true;
+    }
+
+    while (true) {
+        skipWhitespace(bytes, length, &index);
+        NSUInteger elementStart = index;
+        if (!skipValue(bytes, length, &index)) {
+            return false;
+        }
+
+        BOOL stop = false;
+        @autoreleasepool {
+            NSData *elementData = [NSData dataWithBytesNoCopy:(void *)(bytes + elementStart) length:index - elementStart freeWhenDone:false];
+            id element = [NSJSONSerialization JSONObjectWithData:elementData options:NSJSONReadingFragmentsAllowed error:nil];
+            if (!element) {
+                return false;
+            }
+            block(element, &stop);
+        }
+        if (stop) {
+            return true;
+        }
+
+        skipWhitespace(bytes, length, &index);
+        if (index >= length) {
+            return false;
+        }
+        if (bytes[index] == ']') {
+            return true;
+        }
+        if (bytes[index++] != ',') {
+            return false;
+        }
+    }
+}
+
+- (BOOL)enumerateDecodedArrayForKey:(NSString *)key usingBlock:(void (NS_NOESCAPE ^)(id element, BOOL *stop))block {
+    id object = self.JSONObject;
+    if (![object isKindOfClass:[NSDictionary class]] || ![object[key] isKindOfClass:[NSArray class]]) {
+        return false;
+    }
+    BOOL stop = false;
+    for (id element in (NSArray *)object[key]) {
+        block(element, &stop);
+        if (stop) {
+            break;
+        }
+    }
+    return true;
+}
+
+@end
@@ -0,0 +1,57 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An on-disk cache of notification media, shared by the app and its notification service extension.
+ Media is stored once per content, named by its SHA-256, and every URL it was downloaded from points to it.
+ URLs keep the ETag and Last-Modified they were served with so a repeated campaign is revalidated instead of
+ downloaded again, and the least recently used URLs are evicted first once the cache grows past its size.
+ Attachments are given their own link to the cached file, since iOS moves attachment files into its own store.
+ */
+@interface OSNotificationMediaCache : NSObject
+
++ (instancetype)sharedInstance;
+- (instancetype)initWithDirectory:(NSURL *)directory maxBytes:(NSUInteger)maxBytes;
+
+// The size of the cached media files
+@property (nonatomic, readonly) NSUInteger totalBytes;
+
+// A request for the URL, conditional if its media is cached
+- (NSURLRequest *)requestForURL:(NSURL *)url NS_SWIFT_NAME(request(for:));
+// Moves a downloaded file into the cache and returns a new link to it for an attachment
+- (NSURL * _Nullable)storeFile:(NSURL *)location forURL:(NSURL *)url response:(NSURLResponse *)response fileExtension:(NSString *)fileExtension NS_SWIFT_NAME(storeFile(_:for:response:fileExtension:));
+// Returns a new link to the cached media of the URL, after the server answered a conditional request with a 304
+- (NSURL * _Nullable)attachmentFileForRevalidatedURL:(NSURL *)url response:(NSURLResponse *)response NS_SWIFT_NAME(attachmentFile(forRevalidatedURL:response:));
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,290 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import "OSNotificationMediaCache.h"
+#import <CommonCrypto/CommonDigest.h>
+#import <sys/file.h>
+#import "OneSignalCommonDefines.h"
+#import "OneSignalLog.h"
+#import "OneSignalUserDefaults.h"
+#import "OSMacros.h"
+
+static NSString * const INDEX_FILE_NAME = @"index.plist";
+static NSString * const LOCK_FILE_NAME = @"index.lock";
+static NSString * const FILES_DIRECTORY = @"Files";
+static NSString * const ATTACHMENTS_DIRECTORY = @"Attachments";
+static NSString * const ENTRY_FILE_NAME = @"file";
+static NSString * const ENTRY_ETAG = @"etag";
+static NSString * const ENTRY_LAST_MODIFIED = @"last_modified";
+static NSString * const ENTRY_LAST_ACCESS = @"last_access";
+
+@implementation OSNotificationMediaCache {
+    NSURL *_directory;
+    NSUInteger _maxBytes;
+}
+
++ (instancetype)sharedInstance {
+    static OSNotificationMediaCache *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        let fileManager = NSFileManager.defaultManager;
+        NSURL *caches = [[fileManager containerURLForSecurityApplicationGroupIdentifier:[OneSignalUserDefaults appGroupName]] URLByAppendingPathComponent:@"Library/Caches" isDirectory:true];
+        // Without an App Group the app and the extension each keep their own cache
+        if (!caches)
+            caches = [fileManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedInstance = [[OSNotificationMediaCache alloc] initWithDirectory:[caches URLByAppendingPathComponent:OS_NOTIFICATION_MEDIA_CACHE_DIRECTORY isDirectory:true]
+                                                                    maxBytes:OS_NOTIFICATION_MEDIA_CACHE_MAX_BYTES];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithDirectory:(NSURL *)directory maxBytes:(NSUInteger)maxBytes {
+    if (self = [super init]) {
+        _directory = directory;
+        _maxBytes = maxBytes;
+        [NSFileManager.defaultManager createDirectoryAtURL:[self filesDirectory] withIntermediateDirectories:true attributes:nil error:nil];
+        [NSFileManager.defaultManager createDirectoryAtURL:[self attachmentsDirectory] withIntermediateDirectories:true attributes:nil error:nil];
+        [self removeStaleAttachmentFiles];
+    }
+    return self;
+}
+
+- (NSURL *)filesDirectory {
+    return [_directory URLByAppendingPathComponent:FILES_DIRECTORY isDirectory:true];
+}
+
+- (NSURL *)attachmentsDirectory {
+    return [_directory URLByAppendingPathComponent:ATTACHMENTS_DIRECTORY isDirectory:true];
+}
+
+- (NSURL *)fileURLForEntry:(NSDictionary *)entry {
+    return [[self filesDirectory] URLByAppendingPathComponent:entry[ENTRY_FILE_NAME] isDirectory:false];
+}
+
+/*
+ The app and its extension change the index from different processes, so it is read, changed and written under a file lock
+ The block returns whether it changed the entries
+ */
+- (void)withLockedEntries:(BOOL (^)(NSMutableDictionary<NSString *, NSMutableDictionary *> *entries))block {
+    let lockPath = [_directory URLByAppendingPathComponent:LOCK_FILE_NAME].fileSystemRepresentation;
+    int fd = open(lockPath, O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX) != 0)
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Notification media cache could not lock its index: %s", strerror(errno)]];
+
+    let indexURL = [_directory URLByAppendingPathComponent:INDEX_FILE_NAME];
+    NSDictionary *index = [NSDictionary dictionaryWithContentsOfURL:indexURL];
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *entries = [NSMutableDictionary new];
+    for (NSString *key in index) {
+        if ([index[key] isKindOfClass:[NSDictionary class]] && [index[key][ENTRY_FILE_NAME] isKindOfClass:[NSString class]])
+            entries[key] = [index[key] mutableCopy];
+    }
+
+    if (block(entries))
+        [entries writeToURL:indexURL atomically:YES];
+
+    if (fd >= 0) {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+}
+
+- (NSURLRequest *)requestForURL:(NSURL *)url {
+    let request = [NSMutableURLRequest requestWithURL:url];
+    [self withLockedEntries:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *entries) {
+        let entry = entries[url.absoluteString];
+        if (!entry || ![NSFileManager.defaultManager fileExistsAtPath:[self fileURLForEntry:entry].path])
+            return NO;
+        if (entry[ENTRY_ETAG])
+            [request setValue:entry[ENTRY_ETAG] forHTTPHeaderField:@"If-None-Match"];
+        if (entry[ENTRY_LAST_MODIFIED])
+            [request setValue:entry[ENTRY_LAST_MODIFIED] forHTTPHeaderField:@"If-Modified-Since"];
+        return NO;
+    }];
+    return request;
+}
+
+- (NSURL *)storeFile:(NSURL *)location forURL:(NSURL *)url response:(NSURLResponse *)response fileExtension:(NSString *)fileExtension {
+    let digest = [self digestOfFileAtURL:location];
+    if (!digest)
+        return nil;
+    let fileName = [NSString stringWithFormat:@"%@.%@", digest, fileExtension];
+    let fileURL = [[self filesDirectory] URLByAppendingPathComponent:fileName isDirectory:false];
+
+    __block NSURL *attachmentURL;
+    [self withLockedEntries:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *entries) {
+        // The same media from another URL, or sent again under a new URL, is stored once
+        if (![NSFileManager.defaultManager fileExistsAtPath:fileURL.path]) {
+            NSError *error;
+            if (![NSFileManager.defaultManager moveItemAtURL:location toURL:fileURL error:&error]) {
+                [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Notification media cache failed to store %@: %@", url, error]];
+                return NO;
+            }
+        }
+        let entry = [NSMutableDictionary new];
+        entry[ENTRY_FILE_NAME] = fileName;
+        entry[ENTRY_ETAG] = [self valueForHeader:@"ETag" inResponse:response];
+        entry[ENTRY_LAST_MODIFIED] = [self valueForHeader:@"Last-Modified" inResponse:response];
+        entry[ENTRY_LAST_ACCESS] = @(NSDate.date.timeIntervalSince1970);
+        entries[url.absoluteString] = entry;
+        [self evictEntries:entries keepingKey:url.absoluteString];
+        attachmentURL = [self attachmentFileForFileURL:fileURL];
+        return YES;
+    }];
+    return attachmentURL;
+}
+
+- (NSURL *)attachmentFileForRevalidatedURL:(NSURL *)url response:(NSURLResponse *)response {
+    __block NSURL *attachmentURL;
+    [self withLockedEntries:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *entries) {
+        let entry = entries[url.absoluteString];
+        if (!entry)
+            return NO;
+        attachmentURL = [self attachmentFileForFileURL:[self fileURLForEntry:entry]];
+        if (!attachmentURL) {
+            // Another process evicted the file after the request was made
+            [entries removeObjectForKey:url.absoluteString];
+            return YES;
+        }
+        // A 304 may carry updated validators
+        entry[ENTRY_ETAG] = [self valueForHeader:@"ETag" inResponse:response] ?: entry[ENTRY_ETAG];
+        entry[ENTRY_LAST_MODIFIED] = [self valueForHeader:@"Last-Modified" inResponse:response] ?: entry[ENTRY_LAST_MODIFIED];
+        entry[ENTRY_LAST_ACCESS] = @(NSDate.date.timeIntervalSince1970);
+        return YES;
+    }];
+    return attachmentURL;
+}
+
+// Called under the index lock
+- (NSURL *)attachmentFileForFileURL:(NSURL *)fileURL {
+    // Named with the time it was made so links iOS never took can be removed later
+    let name = [NSString stringWithFormat:@"%.0f_%@.%@", NSDate.date.timeIntervalSince1970, NSUUID.UUID.UUIDString, fileURL.pathExtension];
+    let attachmentURL = [[self attachmentsDirectory] URLByAppendingPathComponent:name isDirectory:false];
+    NSError *error;
+    if ([NSFileManager.defaultManager linkItemAtURL:fileURL toURL:attachmentURL error:&error])
+        return attachmentURL;
+    // Copying clones the file on APFS, so it does not take more space either
+    if ([NSFileManager.defaultManager copyItemAtURL:fileURL toURL:attachmentURL error:&error])
+        return attachmentURL;
+    [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Notification media cache failed to link %@: %@", fileURL.lastPathComponent, error]];
+    return nil;
+}
+
+// Called under the index lock
+- (void)evictEntries:(NSMutableDictionary<NSString *, NSMutableDictionary *> *)entries keepingKey:(NSString *)keptKey {
+    NSMutableDictionary<NSString *, NSNumber *> *fileSizes = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSNumber *> *fileReferences = [NSMutableDictionary new];
+    NSUInteger totalBytes = 0;
+    for (NSString *key in entries.allKeys) {
+        NSString *fileName = entries[key][ENTRY_FILE_NAME];
+        if (!fileSizes[fileName]) {
+            NSNumber *size;
+            if (![[self fileURLForEntry:entries[key]] getResourceValue:&size forKey:NSURLFileSizeKey error:nil] || !size) {
+                [entries removeObjectForKey:key];
+                continue;
+            }
+            fileSizes[fileName] = size;
+            totalBytes += size.unsignedIntegerValue;
+        }
+        fileReferences[fileName] = @(fileReferences[fileName].integerValue + 1);
+    }
+
+    if (totalBytes <= _maxBytes)
+        return;
+
+    let keysByLastAccess = [entries keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+        return [entry1[ENTRY_LAST_ACCESS] compare:entry2[ENTRY_LAST_ACCESS]];
+    }];
+    for (NSString *key in keysByLastAccess) {
+        if (totalBytes <= _maxBytes)
+            break;
+        if ([key isEqualToString:keptKey])
+            continue;
+        NSString *fileName = entries[key][ENTRY_FILE_NAME];
+        let fileURL = [self fileURLForEntry:entries[key]];
+        [entries removeObjectForKey:key];
+        fileReferences[fileName] = @(fileReferences[fileName].integerValue - 1);
+        // The file stays as long as another URL still points to it
+        if (fileReferences[fileName].integerValue > 0)
+            continue;
+        [NSFileManager.defaultManager removeItemAtURL:fileURL error:nil];
+        totalBytes -= fileSizes[fileName].unsignedIntegerValue;
+    }
+}
+
+- (void)removeStaleAttachmentFiles {
+    // iOS takes an attachment's file when the notification is shown, any link left after the extension's lifetime was never used
+    let now = NSDate.date.timeIntervalSince1970;
+    for (NSURL *file in [NSFileManager.defaultManager contentsOfDirectoryAtURL:[self attachmentsDirectory] includingPropertiesForKeys:nil options:0 error:nil]) {
+        let createdAt = [[file.lastPathComponent componentsSeparatedByString:@"_"].firstObject doubleValue];
+        if (now - createdAt > 2 * MAX_NSE_LIFETIME_SECOUNDS)
+            [NSFileManager.defaultManager removeItemAtURL:file error:nil];
+    }
+}
+
+- (NSString *)digestOfFileAtURL:(NSURL *)fileURL {
+    let data = [NSData dataWithContentsOfURL:fileURL options:NSDataReadingMappedIfSafe error:nil];
+    if (!data)
+        return nil;
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    NSMutableString *hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++)
+        [hex appendFormat:@"%02x", digest[i]];
+    return hex;
+}
+
+- (NSString *)valueForHeader:(NSString *)header inResponse:(NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]])
+        return nil;
+    let headers = ((NSHTTPURLResponse *)response).allHeaderFields;
+    for (NSString *key in headers) {
+        if ([key caseInsensitiveCompare:header] == NSOrderedSame)
+            return headers[key];
+    }
+    return nil;
+}
+
+- (NSUInteger)totalBytes {
+    NSUInteger totalBytes = 0;
+    for (NSURL *file in [NSFileManager.defaultManager contentsOfDirectoryAtURL:[self filesDirectory] includingPropertiesForKeys:@[NSURLFileSizeKey] options:0 error:nil]) {
+        NSNumber *size;
+        [file getResourceValue:&size forKey:NSURLFileSizeKey error:nil];
+        totalBytes += size.unsignedIntegerValue;
+    }
+    return totalBytes;
+}
+
+- (void)removeAll {
+    [self withLockedEntries:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *entries) {
+        [entries removeAllObjects];
+        [NSFileManager.defaultManager removeItemAtURL:[self filesDirectory] error:nil];
+        [NSFileManager.defaultManager createDirectoryAtURL:[self filesDirectory] withIntermediateDirectories:true attributes:nil error:nil];
+        return YES;
+    }];
+}
+
+@end
@@ -28,13 +28,14 @@
 #import <Foundation/Foundation.h>
 #import "OneSignalRequest.h"
 #import "OneSignalClientError.h"
+#import "OSHTTPResponse.h"
 
 @interface OSReattemptRequest : NSObject
 
 @property (strong, nonatomic) OneSignalRequest *request;
-@property (nonatomic) OSResultSuccessBlock successBlock;
+@property (nonatomic) OSResponseBlock responseBlock;
 @property (nonatomic) OSClientFailureBlock failureBlock;
 
-+(instancetype)withRequest:(OneSignalRequest *)request successBlock:(OSResultSuccessBlock)success failureBlock:(OSClientFailureBlock)failure;
++(instancetype)withRequest:(OneSignalRequest *)request responseBlock:(OSResponseBlock)response failureBlock:(OSClientFailureBlock)failure;
 
 @end
@@ -29,11 +29,11 @@
 
 @implementation OSReattemptRequest
 
-+(instancetype)withRequest:(OneSignalRequest *)request successBlock:(OSResultSuccessBlock)success failureBlock:(OSClientFailureBlock)failure {
++(instancetype)withRequest:(OneSignalRequest *)request responseBlock:(OSResponseBlock)response failureBlock:(OSClientFailureBlock)failure {
     OSReattemptRequest *reattempt = [OSReattemptRequest new];
     
     reattempt.request = request;
-    reattempt.successBlock = success;
+    reattempt.responseBlock = response;
     reattempt.failureBlock = failure;
     
     return reattempt;
@@ -0,0 +1,58 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <OneSignalCore/OneSignalClient.h>
+#import <OneSignalCore/OSReceiveReceiptsOutbox.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^OSReceiveReceiptsSentBlock)(NSArray<NSString *> *acknowledgedNotificationIds);
+
+/*
+ Holds the receipts in the outbox and sends them together once enough are waiting, instead of waking up the radio for each notification
+ Each receipt is still reported with its own notifications/{id}/report_received request, there is no batch endpoint
+ Receipts stay in the outbox until their request is acknowledged, a process that dies while sending leaves them for the next one
+ */
+@interface OSReceiveReceiptsAggregator : NSObject
+
+- (instancetype)initWithOutbox:(OSReceiveReceiptsOutbox *)outbox
+                        client:(id<IOneSignalClient>)client
+                  maxBatchSize:(NSUInteger)maxBatchSize
+                   maxBatchAge:(NSTimeInterval)maxBatchAge;
+
+/*
+ Sends the pending receipts once maxBatchSize of them are waiting or the oldest has waited maxBatchAge
+ force sends whatever is pending, ie: when the app has time to send a partial batch
+ completion is called when every request has been answered, with the notifications the server acknowledged
+ */
+- (void)sendReceiptsForcingPartialBatch:(BOOL)force completion:(OSReceiveReceiptsSentBlock _Nullable)completion NS_SWIFT_NAME(sendReceipts(forcingPartialBatch:completion:));
+
+@end
+
+NS_ASSUME_NONNULL_END
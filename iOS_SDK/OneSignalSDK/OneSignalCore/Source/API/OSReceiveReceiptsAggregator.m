@@ -0,0 +1,91 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSReceiveReceiptsAggregator.h"
+#import "OneSignalClientError.h"
+#import "OneSignalLog.h"
+#import "OSNetworkingUtils.h"
+#import "OSRequests.h"
+#import "OSMacros.h"
+
+@implementation OSReceiveReceiptsAggregator {
+    OSReceiveReceiptsOutbox *_outbox;
+    id<IOneSignalClient> _client;
+    NSUInteger _maxBatchSize;
+    NSTimeInterval _maxBatchAge;
+}
+
+- (instancetype)initWithOutbox:(OSReceiveReceiptsOutbox *)outbox
+                        client:(id<IOneSignalClient>)client
+                  maxBatchSize:(NSUInteger)maxBatchSize
+                   maxBatchAge:(NSTimeInterval)maxBatchAge {
+    if (self = [super init]) {
+        _outbox = outbox;
+        _client = client;
+        _maxBatchSize = MAX(maxBatchSize, 1);
+        _maxBatchAge = maxBatchAge;
+    }
+    return self;
+}
+
+- (void)sendReceiptsForcingPartialBatch:(BOOL)force completion:(OSReceiveReceiptsSentBlock)completion {
+    let receipts = force ? [_outbox takeReceipts] : [_outbox takeReceiptsIfCountReaches:_maxBatchSize orOldestWaited:_maxBatchAge];
+    // Reported in the order they were added
+    let sorted = [receipts sortedArrayUsingComparator:^NSComparisonResult(OSReceiveReceipt *first, OSReceiveReceipt *second) {
+        return [first.addedAt compare:second.addedAt];
+    }];
+
+    let group = dispatch_group_create();
+    NSMutableArray<NSString *> *acknowledged = [NSMutableArray new];
+    for (OSReceiveReceipt *receipt in sorted) {
+        let notificationId = receipt.notificationId;
+        let request = [OSRequestReceiveReceipts withPlayerId:receipt.playerId notificationId:notificationId appId:receipt.appId];
+        dispatch_group_enter(group);
+        [_client executeRequest:request onSuccess:^(NSDictionary *result) {
+            [self->_outbox acknowledgeReceiptsWithNotificationIds:@[notificationId]];
+            @synchronized (acknowledged) {
+                [acknowledged addObject:notificationId];
+            }
+            dispatch_group_leave(group);
+        } onFailure:^(OneSignalClientError *error) {
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Sending the receive receipt for %@ failed: %@", notificationId, error.underlyingError]];
+            if ([OSNetworkingUtils getResponseStatusType:error.code] == OSResponseStatusRetryable)
+                [self->_outbox returnReceiptsWithNotificationIds:@[notificationId]];
+            else
+                [self->_outbox removeReceiptsWithNotificationIds:@[notificationId]];
+            dispatch_group_leave(group);
+        }];
+    }
+
+    dispatch_group_notify(group, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        if (completion)
+            completion(acknowledged);
+    });
+}
+
+@end
@@ -0,0 +1,78 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OSReceiveReceipt : NSObject
+@property (strong, nonatomic, readonly) NSString *notificationId;
+@property (strong, nonatomic, readonly) NSString *appId;
+@property (strong, nonatomic, readonly, nullable) NSString *playerId;
+@property (strong, nonatomic, readonly) NSDate *addedAt;
+@end
+
+/*
+ Receive receipts waiting to be sent, kept in a file in the App Group container
+ The extension adds a receipt without waiting on the network, pending receipts are then sent by whichever of the app or the extension runs next
+ Receipts are only removed once the server acknowledged them, or failed in a way sending them again would not fix
+ */
+@interface OSReceiveReceiptsOutbox : NSObject
+
++ (instancetype)sharedInstance;
+// Receipts taken by a process are left to it for claimInterval, after which another process may send them
+- (instancetype)initWithFileURL:(NSURL *)fileURL claimInterval:(NSTimeInterval)claimInterval;
+
+// The receipt is on disk when this returns, returns false for a notification already pending or acknowledged
+- (BOOL)addReceiptWithNotificationId:(NSString *)notificationId appId:(NSString *)appId playerId:(NSString * _Nullable)playerId NS_SWIFT_NAME(addReceipt(notificationId:appId:playerId:));
+
+/*
+ Returns the pending receipts and marks them as taken so another process does not send them too
+ Receipts older than OS_RECEIVE_RECEIPTS_MAX_AGE or returned OS_RECEIVE_RECEIPTS_MAX_ATTEMPTS times are dropped
+ */
+- (NSArray<OSReceiveReceipt *> *)takeReceipts;
+
+// Same as takeReceipts, but takes nothing unless count receipts are pending or the oldest was added maxAge ago
+- (NSArray<OSReceiveReceipt *> *)takeReceiptsIfCountReaches:(NSUInteger)count orOldestWaited:(NSTimeInterval)maxAge NS_SWIFT_NAME(takeReceipts(ifCountReaches:orOldestWaited:));
+
+// The server received the receipts, adding them again is ignored until they reach OS_RECEIVE_RECEIPTS_MAX_AGE
+- (void)acknowledgeReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds;
+
+// The receipts failed in a way sending them again would not fix
+- (void)removeReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds;
+
+// The receipts failed to send and are left for a later attempt
+- (void)returnReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds;
+
+// Number of receipts waiting to be sent, including taken ones
+- (NSUInteger)count;
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
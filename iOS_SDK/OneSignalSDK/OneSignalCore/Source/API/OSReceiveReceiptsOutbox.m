@@ -0,0 +1,252 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSReceiveReceiptsOutbox.h"
+#import <sys/file.h>
+#import "OneSignalCommonDefines.h"
+#import "OneSignalLog.h"
+#import "OneSignalUserDefaults.h"
+#import "OSMacros.h"
+
+static NSString * const PENDING_RECEIPTS = @"pending";
+static NSString * const ACKNOWLEDGED_RECEIPTS = @"acknowledged";
+static NSString * const RECEIPT_APP_ID = @"app_id";
+static NSString * const RECEIPT_PLAYER_ID = @"player_id";
+static NSString * const RECEIPT_ADDED_AT = @"added_at";
+static NSString * const RECEIPT_ATTEMPTS = @"attempts";
+static NSString * const RECEIPT_TAKEN_UNTIL = @"taken_until";
+
+@implementation OSReceiveReceipt
+
+- (instancetype)initWithNotificationId:(NSString *)notificationId entry:(NSDictionary *)entry {
+    if (self = [super init]) {
+        _notificationId = notificationId;
+        _appId = entry[RECEIPT_APP_ID];
+        _playerId = entry[RECEIPT_PLAYER_ID];
+        _addedAt = entry[RECEIPT_ADDED_AT];
+    }
+    return self;
+}
+
+@end
+
+@implementation OSReceiveReceiptsOutbox {
+    NSURL *_fileURL;
+    NSURL *_lockURL;
+    NSTimeInterval _claimInterval;
+}
+
++ (instancetype)sharedInstance {
+    static OSReceiveReceiptsOutbox *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        let fileManager = NSFileManager.defaultManager;
+        NSURL *directory = [fileManager containerURLForSecurityApplicationGroupIdentifier:[OneSignalUserDefaults appGroupName]];
+        // Without an App Group the extension can only send its own receipts
+        if (!directory)
+            directory = [fileManager URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedInstance = [[OSReceiveReceiptsOutbox alloc] initWithFileURL:[directory URLByAppendingPathComponent:OS_RECEIVE_RECEIPTS_OUTBOX_FILE isDirectory:false]
+                                                            claimInterval:OS_RECEIVE_RECEIPTS_CLAIM_INTERVAL];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL claimInterval:(NSTimeInterval)claimInterval {
+    if (self = [super init]) {
+        _fileURL = fileURL;
+        _lockURL = [fileURL URLByAppendingPathExtension:@"lock"];
+        _claimInterval = claimInterval;
+        // The extension can run before the device is first unlocked, files created in here must stay writable then
+        [NSFileManager.defaultManager createDirectoryAtURL:[fileURL URLByDeletingLastPathComponent]
+                               withIntermediateDirectories:true
+                                                attributes:@{NSFileProtectionKey: NSFileProtectionNone}
+                                                     error:nil];
+    }
+    return self;
+}
+
+/*
+ The app and its extension change the outbox from different processes, so it is read, changed and written under a file lock
+ The block returns whether it changed the receipts
+ */
+- (void)withLockedReceipts:(BOOL (^)(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged))block {
+    int fd = open(_lockURL.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX) != 0)
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Receive receipts outbox could not be locked: %s", strerror(errno)]];
+
+    NSDictionary *stored = [NSDictionary dictionaryWithContentsOfURL:_fileURL];
+    NSDictionary *storedPending = [stored[PENDING_RECEIPTS] isKindOfClass:[NSDictionary class]] ? stored[PENDING_RECEIPTS] : nil;
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *pending = [NSMutableDictionary new];
+    for (NSString *notificationId in storedPending) {
+        if ([storedPending[notificationId] isKindOfClass:[NSDictionary class]] && [storedPending[notificationId][RECEIPT_APP_ID] isKindOfClass:[NSString class]])
+            pending[notificationId] = [storedPending[notificationId] mutableCopy];
+    }
+    NSDictionary *storedAcknowledged = [stored[ACKNOWLEDGED_RECEIPTS] isKindOfClass:[NSDictionary class]] ? stored[ACKNOWLEDGED_RECEIPTS] : nil;
+    NSMutableDictionary<NSString *, NSDate *> *acknowledged = [NSMutableDictionary new];
+    for (NSString *notificationId in storedAcknowledged) {
+        if ([storedAcknowledged[notificationId] isKindOfClass:[NSDate class]])
+            acknowledged[notificationId] = storedAcknowledged[notificationId];
+    }
+
+    if (block(pending, acknowledged)) {
+        NSError *error;
+        let data = [NSPropertyListSerialization dataWithPropertyList:@{PENDING_RECEIPTS: pending, ACKNOWLEDGED_RECEIPTS: acknowledged}
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:&error];
+        if (!data || ![data writeToURL:_fileURL options:NSDataWritingAtomic | NSDataWritingFileProtectionNone error:&error])
+            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Receive receipts outbox could not be saved: %@", error]];
+    }
+
+    if (fd >= 0) {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+}
+
+- (BOOL)addReceiptWithNotificationId:(NSString *)notificationId appId:(NSString *)appId playerId:(NSString *)playerId {
+    __block BOOL added = NO;
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        if (pending[notificationId] || acknowledged[notificationId])
+            return NO;
+        let receipt = [NSMutableDictionary dictionaryWithDictionary:@{RECEIPT_APP_ID: appId,
+                                                                      RECEIPT_ADDED_AT: [NSDate date],
+                                                                      RECEIPT_ATTEMPTS: @0}];
+        receipt[RECEIPT_PLAYER_ID] = playerId;
+        pending[notificationId] = receipt;
+        added = YES;
+        return YES;
+    }];
+    return added;
+}
+
+- (NSArray<OSReceiveReceipt *> *)takeReceipts {
+    return [self takeReceiptsIfCountReaches:1 orOldestWaited:0];
+}
+
+- (NSArray<OSReceiveReceipt *> *)takeReceiptsIfCountReaches:(NSUInteger)count orOldestWaited:(NSTimeInterval)maxAge {
+    NSMutableArray<OSReceiveReceipt *> *taken = [NSMutableArray new];
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        let now = [NSDate date];
+        let expired = [now dateByAddingTimeInterval:-OS_RECEIVE_RECEIPTS_MAX_AGE];
+        NSUInteger changes = [self removeAcknowledged:acknowledged addedBefore:expired];
+
+        NSMutableArray<NSString *> *available = [NSMutableArray new];
+        NSDate *oldest = now;
+        for (NSString *notificationId in pending.allKeys) {
+            let receipt = pending[notificationId];
+            NSDate *addedAt = receipt[RECEIPT_ADDED_AT];
+            if (![addedAt isKindOfClass:[NSDate class]] || [addedAt compare:expired] == NSOrderedAscending || [receipt[RECEIPT_ATTEMPTS] intValue] >= OS_RECEIVE_RECEIPTS_MAX_ATTEMPTS) {
+                [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Dropping receive receipt for notification %@ that could not be sent", notificationId]];
+                [pending removeObjectForKey:notificationId];
+                changes++;
+                continue;
+            }
+            NSDate *takenUntil = receipt[RECEIPT_TAKEN_UNTIL];
+            if (takenUntil && [takenUntil compare:now] == NSOrderedDescending)
+                continue;
+            [available addObject:notificationId];
+            oldest = [oldest earlierDate:addedAt];
+        }
+
+        if (available.count == 0 || (available.count < count && [now timeIntervalSinceDate:oldest] < maxAge))
+            return changes > 0;
+
+        let takenUntil = [now dateByAddingTimeInterval:self->_claimInterval];
+        for (NSString *notificationId in available) {
+            pending[notificationId][RECEIPT_TAKEN_UNTIL] = takenUntil;
+            [taken addObject:[[OSReceiveReceipt alloc] initWithNotificationId:notificationId entry:pending[notificationId]]];
+        }
+        return YES;
+    }];
+    return taken;
+}
+
+- (NSUInteger)removeAcknowledged:(NSMutableDictionary<NSString *, NSDate *> *)acknowledged addedBefore:(NSDate *)expired {
+    NSMutableArray<NSString *> *removed = [NSMutableArray new];
+    for (NSString *notificationId in acknowledged) {
+        if ([acknowledged[notificationId] compare:expired] == NSOrderedAscending)
+            [removed addObject:notificationId];
+    }
+    // Keeps the file small for high frequency senders, the oldest are the least likely to be delivered again
+    if (acknowledged.count - removed.count > OS_RECEIVE_RECEIPTS_ACKNOWLEDGED_LIMIT) {
+        let newestFirst = [acknowledged keysSortedByValueUsingComparator:^NSComparisonResult(NSDate *first, NSDate *second) {
+            return [second compare:first];
+        }];
+        removed = [[newestFirst subarrayWithRange:NSMakeRange(OS_RECEIVE_RECEIPTS_ACKNOWLEDGED_LIMIT, newestFirst.count - OS_RECEIVE_RECEIPTS_ACKNOWLEDGED_LIMIT)] mutableCopy];
+    }
+    [acknowledged removeObjectsForKeys:removed];
+    return removed.count;
+}
+
+- (void)acknowledgeReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds {
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        for (NSString *notificationId in notificationIds) {
+            acknowledged[notificationId] = pending[notificationId][RECEIPT_ADDED_AT] ?: [NSDate date];
+        }
+        [pending removeObjectsForKeys:notificationIds];
+        return YES;
+    }];
+}
+
+- (void)removeReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds {
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        [pending removeObjectsForKeys:notificationIds];
+        return YES;
+    }];
+}
+
+- (void)returnReceiptsWithNotificationIds:(NSArray<NSString *> *)notificationIds {
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        for (NSString *notificationId in notificationIds) {
+            let receipt = pending[notificationId];
+            [receipt removeObjectForKey:RECEIPT_TAKEN_UNTIL];
+            receipt[RECEIPT_ATTEMPTS] = @([receipt[RECEIPT_ATTEMPTS] intValue] + 1);
+        }
+        return YES;
+    }];
+}
+
+- (NSUInteger)count {
+    __block NSUInteger count = 0;
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        count = pending.count;
+        return NO;
+    }];
+    return count;
+}
+
+- (void)removeAll {
+    [self withLockedReceipts:^BOOL(NSMutableDictionary<NSString *, NSMutableDictionary *> *pending, NSMutableDictionary<NSString *, NSDate *> *acknowledged) {
+        [pending removeAllObjects];
+        [acknowledged removeAllObjects];
+        return YES;
+    }];
+}
+
+@end
@@ -0,0 +1,77 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Decides how long OneSignalClient waits before reattempting a failed request, and whether a host should be
+ sent requests at all. Reattempt delays use decorrelated jitter so devices that fail together do not retry together,
+ unless the server asks for a delay with a Retry-After header.
+ Each host has a circuit breaker that opens after consecutive server failures. Requests that get no response, ie: while
+ offline, say nothing about the host and are not counted. While open, requests to
+ the host are held instead of being sent. Once the open interval passes a single probe request is let through,
+ which closes the breaker if it succeeds and reopens it if it fails.
+ */
+@interface OSRequestRetryPolicy : NSObject
+
+- (instancetype)initWithBaseDelay:(NSTimeInterval)baseDelay
+                         maxDelay:(NSTimeInterval)maxDelay
+                 failureThreshold:(NSUInteger)failureThreshold
+                     openInterval:(NSTimeInterval)openInterval;
+
+// The current time in seconds since 1970, replaceable in tests
+@property (copy, nonatomic) NSTimeInterval (^clock)(void);
+// Returns a random value in [0, 1), replaceable in tests
+@property (copy, nonatomic) double (^random)(void);
+
+@property (nonatomic, readonly) NSTimeInterval maxDelay;
+
+/**
+ The delay before the next reattempt, given the delay before the previous one (0 for the first reattempt).
+ A valid Retry-After value is honored as is, even when it is longer than `maxDelay`.
+ */
+- (NSTimeInterval)delayAfterDelay:(NSTimeInterval)previousDelay retryAfter:(NSString * _Nullable)retryAfter NS_SWIFT_NAME(delay(afterDelay:retryAfter:));
+
+// The seconds a Retry-After value of delay-seconds or an HTTP-date asks for, or -1 if it is not valid
+- (NSTimeInterval)retryAfterInterval:(NSString * _Nullable)retryAfter NS_SWIFT_NAME(retryAfterInterval(_:));
+
+/**
+ The seconds to hold a request to the host before asking again, or 0 if it can be sent now.
+ Returning 0 while the breaker is half open lets the request through as the probe.
+ */
+- (NSTimeInterval)delayBeforeRequestToHost:(NSString * _Nullable)host NS_SWIFT_NAME(delayBeforeRequest(toHost:));
+- (void)recordSuccessForHost:(NSString * _Nullable)host NS_SWIFT_NAME(recordSuccess(forHost:));
+- (void)recordFailureForHost:(NSString * _Nullable)host NS_SWIFT_NAME(recordFailure(forHost:));
+// Leaves the breaker as it is, but lets another probe through if this was the probe
+- (void)recordNoResponseForHost:(NSString * _Nullable)host NS_SWIFT_NAME(recordNoResponse(forHost:));
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,176 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSRequestRetryPolicy.h"
+#import "OneSignalLog.h"
+
+@interface OSHostCircuit : NSObject
+@property (nonatomic) NSUInteger consecutiveFailures;
+// 0 while closed
+@property (nonatomic) NSTimeInterval openUntil;
+@property (nonatomic) BOOL probeInFlight;
+@end
+
+@implementation OSHostCircuit
+@end
+
+@implementation OSRequestRetryPolicy {
+    NSTimeInterval _baseDelay;
+    NSUInteger _failureThreshold;
+    NSTimeInterval _openInterval;
+    // Guarded by @synchronized (self)
+    NSMutableDictionary<NSString *, OSHostCircuit *> *_circuits;
+}
+
+- (instancetype)initWithBaseDelay:(NSTimeInterval)baseDelay
+                         maxDelay:(NSTimeInterval)maxDelay
+                 failureThreshold:(NSUInteger)failureThreshold
+                     openInterval:(NSTimeInterval)openInterval {
+    if (self = [super init]) {
+        _baseDelay = baseDelay;
+        _maxDelay = MAX(maxDelay, baseDelay);
+        _failureThreshold = MAX(failureThreshold, 1);
+        _openInterval = openInterval;
+        _circuits = [NSMutableDictionary new];
+        _clock = ^NSTimeInterval {
+            return [[NSDate date] timeIntervalSince1970];
+        };
+        _random = ^double {
+            return arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+        };
+    }
+    return self;
+}
+
+- (NSTimeInterval)delayAfterDelay:(NSTimeInterval)previousDelay retryAfter:(NSString *)retryAfter {
+    NSTimeInterval retryAfterInterval = [self retryAfterInterval:retryAfter];
+    if (retryAfterInterval >= 0) {
+        return retryAfterInterval;
+    }
+
+    // Decorrelated jitter: a random delay between the base and three times the previous delay
+    NSTimeInterval upper = MAX(previousDelay, _baseDelay) * 3;
+    NSTimeInterval delay = _baseDelay + self.random() * (upper - _baseDelay);
+    return MIN(delay, _maxDelay);
+}
+
+- (NSTimeInterval)retryAfterInterval:(NSString *)retryAfter {
+    if (![retryAfter isKindOfClass:[NSString class]] || retryAfter.length == 0) {
+        return -1;
+    }
+
+    NSScanner *scanner = [NSScanner scannerWithString:retryAfter];
+    long long seconds;
+    if ([scanner scanLongLong:&seconds] && scanner.isAtEnd) {
+        return seconds >= 0 ? seconds : -1;
+    }
+
+    NSDate *date = [[OSRequestRetryPolicy httpDateFormatter] dateFromString:retryAfter];
+    if (!date) {
+        return -1;
+    }
+    return MAX([date timeIntervalSince1970] - self.clock(), 0);
+}
+
++ (NSDateFormatter *)httpDateFormatter {
+    static NSDateFormatter *formatter;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        formatter = [NSDateFormatter new];
+        formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+        formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+    });
+    return formatter;
+}
+
+- (NSTimeInterval)delayBeforeRequestToHost:(NSString *)host {
+    if (!host) {
+        return 0;
+    }
+    @synchronized (self) {
+        OSHostCircuit *circuit = _circuits[host];
+        if (!circuit || circuit.openUntil == 0) {
+            return 0;
+        }
+        NSTimeInterval remaining = circuit.openUntil - self.clock();
+        if (remaining > 0) {
+            return remaining;
+        }
+        // The probe either closes or reopens the breaker, check again after the base delay
+        if (circuit.probeInFlight) {
+            return _baseDelay;
+        }
+        circuit.probeInFlight = true;
+        return 0;
+    }
+}
+
+- (void)recordSuccessForHost:(NSString *)host {
+    if (!host) {
+        return;
+    }
+    @synchronized (self) {
+        if (_circuits[host].openUntil > 0) {
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"OSRequestRetryPolicy closing circuit breaker for %@", host]];
+        }
+        [_circuits removeObjectForKey:host];
+    }
+}
+
+- (void)recordNoResponseForHost:(NSString *)host {
+    if (!host) {
+        return;
+    }
+    @synchronized (self) {
+        _circuits[host].probeInFlight = false;
+    }
+}
+
+- (void)recordFailureForHost:(NSString *)host {
+    if (!host) {
+        return;
+    }
+    @synchronized (self) {
+        OSHostCircuit *circuit = _circuits[host];
+        if (!circuit) {
+            circuit = [OSHostCircuit new];
+            _circuits[host] = circuit;
+        }
+        circuit.consecutiveFailures++;
+        BOOL probeFailed = circuit.probeInFlight;
+        circuit.probeInFlight = false;
+        // Requests that were already in flight when the breaker opened do not extend it
+        if (probeFailed || (circuit.openUntil == 0 && circuit.consecutiveFailures >= _failureThreshold)) {
+            circuit.openUntil = self.clock() + _openInterval;
+            [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"OSRequestRetryPolicy opening circuit breaker for %@ for %.3f seconds after %lu consecutive failures", host, _openInterval, (unsigned long)circuit.consecutiveFailures]];
+        }
+    }
+}
+
+@end
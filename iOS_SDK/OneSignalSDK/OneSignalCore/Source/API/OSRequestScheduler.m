@@ -0,0 +1,102 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSRequestScheduler.h"
+#import "OneSignalLog.h"
+
+@implementation OSRequestScheduler {
+    // Accessed on _queue only
+    dispatch_queue_t _queue;
+    NSUInteger _maxConcurrentRequests;
+    NSUInteger _maxConcurrentPerLane[OS_REQUEST_LANE_COUNT];
+    NSUInteger _inFlightPerLane[OS_REQUEST_LANE_COUNT];
+    NSUInteger _inFlight;
+    NSArray<NSMutableArray *> *_waitingPerLane;
+}
+
+- (instancetype)initWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                         maxConcurrentPerLane:(NSArray<NSNumber *> *)maxConcurrentPerLane {
+    if (self = [super init]) {
+        _queue = dispatch_queue_create("com.onesignal.requestScheduler", DISPATCH_QUEUE_SERIAL);
+        _maxConcurrentRequests = MAX(maxConcurrentRequests, 1);
+        NSMutableArray *waitingPerLane = [NSMutableArray new];
+        for (NSInteger lane = 0; lane < OS_REQUEST_LANE_COUNT; lane++) {
+            NSUInteger max = lane < maxConcurrentPerLane.count ? maxConcurrentPerLane[lane].unsignedIntegerValue : 1;
+            _maxConcurrentPerLane[lane] = MAX(max, 1);
+            [waitingPerLane addObject:[NSMutableArray new]];
+        }
+        _waitingPerLane = waitingPerLane;
+    }
+    return self;
+}
+
+- (void)scheduleRequest:(OneSignalRequest *)request start:(void (^)(dispatch_block_t finish))start {
+    OSRequestLane lane = request.lane;
+    if (lane < 0 || lane >= OS_REQUEST_LANE_COUNT) {
+        lane = OSRequestLaneUpdate;
+    }
+    dispatch_async(_queue, ^{
+        [self->_waitingPerLane[lane] addObject:[start copy]];
+        [self startWaitingRequests];
+    });
+}
+
+- (void)startWaitingRequests {
+    for (NSInteger lane = 0; lane < OS_REQUEST_LANE_COUNT; lane++) {
+        // Analytics may depend on the users that waiting user lane requests create. The user lane was started above.
+        if (lane == OSRequestLaneAnalytics && _waitingPerLane[OSRequestLaneUser].count > 0) {
+            continue;
+        }
+        NSMutableArray *waiting = _waitingPerLane[lane];
+        while (waiting.count > 0 && _inFlightPerLane[lane] < _maxConcurrentPerLane[lane] && _inFlight < _maxConcurrentRequests) {
+            void (^start)(dispatch_block_t) = waiting.firstObject;
+            [waiting removeObjectAtIndex:0];
+            _inFlightPerLane[lane]++;
+            _inFlight++;
+            start([self finishBlockForLane:lane]);
+        }
+    }
+}
+
+- (dispatch_block_t)finishBlockForLane:(NSInteger)lane {
+    __block BOOL finished = NO;
+    return ^{
+        dispatch_async(self->_queue, ^{
+            if (finished) {
+                [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:@"OSRequestScheduler request finished more than once"];
+                return;
+            }
+            finished = YES;
+            self->_inFlightPerLane[lane]--;
+            self->_inFlight--;
+            [self startWaitingRequests];
+        });
+    };
+}
+
+@end
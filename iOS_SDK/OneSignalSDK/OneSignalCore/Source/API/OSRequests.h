@@ -45,6 +45,10 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)withUserId:(NSString *)userId appId:(NSString *)appId wasOpened:(BOOL)opened messageId:(NSString *)messageId withDeviceType:(NSNumber *)deviceType;
 @end
 
+@interface OSRequestReceiveReceipts : OneSignalRequest
++ (instancetype)withPlayerId:(NSString * _Nullable)playerId notificationId:(NSString *)notificationId appId:(NSString *)appId;
+@end
+
 NS_ASSUME_NONNULL_END
 
 @interface OSRequestTrackV1 : OneSignalRequest
@@ -89,6 +89,24 @@
 }
 @end
 
+@implementation OSRequestReceiveReceipts
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
++ (instancetype)withPlayerId:(NSString *)playerId notificationId:(NSString *)notificationId appId:(NSString *)appId {
+    let request = [OSRequestReceiveReceipts new];
+
+    request.parameters = @{@"app_id": appId,
+                           @"player_id": playerId ?: [NSNull null],
+                           @"device_type": @0};
+    request.method = PUT;
+    request.path = [NSString stringWithFormat:@"notifications/%@/report_received", notificationId];
+
+    return request;
+}
+@end
+
 @implementation OSRequestTrackV1
 NSString * const OS_USAGE_DATA = @"OS-Usage-Data";
 + (instancetype)trackUsageData:(NSString *)osUsageData appId:(NSString *)appId {
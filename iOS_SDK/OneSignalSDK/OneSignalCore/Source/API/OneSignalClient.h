@@ -28,16 +28,21 @@
 #import <Foundation/Foundation.h>
 #import <OneSignalCore/OneSignalRequest.h>
 #import <OneSignalCore/OneSignalClientError.h>
+#import <OneSignalCore/OSHTTPResponse.h>
 
 #ifndef OneSignalClient_h
 #define OneSignalClient_h
 
 @protocol IOneSignalClient <NSObject>
 - (void)executeRequest:(OneSignalRequest *)request onSuccess:(OSResultSuccessBlock)successBlock onFailure:(OSClientFailureBlock)failureBlock;
+// Passes the response undecoded with its status and headers, so large bodies can be decoded lazily or element by element
+- (void)executeRequest:(OneSignalRequest *)request onResponse:(OSResponseBlock)responseBlock onFailure:(OSClientFailureBlock)failureBlock;
 @end
 
 @interface OneSignalClient : NSObject <IOneSignalClient>
 + (OneSignalClient *)sharedClient;
+// Sessions are created from a copy of the configuration, ie: to register stub URL protocols in tests
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration;
 @end
 
 #endif
@@ -31,10 +31,17 @@
 #import "OneSignalLog.h"
 #import "OneSignalCoreHelper.h"
 #import "OSPrivacyConsentController.h"
+#import "OSRequestScheduler.h"
+#import "OSRequestRetryPolicy.h"
 
 @interface OneSignalClient ()
 @property (strong, nonatomic) NSURLSession *sharedSession;
 @property (strong, nonatomic) NSURLSession *noCacheSession;
+@property (strong, nonatomic) OSRequestScheduler *scheduler;
+@property (strong, nonatomic) OSRequestRetryPolicy *retryPolicy;
+@property (strong, nonatomic) dispatch_queue_t reattemptQueue;
+// The callbacks of requests waiting on an in-flight request with the same key, guarded by @synchronized
+@property (strong, nonatomic) NSMutableDictionary<NSString *, NSMutableArray<OSReattemptRequest *> *> *inFlightRequests;
 @end
 
 @implementation OneSignalClient
@@ -49,16 +56,32 @@
 }
 
 -(instancetype)init {
+    return [self initWithSessionConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]];
+}
+
+- (instancetype)initWithSessionConfiguration:(NSURLSessionConfiguration *)baseConfiguration {
     if (self = [super init]) {
-        _sharedSession = [NSURLSession sessionWithConfiguration:[self configurationWithCachingPolicy:NSURLRequestUseProtocolCachePolicy]];
-        _noCacheSession = [NSURLSession sessionWithConfiguration:[self configurationWithCachingPolicy:NSURLRequestReloadIgnoringLocalCacheData]];
+        _sharedSession = [NSURLSession sessionWithConfiguration:[self configuration:baseConfiguration withCachingPolicy:NSURLRequestUseProtocolCachePolicy]];
+        _noCacheSession = [NSURLSession sessionWithConfiguration:[self configuration:baseConfiguration withCachingPolicy:NSURLRequestReloadIgnoringLocalCacheData]];
+        _scheduler = [[OSRequestScheduler alloc] initWithMaxConcurrentRequests:OS_REQUEST_MAX_CONCURRENT
+                                                          maxConcurrentPerLane:@[@(OS_REQUEST_LANE_USER_MAX_CONCURRENT),
+                                                                                 @(OS_REQUEST_LANE_UPDATE_MAX_CONCURRENT),
+                                                                                 @(OS_REQUEST_LANE_ANALYTICS_MAX_CONCURRENT)]];
+        _inFlightRequests = [NSMutableDictionary new];
+        _retryPolicy = [[OSRequestRetryPolicy alloc] initWithBaseDelay:REATTEMPT_DELAY
+                                                             maxDelay:REATTEMPT_MAX_DELAY
+                                                     failureThreshold:CIRCUIT_BREAKER_FAILURE_THRESHOLD
+                                                         openInterval:CIRCUIT_BREAKER_OPEN_SECONDS];
+        _reattemptQueue = dispatch_queue_create("com.onesignal.client.reattempt", DISPATCH_QUEUE_SERIAL);
     }
     
     return self;
 }
 
-- (NSURLSessionConfiguration *)configurationWithCachingPolicy:(NSURLRequestCachePolicy)policy {
-    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+- (NSURLSessionConfiguration *)configuration:(NSURLSessionConfiguration *)baseConfiguration withCachingPolicy:(NSURLRequestCachePolicy)policy {
+    NSURLSessionConfiguration *configuration = [baseConfiguration copy];
+    // The scheduler limits concurrency, so requests reuse one connection where the server supports HTTP/2
+    configuration.HTTPMaximumConnectionsPerHost = OS_REQUEST_MAX_CONCURRENT;
     configuration.timeoutIntervalForRequest = REQUEST_TIMEOUT_REQUEST; // TODO: Are these anything?
     configuration.timeoutIntervalForResource = REQUEST_TIMEOUT_RESOURCE; // TODO: Are these anything?
     
@@ -74,6 +97,66 @@
 }
 
 - (void)executeRequest:(OneSignalRequest *)request onSuccess:(OSResultSuccessBlock)successBlock onFailure:(OSClientFailureBlock)failureBlock {
+    [self executeRequest:request onResponse:^(OSHTTPResponse *response) {
+        if (response.data.length == 0) {
+            if (successBlock)
+                successBlock(nil);
+            return;
+        }
+        id json = response.JSONObject;
+        if (response.JSONError) {
+            if (failureBlock)
+                failureBlock([[OneSignalClientError alloc] initWithCode:response.statusCode message:@"Error parsing JSON" responseHeaders:response.headers response:nil underlyingError:response.JSONError]);
+            return;
+        }
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"network response (%@): %@", NSStringFromClass([request class]), json]];
+        if (successBlock)
+            successBlock(json);
+    } onFailure:failureBlock];
+}
+
+- (void)executeRequest:(OneSignalRequest *)request onResponse:(OSResponseBlock)responseBlock onFailure:(OSClientFailureBlock)failureBlock {
+    NSString *inFlightKey = request.inFlightKey;
+    if (!inFlightKey) {
+        [self sendRequest:request onResponse:responseBlock onFailure:failureBlock];
+        return;
+    }
+
+    // Share the response of an identical request that is already in flight
+    OSReattemptRequest *waiting = [OSReattemptRequest withRequest:request responseBlock:responseBlock failureBlock:failureBlock];
+    @synchronized (self.inFlightRequests) {
+        NSMutableArray *sharing = self.inFlightRequests[inFlightKey];
+        if (sharing) {
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"HTTP Request (%@) is already in flight, sharing its response", NSStringFromClass(request.class)]];
+            [sharing addObject:waiting];
+            return;
+        }
+        self.inFlightRequests[inFlightKey] = [NSMutableArray arrayWithObject:waiting];
+    }
+
+    [self sendRequest:request onResponse:^(OSHTTPResponse *response) {
+        for (OSReattemptRequest *shared in [self takeInFlightRequestsForKey:inFlightKey]) {
+            if (shared.responseBlock)
+                shared.responseBlock(response);
+        }
+    } onFailure:^(OneSignalClientError *error) {
+        for (OSReattemptRequest *shared in [self takeInFlightRequestsForKey:inFlightKey]) {
+            if (shared.failureBlock)
+                shared.failureBlock(error);
+        }
+    }];
+}
+
+- (NSArray<OSReattemptRequest *> *)takeInFlightRequestsForKey:(NSString *)inFlightKey {
+    @synchronized (self.inFlightRequests) {
+        NSArray *sharing = self.inFlightRequests[inFlightKey] ?: @[];
+        [self.inFlightRequests removeObjectForKey:inFlightKey];
+        return sharing;
+    }
+}
+
+// Sends the request without sharing an in-flight request, reattempts also come through here
+- (void)sendRequest:(OneSignalRequest *)request onResponse:(OSResponseBlock)responseBlock onFailure:(OSClientFailureBlock)failureBlock {
     // If privacy consent is required but not yet given, any non-GET request should be blocked.
     if (request.method != GET && [OSPrivacyConsentController shouldLogMissingPrivacyConsentErrorWithMethodName:nil]) {
         [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:@"Attempted to perform an HTTP request (%@) before the user provided privacy consent."];
@@ -104,12 +187,35 @@
         explicitly disabled for that request. The default is false.
     */
     NSURLSession *session = request.disableLocalCaching ? self.noCacheSession : self.sharedSession;
+    NSMutableURLRequest *urlRequest = request.urlRequest;
+    NSString *host = urlRequest.URL.host;
     
-    NSURLSessionDataTask *task = [session dataTaskWithRequest:request.urlRequest completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        [self handleJSONNSURLResponse:response data:data error:error isAsync:true withRequest:request onSuccess:successBlock onFailure:failureBlock];
-    }];
+    // Hold the request until the circuit breaker lets it through, it is not an attempt so reattempts are not used up
+    NSTimeInterval circuitDelay = [self.retryPolicy delayBeforeRequestToHost:host];
+    if (circuitDelay > 0) {
+        [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"HTTP Request (%@) held for %.3f seconds because the circuit breaker for %@ is open", NSStringFromClass(request.class), circuitDelay, host]];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(circuitDelay * NSEC_PER_SEC)), self.reattemptQueue, ^{
+            [self sendRequest:request onResponse:responseBlock onFailure:failureBlock];
+        });
+        return;
+    }
     
-    [task resume];
+    [self.scheduler scheduleRequest:request start:^(dispatch_block_t finish) {
+        NSURLSessionDataTask *task = [session dataTaskWithRequest:urlRequest completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+            finish();
+            NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
+            // No response, ie: offline, says nothing about the host
+            if (statusCode == 0)
+                [self.retryPolicy recordNoResponseForHost:host];
+            else if (statusCode >= 500)
+                [self.retryPolicy recordFailureForHost:host];
+            else
+                [self.retryPolicy recordSuccessForHost:host];
+            [self handleURLResponse:response data:data error:error isAsync:true withRequest:request onResponse:responseBlock onFailure:failureBlock];
+        }];
+
+        [task resume];
+    }];
 }
 
 - (void)handleMissingAppIdError:(OSClientFailureBlock)failureBlock withRequest:(OneSignalRequest *)request {
@@ -144,21 +250,27 @@
     //we want requests to only retry one time after a delay.
     reattempt.request.reattemptCount++;
     
-    [self executeRequest:reattempt.request onSuccess:reattempt.successBlock onFailure:reattempt.failureBlock];
+    [self sendRequest:reattempt.request onResponse:reattempt.responseBlock onFailure:reattempt.failureBlock];
 }
 
-- (BOOL)willReattemptRequest:(int)statusCode withRequest:(OneSignalRequest *)request success:(OSResultSuccessBlock)successBlock failure:(OSClientFailureBlock)failureBlock asyncRequest:(BOOL)async {
+- (BOOL)willReattemptRequest:(int)statusCode responseHeaders:(NSDictionary *)headers withRequest:(OneSignalRequest *)request response:(OSResponseBlock)responseBlock failure:(OSClientFailureBlock)failureBlock asyncRequest:(BOOL)async {
     // in the event that there is no network connection, NSURLSession will return status code 0
     if ((statusCode >= 500 || statusCode == 0) && request.reattemptCount < MAX_ATTEMPT_COUNT - 1) {
-        OSReattemptRequest *reattempt = [OSReattemptRequest withRequest:request successBlock:successBlock failureBlock:failureBlock];
+        OSReattemptRequest *reattempt = [OSReattemptRequest withRequest:request responseBlock:responseBlock failureBlock:failureBlock];
         
         if (async) {
-            //retry again in an increasing interval calculated with reattemptDelay
-            double reattemptDelay = [self calculateReattemptDelay:request.reattemptCount];
+            //retry again after a jittered delay that grows with each attempt, or when the server asks with Retry-After
+            NSTimeInterval reattemptDelay = [self.retryPolicy delayAfterDelay:request.lastReattemptDelay retryAfter:[self retryAfterHeader:headers]];
+            if (reattemptDelay > self.retryPolicy.maxDelay) {
+                // Leave it to the caller to retry the request later instead of holding on to it
+                [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Not re-attempting request (%@), the server asked to wait %.3f seconds", NSStringFromClass([request class]), reattemptDelay]];
+                return false;
+            }
+            request.lastReattemptDelay = reattemptDelay;
             [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Re-scheduling request (%@) to be re-attempted in %.3f seconds due to failed HTTP request with status code %i", NSStringFromClass([request class]), reattemptDelay, (int)statusCode]];
-            [OneSignalCoreHelper dispatch_async_on_main_queue:^{
-                [self performSelector:@selector(reattemptRequest:) withObject:reattempt afterDelay:reattemptDelay];
-            }];
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(reattemptDelay * NSEC_PER_SEC)), self.reattemptQueue, ^{
+                [self reattemptRequest:reattempt];
+            });
         } else {
             //retry again immediately
             [self reattemptRequest: reattempt];
@@ -170,9 +282,12 @@
     return false;
 }
 
-// A request will retry with intervals of 5, 15 , 45, 135 seconds...
-- (double)calculateReattemptDelay:(int)reattemptCount {
-    return REATTEMPT_DELAY * pow(3, reattemptCount);
+- (NSString *)retryAfterHeader:(NSDictionary *)headers {
+    for (NSString *name in headers) {
+        if ([name isKindOfClass:[NSString class]] && [name caseInsensitiveCompare:@"Retry-After"] == NSOrderedSame)
+            return headers[name];
+    }
+    return nil;
 }
 
 - (void)prettyPrintDebugStatementWithRequest:(OneSignalRequest *)request {
@@ -193,42 +308,26 @@
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"HTTP Request (%@) with URL: %@, with parameters: %@ and headers: %@", NSStringFromClass([request class]), request.urlRequest.URL.absoluteString, jsonString, request.additionalHeaders]];
 }
 
-- (void)handleJSONNSURLResponse:(NSURLResponse*)response data:(NSData*)data error:(NSError*)error isAsync:(BOOL)async withRequest:(OneSignalRequest *)request onSuccess:(OSResultSuccessBlock)successBlock onFailure:(OSClientFailureBlock)failureBlock {
+- (void)handleURLResponse:(NSURLResponse*)response data:(NSData*)data error:(NSError*)error isAsync:(BOOL)async withRequest:(OneSignalRequest *)request onResponse:(OSResponseBlock)responseBlock onFailure:(OSClientFailureBlock)failureBlock {
     
     NSHTTPURLResponse* HTTPResponse = (NSHTTPURLResponse*)response;
     NSInteger statusCode = [HTTPResponse statusCode];
     NSDictionary *headers = [HTTPResponse allHeaderFields]; // can be null
-    NSError* jsonError = nil;
-    NSMutableDictionary* innerJson;
     
-    if (data != nil && [data length] > 0) {
-        innerJson = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:&jsonError];
-        innerJson[@"httpStatusCode"] = [NSNumber numberWithLong:statusCode];
-        innerJson[@"headers"] = headers;
-        
-        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"network request (%@) with URL %@ and headers: %@", NSStringFromClass([request class]), request.urlRequest.URL.absoluteString, request.additionalHeaders]];
-
-        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"network response (%@) with URL %@: %@", NSStringFromClass([request class]), request.urlRequest.URL.absoluteString, innerJson]];
-        if (jsonError) {
-            if (failureBlock != nil)
-                failureBlock([[OneSignalClientError alloc] initWithCode:statusCode message:@"Error parsing JSON" responseHeaders:headers response:nil underlyingError:jsonError]);
-            return;
-        }
-    }
+    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"network request (%@) with URL %@ and headers: %@ returned %i with %lu bytes", NSStringFromClass([request class]), response.URL.absoluteString, request.additionalHeaders, (int)statusCode, (unsigned long)data.length]];
     
-    if ([self willReattemptRequest:(int)statusCode withRequest:request success:successBlock failure:failureBlock asyncRequest:async])
+    if ([self willReattemptRequest:(int)statusCode responseHeaders:headers withRequest:request response:responseBlock failure:failureBlock asyncRequest:async])
         return;
     
+    // The body is left for the caller to decode, as only it knows which parts it needs
+    OSHTTPResponse *envelope = [[OSHTTPResponse alloc] initWithStatusCode:statusCode headers:headers data:data];
     if (error == nil && (statusCode == 200 || statusCode == 201 || statusCode == 202)) {
-        if (successBlock != nil) {
-            if (innerJson != nil)
-                successBlock(innerJson);
-            else
-                successBlock(nil);
-        }
+        if (responseBlock != nil)
+            responseBlock(envelope);
     } else if (failureBlock != nil) {
-        // Make sure to send all the infomation available to the client
-        failureBlock([[OneSignalClientError alloc] initWithCode:statusCode message:@"Error encountered making request" responseHeaders:headers response:innerJson underlyingError:error]);
+        // Make sure to send all the infomation available to the client, error bodies are small
+        NSDictionary *json = [envelope.JSONObject isKindOfClass:[NSDictionary class]] ? envelope.JSONObject : nil;
+        failureBlock([[OneSignalClientError alloc] initWithCode:statusCode message:@"Error encountered making request" responseHeaders:headers response:json underlyingError:error]);
     }
 }
 
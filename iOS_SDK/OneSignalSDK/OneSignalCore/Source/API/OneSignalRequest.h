@@ -38,6 +38,20 @@
 typedef void (^OSResultSuccessBlock)(NSDictionary* result);
 typedef void (^OSFailureBlock)(NSError* error);
 
+/*
+ OneSignalClient schedules requests in lanes, each with its own concurrency limit.
+ Waiting requests in an earlier lane start before those in later lanes.
+ */
+typedef NS_ENUM(NSInteger, OSRequestLane) {
+    // Creating and identifying users, and changing their aliases. Analytics requests may depend on the user these create.
+    OSRequestLaneUser = 0,
+    // Subscription and property updates, and requests that do not pick a lane
+    OSRequestLaneUpdate,
+    // Outcomes, custom events, in-app message impressions and clicks
+    OSRequestLaneAnalytics
+};
+#define OS_REQUEST_LANE_COUNT (OSRequestLaneAnalytics + 1)
+
 @interface OneSignalRequest : NSObject
 
 @property (nonatomic) BOOL disableLocalCaching;
@@ -46,8 +60,11 @@ typedef void (^OSFailureBlock)(NSError* error);
 @property (strong, nonatomic, nullable) NSDictionary *parameters;
 @property (strong, nonatomic, nullable) NSDictionary<NSString *, NSString *> *additionalHeaders;
 @property (nonatomic) int reattemptCount;
+@property (nonatomic) NSTimeInterval lastReattemptDelay; //the delay before the previous reattempt, reattempt delays grow from it
 @property (nonatomic) BOOL dataRequest; //false for JSON based requests
 @property (nonatomic) NSDate *timestamp;
+@property (nonatomic, readonly) OSRequestLane lane; //subclasses override this to pick a lane, the default is OSRequestLaneUpdate
+@property (nonatomic, readonly, nullable) NSString *inFlightKey; //requests with the same key share one HTTP request while it is in flight, GET requests by default
 -(BOOL)missingAppId; //for requests that don't require an appId parameter, the subclass should override this method and return false
 -(NSMutableURLRequest * _Nonnull )urlRequest;
 
@@ -99,6 +99,22 @@
     return request;
 }
 
+- (OSRequestLane)lane {
+    return OSRequestLaneUpdate;
+}
+
+- (NSString *)inFlightKey {
+    // Only GET requests are safe to share, sending any other request twice may be intended
+    if (self.method != GET)
+        return nil;
+
+    NSMutableString *key = [NSMutableString stringWithString:self.urlRequest.URL.absoluteString];
+    for (NSString *header in [self.additionalHeaders.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [key appendFormat:@"|%@:%@", header, self.additionalHeaders[header]];
+    }
+    return key;
+}
+
 -(BOOL)missingAppId {
     if ([self.path containsString:@"apps/"]) {
       NSArray *pathComponents = [self.path componentsSeparatedByString:@"/"];
@@ -0,0 +1,59 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ Badge count kept in a small memory mapped file in the App Group container
+ Every process maps the same file and updates it with atomic compare and swap, so concurrent notification service extensions do not lose increments
+ */
+@interface OSBadgeCounter : NSObject
+
+// nil when the file cannot be mapped, callers fall back to the count in shared UserDefaults
++ (nullable instancetype)sharedInstance;
+
+// The values are only used when the file is created
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL initialValue:(NSInteger)initialValue previousValue:(NSInteger)previousValue;
+
+@property (readonly) NSInteger value;
+@property (readonly) NSInteger previousValue;
+
+// Adds increment and returns the new value, which does not go below 0
+- (NSInteger)addIncrement:(NSInteger)increment;
+
+// The value it replaces becomes the previous value
+- (void)replaceValue:(NSInteger)value;
+
+// Sets the value back to the previous value, ie: when a notification display is cancelled
+- (void)revertToPreviousValue;
+
+@end
+
+NS_ASSUME_NONNULL_END
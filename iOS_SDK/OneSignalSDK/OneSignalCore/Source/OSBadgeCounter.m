@@ -0,0 +1,175 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSBadgeCounter.h"
+#import <stdatomic.h>
+#import <sys/file.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import "OneSignalCommonDefines.h"
+#import "OneSignalLog.h"
+#import "OneSignalUserDefaults.h"
+#import "OSMacros.h"
+
+#define OS_BADGE_COUNTER_VERSION 1
+
+/*
+ Both counts share one word so they change together in a single compare and swap
+ The version is written under a file lock once the counts are seeded, a file without it is seeded again
+ */
+typedef struct {
+    uint32_t version;
+    uint32_t reserved;
+    _Atomic uint64_t counts;
+} OSBadgeCounterStorage;
+
+static inline uint64_t packCounts(int32_t value, int32_t previousValue) {
+    return ((uint64_t)(uint32_t)previousValue << 32) | (uint32_t)value;
+}
+
+static inline int32_t unpackValue(uint64_t counts) {
+    return (int32_t)(uint32_t)counts;
+}
+
+static inline int32_t unpackPreviousValue(uint64_t counts) {
+    return (int32_t)(uint32_t)(counts >> 32);
+}
+
+static inline int32_t clampCount(NSInteger count) {
+    return (int32_t)MAX(MIN(count, (NSInteger)INT32_MAX), (NSInteger)INT32_MIN);
+}
+
+@implementation OSBadgeCounter {
+    OSBadgeCounterStorage *_storage;
+}
+
++ (instancetype)sharedInstance {
+    static OSBadgeCounter *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        let fileManager = NSFileManager.defaultManager;
+        NSURL *directory = [fileManager containerURLForSecurityApplicationGroupIdentifier:[OneSignalUserDefaults appGroupName]];
+        // Without an App Group the extension's count is already separate from the app's
+        if (!directory)
+            directory = [fileManager URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask].firstObject;
+        let fileURL = [directory URLByAppendingPathComponent:OS_BADGE_COUNTER_FILE isDirectory:false];
+        // The extension can run before the device is first unlocked, files created in here must stay writable then
+        [fileManager createDirectoryAtURL:[fileURL URLByDeletingLastPathComponent]
+              withIntermediateDirectories:true
+                               attributes:@{NSFileProtectionKey: NSFileProtectionNone}
+                                    error:nil];
+        let sharedUserDefaults = OneSignalUserDefaults.initShared;
+        sharedInstance = [[OSBadgeCounter alloc] initWithFileURL:fileURL
+                                                    initialValue:[sharedUserDefaults getSavedIntegerForKey:ONESIGNAL_BADGE_KEY defaultValue:0]
+                                                   previousValue:[sharedUserDefaults getSavedIntegerForKey:PREVIOUS_ONESIGNAL_BADGE_KEY defaultValue:0]];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL initialValue:(NSInteger)initialValue previousValue:(NSInteger)previousValue {
+    if (!(self = [super init]))
+        return nil;
+
+    int fd = open(fileURL.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Badge counter file could not be opened: %s", strerror(errno)]];
+        return nil;
+    }
+
+    // Only creating the file is locked, updates are lock free
+    flock(fd, LOCK_EX);
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (status.st_size < (off_t)sizeof(OSBadgeCounterStorage) && ftruncate(fd, sizeof(OSBadgeCounterStorage)) != 0)) {
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Badge counter file could not be sized: %s", strerror(errno)]];
+        flock(fd, LOCK_UN);
+        close(fd);
+        return nil;
+    }
+    void *mapping = mmap(NULL, sizeof(OSBadgeCounterStorage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Badge counter file could not be mapped: %s", strerror(errno)]];
+        flock(fd, LOCK_UN);
+        close(fd);
+        return nil;
+    }
+    _storage = mapping;
+    if (_storage->version != OS_BADGE_COUNTER_VERSION) {
+        atomic_store(&_storage->counts, packCounts(clampCount(initialValue), clampCount(previousValue)));
+        _storage->version = OS_BADGE_COUNTER_VERSION;
+    }
+    flock(fd, LOCK_UN);
+    // The mapping stays valid after the file is closed
+    close(fd);
+
+    return self;
+}
+
+- (void)dealloc {
+    if (_storage)
+        munmap(_storage, sizeof(OSBadgeCounterStorage));
+}
+
+- (NSInteger)value {
+    return unpackValue(atomic_load(&_storage->counts));
+}
+
+- (NSInteger)previousValue {
+    return unpackPreviousValue(atomic_load(&_storage->counts));
+}
+
+- (uint64_t)updateCounts:(uint64_t (^)(uint64_t counts))update {
+    uint64_t counts = atomic_load(&_storage->counts);
+    uint64_t updated;
+    do {
+        updated = update(counts);
+    } while (!atomic_compare_exchange_weak(&_storage->counts, &counts, updated));
+    return updated;
+}
+
+- (NSInteger)addIncrement:(NSInteger)increment {
+    let updated = [self updateCounts:^uint64_t(uint64_t counts) {
+        int32_t value = unpackValue(counts);
+        return packCounts(MAX(clampCount((NSInteger)value + increment), 0), value);
+    }];
+    return unpackValue(updated);
+}
+
+- (void)replaceValue:(NSInteger)value {
+    [self updateCounts:^uint64_t(uint64_t counts) {
+        return packCounts(clampCount(value), unpackValue(counts));
+    }];
+}
+
+- (void)revertToPreviousValue {
+    [self updateCounts:^uint64_t(uint64_t counts) {
+        int32_t previousValue = unpackPreviousValue(counts);
+        return packCounts(previousValue, previousValue);
+    }];
+}
+
+@end
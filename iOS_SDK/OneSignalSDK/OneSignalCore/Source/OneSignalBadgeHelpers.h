@@ -29,4 +29,6 @@
 
 @interface OneSignalBadgeHelpers : NSObject
 + (void)updateCachedBadgeValue:(NSInteger)value usePreviousBadgeCount:(BOOL)usePrevious;
++ (NSInteger)incrementCachedBadgeValue:(NSInteger)increment;
++ (NSInteger)cachedBadgeValue;
 @end
@@ -28,6 +28,8 @@
 #import "OneSignalBadgeHelpers.h"
 #import "OneSignalUserDefaults.h"
 #import "OneSignalCommonDefines.h"
+#import "OSBadgeCounter.h"
+#import "OSMacros.h"
 
 @implementation OneSignalBadgeHelpers
 
@@ -36,6 +38,15 @@
  When `usePreviousBadgeCount` is `true`, the `value` passed to this method will be unused.
  */
 + (void)updateCachedBadgeValue:(NSInteger)value usePreviousBadgeCount:(BOOL)usePrevious {
+    let counter = [OSBadgeCounter sharedInstance];
+    if (counter) {
+        if (usePrevious)
+            [counter revertToPreviousValue];
+        else
+            [counter replaceValue:value];
+        return;
+    }
+
     // Since badge logic can be executed in an extension, we need to use app groups to get
     // a shared NSUserDefaults from the app group suite name
     if (usePrevious) {
@@ -49,4 +60,25 @@
     }
 }
 
+/**
+ Notification service extensions for a burst of notifications run at the same time, so the count is changed in one atomic step.
+ Returns the new count, which does not go below 0.
+ */
++ (NSInteger)incrementCachedBadgeValue:(NSInteger)increment {
+    let counter = [OSBadgeCounter sharedInstance];
+    if (counter)
+        return [counter addIncrement:increment];
+
+    NSInteger value = MAX([self cachedBadgeValue] + increment, 0);
+    [self updateCachedBadgeValue:value usePreviousBadgeCount:false];
+    return value;
+}
+
++ (NSInteger)cachedBadgeValue {
+    let counter = [OSBadgeCounter sharedInstance];
+    if (counter)
+        return counter.value;
+    return [OneSignalUserDefaults.initShared getSavedIntegerForKey:ONESIGNAL_BADGE_KEY defaultValue:0];
+}
+
 @end
@@ -79,6 +79,7 @@
 #define OSUD_REQUIRES_USER_PRIVACY_CONSENT                                  @"OSUD_REQUIRES_USER_PRIVACY_CONSENT"
 // Remote Params - Receive Receipts
 #define OSUD_RECEIVE_RECEIPTS_ENABLED                                       @"OS_ENABLE_RECEIVE_RECEIPTS"                                       // * OSUD_RECEIVE_RECEIPTS_ENABLED
+#define OSUD_RECEIVE_RECEIPTS_BATCH_ENABLED                                 @"OSUD_RECEIVE_RECEIPTS_BATCH_ENABLED"
 // Outcomes
 #define OSUD_OUTCOMES_V2                                                    @"OSUD_OUTCOMES_V2"
 #define OSUD_NOTIFICATION_LIMIT                                             @"NOTIFICATION_LIMIT"                                               // * OSUD_NOTIFICATION_LIMIT
@@ -137,6 +138,7 @@
 #define IOS_REQUIRES_SMS_AUTHENTICATION @"require_sms_auth"
 #define IOS_REQUIRES_USER_ID_AUTHENTICATION @"require_user_id_auth"
 #define IOS_RECEIVE_RECEIPTS_ENABLE @"receive_receipts_enable"
+#define IOS_RECEIVE_RECEIPTS_BATCH_ENABLE @"receive_receipts_batch_enable"
 #define IOS_OUTCOMES_V2_SERVICE_ENABLE @"v2_enabled"
 #define IOS_LOCATION_SHARED @"location_shared"
 #define IOS_REQUIRES_USER_PRIVACY_CONSENT @"requires_user_privacy_consent"
@@ -164,6 +166,8 @@
 #define ONESIGNAL_BADGE_KEY @"onesignalBadgeCount"
 /// Store the previous badge count to read for a cancelled notification display event
 #define PREVIOUS_ONESIGNAL_BADGE_KEY @"previousOnesignalBadgeCount"
+// Memory mapped badge count shared by the app and its extensions, seeded from the keys above
+#define OS_BADGE_COUNTER_FILE @"OneSignal/badge_count"
 
 // Firebase
 #define ONESIGNAL_FB_ENABLE_FIREBASE @"OS_ENABLE_FIREBASE_ANALYTICS"
@@ -253,10 +257,26 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 #define DEVICE_TYPE_SMS 14
 
 #define MAX_NSE_LIFETIME_SECOUNDS 30
+// Receive receipts waiting to be sent, in the App Group container so the app sends the ones its extension could not
+#define OS_RECEIVE_RECEIPTS_OUTBOX_FILE @"OneSignal/receive_receipts_outbox.plist"
+// Pending receipts older than this, or that failed to send this many times, are dropped
+#define OS_RECEIVE_RECEIPTS_MAX_AGE (3 * 24 * 60 * 60)
+#define OS_RECEIVE_RECEIPTS_MAX_ATTEMPTS 5
+// How long a process has to send the receipts it took before another process may send them
+#define OS_RECEIVE_RECEIPTS_CLAIM_INTERVAL 60
+// Notifications acknowledged by the server that are remembered so they are not reported again
+#define OS_RECEIVE_RECEIPTS_ACKNOWLEDGED_LIMIT 1000
+// With batching on, receipts are held and sent together once this many are pending or the oldest has waited this long
+#define OS_RECEIVE_RECEIPTS_BATCH_MAX_SIZE 50
+#define OS_RECEIVE_RECEIPTS_BATCH_MAX_AGE (5 * 60)
+// Attachments still downloading after this are dropped, leaving time to show the notification before the extension expires
+#define MAX_NSE_ATTACHMENT_DOWNLOAD_SECONDS (MAX_NSE_LIFETIME_SECOUNDS - 5)
 
 #ifndef OS_TEST
     // OneSignal API Client Defines
     #define REATTEMPT_DELAY 5.0
+    #define REATTEMPT_MAX_DELAY 135.0
+    #define CIRCUIT_BREAKER_OPEN_SECONDS 30.0
     #define REQUEST_TIMEOUT_REQUEST 120.0 //for most HTTP requests
     #define REQUEST_TIMEOUT_RESOURCE 120.0 //for loading a resource like an image
     #define MAX_ATTEMPT_COUNT 5
@@ -270,9 +290,15 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
     // Defines the maximum delay time for confirmed deliveries
     #define MAX_CONF_DELIVERY_DELAY 25.0
 
-    // Flush interval for operation repo in milliseconds
+    // Maximum flush latency for operation repo in milliseconds, and retry interval while requests are unsent
     #define POLL_INTERVAL_MS 5000
 
+    // Quiet period after an enqueue before the operation repo flushes, in milliseconds
+    #define OP_REPO_FLUSH_DEBOUNCE_MS 1000
+
+    // How long a partial batch of custom events may wait for more events before it is sent, in milliseconds
+    #define CUSTOM_EVENTS_MAX_LINGER_MS 30000
+
     /**
      The number of seconds to delay after an operation completes that creates or changes IDs.
      This is a "cold down" period to avoid a caveat with OneSignal's backend replication, where you may
@@ -282,6 +308,9 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 #else
     // Test defines for API Client
     #define REATTEMPT_DELAY 0.004
+    // Long enough for tests to honor a Retry-After of 1 second
+    #define REATTEMPT_MAX_DELAY 2.0
+    #define CIRCUIT_BREAKER_OPEN_SECONDS 0.05
     #define REQUEST_TIMEOUT_REQUEST 0.02 //for most HTTP requests
     #define REQUEST_TIMEOUT_RESOURCE 0.02 //for loading a resource like an image
     #define MAX_ATTEMPT_COUNT 3
@@ -298,6 +327,10 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 
     // Reduce flush interval for operation repo in tests
     #define POLL_INTERVAL_MS 100
+    #define OP_REPO_FLUSH_DEBOUNCE_MS 20
+
+    // Send custom events right away in tests
+    #define CUSTOM_EVENTS_MAX_LINGER_MS 0
 
     // Reduce delay in tests
     #define OP_REPO_POST_CREATE_DELAY_SECONDS 0
@@ -306,12 +339,27 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 // A max timeout for a request, which might include multiple reattempts
 #define MAX_TIMEOUT ((REQUEST_TIMEOUT_REQUEST * MAX_ATTEMPT_COUNT) + (REATTEMPT_DELAY * MAX_ATTEMPT_COUNT)) * NSEC_PER_SEC
 
+// Consecutive 5xx responses before OneSignalClient stops sending requests to a host for CIRCUIT_BREAKER_OPEN_SECONDS
+#define CIRCUIT_BREAKER_FAILURE_THRESHOLD 5
+
+// How many HTTP requests OneSignalClient runs at once, overall and per OSRequestLane
+#define OS_REQUEST_MAX_CONCURRENT 6
+#define OS_REQUEST_LANE_USER_MAX_CONCURRENT 1
+#define OS_REQUEST_LANE_UPDATE_MAX_CONCURRENT 4
+#define OS_REQUEST_LANE_ANALYTICS_MAX_CONCURRENT 2
+
 // To save battery, NSTimer is not exceedingly accurate so timestamp values may be a bit inaccurate
 // To make up for this, we can check to make sure the values are close enough to account for
 // variance and floating-point error.
 #define OS_ROUGHLY_EQUAL(left, right) (fabs(left - right) < 0.03)
 
 #define MAX_NOTIFICATION_MEDIA_SIZE_BYTES 50000000
+// Notification attachments larger than these are rejected by iOS, videos may use the full media size
+#define MAX_NOTIFICATION_IMAGE_SIZE_BYTES 10000000
+#define MAX_NOTIFICATION_AUDIO_SIZE_BYTES 5000000
+// Notification media cache, in the Caches directory of the App Group container so the app and its extensions share it
+#define OS_NOTIFICATION_MEDIA_CACHE_DIRECTORY @"OneSignal/NotificationMedia"
+#define OS_NOTIFICATION_MEDIA_CACHE_MAX_BYTES (50 * 1024 * 1024)
 
 #pragma mark User Model
 
@@ -346,7 +394,9 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 #define OS_CUSTOM_EVENT_DELTA                                               @"OS_CUSTOM_EVENT_DELTA"
 
 // Operation Repo
+#define OP_REPO_MAX_FLUSH_BATCH_SIZE 100
 #define OS_OPERATION_REPO_DELTA_QUEUE_KEY                                   @"OS_OPERATION_REPO_DELTA_QUEUE_KEY"
+#define OS_OPERATION_REPO_JOURNAL_FILE_NAME                                 @"onesignal_operation_repo.journal"
 
 // User Executor
 #define OS_USER_EXECUTOR_USER_REQUEST_QUEUE_KEY                             @"OS_USER_EXECUTOR_USER_REQUEST_QUEUE_KEY"
@@ -370,6 +420,8 @@ typedef enum {GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT, TRACE, PATCH} HTTP
 // Custom Events Executor
 #define OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY                           @"OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY"
 #define OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY                         @"OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY"
+#define CUSTOM_EVENTS_MAX_BATCH_SIZE 100
+#define CUSTOM_EVENTS_MAX_BATCH_BYTES 102400
 
 // Live Activies Executor
 #define OS_LIVE_ACTIVITIES_EXECUTOR_UPDATE_TOKENS_KEY                       @"OS_LIVE_ACTIVITIES_EXECUTOR_UPDATE_TOKENS_KEY"
@@ -39,6 +39,11 @@
 #import <OneSignalCore/NSDateFormatter+OneSignal.h>
 #import <OneSignalCore/OSRequests.h>
 #import <OneSignalCore/OneSignalRequest.h>
+#import <OneSignalCore/OSHTTPResponse.h>
+#import <OneSignalCore/OSAttachmentDownloader.h>
+#import <OneSignalCore/OSNotificationMediaCache.h>
+#import <OneSignalCore/OSReceiveReceiptsOutbox.h>
+#import <OneSignalCore/OSReceiveReceiptsAggregator.h>
 #import <OneSignalCore/OneSignalClient.h>
 #import <OneSignalCore/OneSignalCoreHelper.h>
 #import <OneSignalCore/OneSignalTrackFirebaseAnalytics.h>
@@ -46,6 +51,7 @@
 #import <OneSignalCore/OSPrivacyConsentController.h>
 #import <OneSignalCore/OSDeviceUtils.h>
 #import <OneSignalCore/OSNetworkingUtils.h>
+#import <OneSignalCore/OSRequestRetryPolicy.h>
 #import <OneSignalCore/OSObservable.h>
 #import <OneSignalCore/OSDialogInstanceManager.h>
 #import <OneSignalCore/SwizzlingForwarder.h>
@@ -58,6 +64,7 @@
 #import <OneSignalCore/OSBundleUtils.h>
 #import <OneSignalCore/OneSignalClientError.h>
 #import <OneSignalCore/OneSignalBadgeHelpers.h>
+#import <OneSignalCore/OSBadgeCounter.h>
 
 // TODO: Testing: Should this class be defined in this file?
 @interface OneSignalCoreImpl : NSObject
@@ -36,6 +36,21 @@
 
 + (NSString * _Nonnull)appGroupName;
 
+// Instrumentation: how many app group suites have been allocated and how many times defaults were synchronized
++ (NSUInteger)suiteAllocationCount;
++ (NSUInteger)synchronizeCount;
+
+/**
+ Saves made between begin and end are synchronized to disk once, when the outermost batch ends.
+ Batches may be nested and saves from any thread during a batch are included.
+ */
+- (void)beginBatchedWrites;
+- (void)endBatchedWrites;
+- (void)performBatchedWrites:(NS_NOESCAPE void (^ _Nonnull)(void))block;
+
+// Synchronizes saves that a batch still holds back, ie: before the app is suspended
+- (void)flush;
+
 - (BOOL)keyExists:(NSString * _Nonnull)key;
 
 - (void)removeValueForKey:(NSString * _Nonnull)key;
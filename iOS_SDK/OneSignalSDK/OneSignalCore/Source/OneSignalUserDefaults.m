@@ -26,30 +26,55 @@
  */
 
 #import <Foundation/Foundation.h>
+#import <stdatomic.h>
 #import "OneSignalUserDefaults.h"
 #import "OneSignalCommonDefines.h"
 
-@implementation OneSignalUserDefaults : NSObject
+// Instrumentation, read through the class methods of the same name
+static _Atomic NSUInteger _suiteAllocationCount = 0;
+static _Atomic NSUInteger _synchronizeCount = 0;
+
+@implementation OneSignalUserDefaults {
+    // Guarded by @synchronized(self)
+    NSUInteger _batchDepth;
+    BOOL _hasUnsynchronizedWrites;
+}
 
-// TODO: Revisit if we should use a singletone, not init so much
 + (OneSignalUserDefaults * _Nonnull)initStandard {
-    OneSignalUserDefaults *instance = [OneSignalUserDefaults new];
-    instance.userDefaults = [instance getStandardUserDefault];
+    static OneSignalUserDefaults *instance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        instance = [OneSignalUserDefaults new];
+        instance.userDefaults = [instance getStandardUserDefault];
+    });
     return instance;
 }
 
-// TODO: Revisit if we should use a singletone, not init so much
+// Allocating a suite is not free, and callers use this for nearly every read and write, so the suite is cached
 + (OneSignalUserDefaults * _Nonnull)initShared {
-    OneSignalUserDefaults *instance = [OneSignalUserDefaults new];
-    instance.userDefaults = [instance getSharedUserDefault];
+    static OneSignalUserDefaults *instance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        instance = [OneSignalUserDefaults new];
+        instance.userDefaults = [instance getSharedUserDefault];
+    });
     return instance;
 }
 
++ (NSUInteger)suiteAllocationCount {
+    return atomic_load(&_suiteAllocationCount);
+}
+
++ (NSUInteger)synchronizeCount {
+    return atomic_load(&_synchronizeCount);
+}
+
 - (NSUserDefaults* _Nonnull)getStandardUserDefault {
     return NSUserDefaults.standardUserDefaults;
 }
 
 - (NSUserDefaults* _Nonnull)getSharedUserDefault {
+    atomic_fetch_add(&_suiteAllocationCount, 1);
     return [[NSUserDefaults alloc] initWithSuiteName:[self appGroupKey]];
 }
 
@@ -57,13 +82,67 @@
     return [OneSignalUserDefaults appGroupName];
 }
 
+/**
+ Saves apply to the in-memory defaults right away; only the synchronize to disk is deferred while batching.
+ */
+- (void)synchronizeIfNotBatching {
+    @synchronized (self) {
+        if (_batchDepth > 0) {
+            _hasUnsynchronizedWrites = YES;
+            return;
+        }
+    }
+    [self synchronize];
+}
+
+- (void)synchronize {
+    atomic_fetch_add(&_synchronizeCount, 1);
+    [self.userDefaults synchronize];
+}
+
+- (void)beginBatchedWrites {
+    @synchronized (self) {
+        _batchDepth++;
+    }
+}
+
+- (void)endBatchedWrites {
+    @synchronized (self) {
+        if (_batchDepth == 0) {
+            return;
+        }
+        _batchDepth--;
+        if (_batchDepth > 0 || !_hasUnsynchronizedWrites) {
+            return;
+        }
+        _hasUnsynchronizedWrites = NO;
+    }
+    [self synchronize];
+}
+
+- (void)performBatchedWrites:(NS_NOESCAPE void (^ _Nonnull)(void))block {
+    [self beginBatchedWrites];
+    block();
+    [self endBatchedWrites];
+}
+
+- (void)flush {
+    @synchronized (self) {
+        if (!_hasUnsynchronizedWrites) {
+            return;
+        }
+        _hasUnsynchronizedWrites = NO;
+    }
+    [self synchronize];
+}
+
 - (BOOL)keyExists:(NSString * _Nonnull)key {
     return [self.userDefaults objectForKey:key] != nil;
 }
 
 - (void)removeValueForKey:(NSString * _Nonnull)key {
     [self.userDefaults removeObjectForKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (BOOL)getSavedBoolForKey:(NSString * _Nonnull)key defaultValue:(BOOL)value {
@@ -75,7 +154,7 @@
 
 - (void)saveBoolForKey:(NSString * _Nonnull)key withValue:(BOOL)value {
     [self.userDefaults setBool:value forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (NSString * _Nullable)getSavedStringForKey:(NSString * _Nonnull)key defaultValue:(NSString * _Nullable)value {
@@ -87,7 +166,7 @@
 
 - (void)saveStringForKey:(NSString * _Nonnull)key withValue:(NSString * _Nullable)value {
     [self.userDefaults setObject:value forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 // NOTE: NSInteger because NSUserDefaults returns NSInteger when using integerForKey method
@@ -100,7 +179,7 @@
 
 - (void)saveIntegerForKey:(NSString * _Nonnull)key withValue:(NSInteger)value {
     [self.userDefaults setInteger:value forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (double)getSavedDoubleForKey:(NSString * _Nonnull)key defaultValue:(double)value {
@@ -112,7 +191,7 @@
 
 - (void)saveDoubleForKey:(NSString * _Nonnull)key withValue:(double)value {
     [self.userDefaults setDouble:value forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (NSSet * _Nullable)getSavedSetForKey:(NSString * _Nonnull)key defaultValue:(NSSet * _Nullable)value {
@@ -124,7 +203,7 @@
 
 - (void)saveSetForKey:(NSString * _Nonnull)key withValue:(NSSet * _Nullable)value {
     [self.userDefaults setObject:[value allObjects] forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (NSDictionary * _Nullable)getSavedDictionaryForKey:(NSString * _Nonnull)key defaultValue:(NSDictionary * _Nullable)value {
@@ -136,7 +215,7 @@
 
 - (void)saveDictionaryForKey:(NSString * _Nonnull)key withValue:(NSSet * _Nullable)value {
     [self.userDefaults setObject:value forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (id _Nullable)getSavedObjectForKey:(NSString *)key defaultValue:(id _Nullable)value {
@@ -148,7 +227,7 @@
 
 - (void)saveObjectForKey:(NSString * _Nonnull)key withValue:(id _Nullable)object {
     [self.userDefaults setObject:object forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 - (id _Nullable)getSavedCodeableDataForKey:(NSString * _Nonnull)key defaultValue:(id _Nullable)value {
@@ -160,7 +239,7 @@
 
 - (void)saveCodeableDataForKey:(NSString * _Nonnull)key withValue:(id _Nullable)value {
     [self.userDefaults setObject:[NSKeyedArchiver archivedDataWithRootObject:value] forKey:key];
-    [self.userDefaults synchronize];
+    [self synchronizeIfNotBatching];
 }
 
 //gets the NSBundle of the primary application - NOT the app extension
@@ -126,6 +126,13 @@ public class MockOneSignalClient: NSObject, IOneSignalClient {
         }
     }
 
+    /// Mock responses are recorded as decoded dictionaries, so they are passed on already decoded.
+    public func execute(_ request: OneSignalRequest, onResponse responseBlock: @escaping OSResponseBlock, onFailure failureBlock: @escaping OSClientFailureBlock) {
+        execute(request, onSuccess: { result in
+            responseBlock(OSHTTPResponse(statusCode: 200, headers: nil, jsonObject: result))
+        }, onFailure: failureBlock)
+    }
+
     /// Completes every request currently held by `holdResponses`, and stops holding further executes.
     public func releaseHeldResponses() {
         let held: [(request: OneSignalRequest, onSuccess: OSResultSuccessBlock, onFailure: OSClientFailureBlock)] = lock.withLock {
@@ -0,0 +1,218 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import OneSignalCore
+
+/// Stands in for a media host, serving bodies by path with an optional delay before the body is sent.
+private final class StubMediaProtocol: URLProtocol {
+    struct Route {
+        var statusCode = 200
+        var mimeType = "image/png"
+        var body = Data(repeating: 7, count: 1024)
+        var delay: TimeInterval = 0
+        var sendsContentLength = true
+    }
+
+    static let lock = NSLock()
+    static var routes: [String: Route] = [:]
+
+    private var pending: DispatchWorkItem?
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        StubMediaProtocol.lock.lock()
+        let route = StubMediaProtocol.routes[request.url!.path] ?? Route(statusCode: 404, body: Data())
+        StubMediaProtocol.lock.unlock()
+
+        let work = DispatchWorkItem { [weak self] in
+            guard let self = self else { return }
+            var headers = ["Content-Type": route.mimeType]
+            if route.sendsContentLength {
+                headers["Content-Length"] = String(route.body.count)
+            }
+            let response = HTTPURLResponse(url: self.request.url!, statusCode: route.statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+            self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            // Large bodies arrive in chunks, like they would over the network
+            var offset = 0
+            while offset < route.body.count {
+                let end = min(offset + 16 * 1024, route.body.count)
+                self.client?.urlProtocol(self, didLoad: route.body.subdata(in: offset..<end))
+                offset = end
+            }
+            self.client?.urlProtocolDidFinishLoading(self)
+        }
+        pending = work
+        DispatchQueue.global().asyncAfter(deadline: .now() + route.delay, execute: work)
+    }
+
+    override func stopLoading() {
+        pending?.cancel()
+    }
+}
+
+final class OSAttachmentDownloaderTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        StubMediaProtocol.lock.lock()
+        StubMediaProtocol.routes = [:]
+        StubMediaProtocol.lock.unlock()
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func serve(_ path: String, _ route: StubMediaProtocol.Route) {
+        StubMediaProtocol.lock.lock()
+        StubMediaProtocol.routes[path] = route
+        StubMediaProtocol.lock.unlock()
+    }
+
+    private func makeDownloader(maxBytesPerItem: Int64 = 50_000_000) -> OSAttachmentDownloader {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubMediaProtocol.self]
+        return OSAttachmentDownloader(sessionConfiguration: configuration, maxBytesPerItem: maxBytesPerItem)
+    }
+
+    private func download(_ downloader: OSAttachmentDownloader, _ paths: [String], timeout: TimeInterval = 10) -> [OSAttachmentDownload] {
+        var requests: [String: URLRequest] = [:]
+        for path in paths {
+            requests[path] = URLRequest(url: URL(string: "https://media.example.com\(path)")!)
+        }
+        return downloader.downloadRequests(requests, timeout: timeout) { [directory] _, _, location in
+            let fileURL = directory!.appendingPathComponent(UUID().uuidString)
+            return (try? FileManager.default.moveItem(at: location, to: fileURL)) != nil ? fileURL : nil
+        }
+    }
+
+    func testDownloadsConcurrently() throws {
+        serve("/1.png", .init(delay: 1))
+        serve("/2.png", .init(delay: 1))
+        serve("/3.png", .init(delay: 1))
+        let downloader = makeDownloader()
+
+        let start = Date()
+        let downloads = download(downloader, ["/1.png", "/2.png", "/3.png"])
+
+        XCTAssertEqual(Set(downloads.map { $0.identifier }), ["/1.png", "/2.png", "/3.png"])
+        XCTAssertLessThan(Date().timeIntervalSince(start), 2.5, "Downloads should not wait for each other")
+        for download in downloads {
+            let data = try Data(contentsOf: XCTUnwrap(download.fileURL))
+            XCTAssertEqual(data.count, 1024)
+        }
+    }
+
+    func testTimeout_returnsTheDownloadsThatFinished() throws {
+        serve("/fast.png", .init())
+        serve("/slow.png", .init(delay: 10))
+        let downloader = makeDownloader()
+
+        let start = Date()
+        let downloads = download(downloader, ["/fast.png", "/slow.png"], timeout: 1)
+
+        XCTAssertEqual(downloads.map { $0.identifier }, ["/fast.png"])
+        XCTAssertLessThan(Date().timeIntervalSince(start), 3)
+    }
+
+    func testCancelDownloads_returnsTheDownloadsThatFinished() throws {
+        serve("/fast.png", .init())
+        serve("/slow.png", .init(delay: 10))
+        let downloader = makeDownloader()
+
+        let returned = expectation(description: "batch returned")
+        var downloads: [OSAttachmentDownload] = []
+        let start = Date()
+        DispatchQueue.global().async {
+            downloads = self.download(downloader, ["/fast.png", "/slow.png"], timeout: 20)
+            returned.fulfill()
+        }
+
+        // Like the extension's time running out while a download is still in flight
+        Thread.sleep(forTimeInterval: 1)
+        let finished = downloader.cancelDownloads()
+
+        XCTAssertEqual(finished.map { $0.identifier }, ["/fast.png"])
+        wait(for: [returned], timeout: 5)
+        XCTAssertEqual(downloads.map { $0.identifier }, ["/fast.png"])
+        XCTAssertLessThan(Date().timeIntervalSince(start), 5)
+    }
+
+    func testCancelDownloads_doesNotWaitForTheFileBlock() throws {
+        serve("/1.png", .init())
+        let downloader = makeDownloader()
+        let blockStarted = DispatchSemaphore(value: 0)
+        let releaseBlock = DispatchSemaphore(value: 0)
+
+        let returned = expectation(description: "batch returned")
+        DispatchQueue.global().async { [directory] in
+            let request = URLRequest(url: URL(string: "https://media.example.com/1.png")!)
+            _ = downloader.downloadRequests(["/1.png": request], timeout: 10) { _, _, location in
+                // Like storing into the media cache while another process holds its lock
+                blockStarted.signal()
+                releaseBlock.wait()
+                let fileURL = directory!.appendingPathComponent(UUID().uuidString)
+                return (try? FileManager.default.moveItem(at: location, to: fileURL)) != nil ? fileURL : nil
+            }
+            returned.fulfill()
+        }
+        XCTAssertEqual(blockStarted.wait(timeout: .now() + 5), .success)
+
+        let start = Date()
+        XCTAssertEqual(downloader.cancelDownloads().count, 0)
+        XCTAssertLessThan(Date().timeIntervalSince(start), 0.5)
+
+        releaseBlock.signal()
+        wait(for: [returned], timeout: 5)
+    }
+
+    func testOversizedDownloadsAreDropped() throws {
+        serve("/small.mp4", .init(mimeType: "video/mp4", body: Data(repeating: 1, count: 512)))
+        serve("/declared.mp4", .init(mimeType: "video/mp4", body: Data(repeating: 1, count: 256 * 1024)))
+        serve("/streamed.mp4", .init(mimeType: "video/mp4", body: Data(repeating: 1, count: 256 * 1024), sendsContentLength: false))
+        let downloader = makeDownloader(maxBytesPerItem: 64 * 1024)
+
+        let downloads = download(downloader, ["/small.mp4", "/declared.mp4", "/streamed.mp4"])
+
+        XCTAssertEqual(downloads.map { $0.identifier }, ["/small.mp4"])
+    }
+
+    func testFailedResponsesAreDropped() throws {
+        serve("/ok.png", .init())
+        serve("/error.png", .init(statusCode: 500))
+        let downloader = makeDownloader()
+
+        let downloads = download(downloader, ["/ok.png", "/error.png", "/missing.png"])
+
+        XCTAssertEqual(downloads.map { $0.identifier }, ["/ok.png"])
+    }
+}
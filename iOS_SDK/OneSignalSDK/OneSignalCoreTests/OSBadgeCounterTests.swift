@@ -0,0 +1,108 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+final class OSBadgeCounterTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    /// Each counter maps the file separately, as the app and each extension process do.
+    private func makeCounter(initialValue: Int = 0, previousValue: Int = 0) throws -> OSBadgeCounter {
+        return try XCTUnwrap(OSBadgeCounter(fileURL: directory.appendingPathComponent("badge_count"), initialValue: initialValue, previousValue: previousValue))
+    }
+
+    func testInit_seedsFromTheLegacyCountOnlyWhenTheFileIsCreated() throws {
+        let counter = try makeCounter(initialValue: 7, previousValue: 3)
+        XCTAssertEqual(counter.value, 7)
+        XCTAssertEqual(counter.previousValue, 3)
+
+        counter.addIncrement(1)
+        let reopened = try makeCounter(initialValue: 100, previousValue: 100)
+        XCTAssertEqual(reopened.value, 8)
+        XCTAssertEqual(reopened.previousValue, 7)
+    }
+
+    func testAddIncrement_doesNotGoBelowZero() throws {
+        let counter = try makeCounter(initialValue: 2)
+
+        XCTAssertEqual(counter.addIncrement(-5), 0)
+        XCTAssertEqual(counter.addIncrement(3), 3)
+    }
+
+    func testRevertToPreviousValue_restoresTheValueBeforeTheLastChange() throws {
+        let counter = try makeCounter(initialValue: 4)
+        counter.replaceValue(9)
+
+        counter.revertToPreviousValue()
+
+        XCTAssertEqual(counter.value, 4)
+        XCTAssertEqual(counter.previousValue, 4)
+    }
+
+    func testAddIncrement_losesNoUpdatesFromConcurrentMappings() throws {
+        let mappings = 8
+        let incrementsPerMapping = 10_000
+        let counters = try (0..<mappings).map { _ in try makeCounter() }
+
+        DispatchQueue.concurrentPerform(iterations: mappings) { index in
+            for _ in 0..<incrementsPerMapping {
+                counters[index].addIncrement(1)
+            }
+        }
+
+        XCTAssertEqual(try makeCounter().value, mappings * incrementsPerMapping)
+    }
+
+    func testAddIncrement_losesNoUpdatesWhileTheFileIsCreatedConcurrently() throws {
+        let mappings = 16
+        let incrementsPerMapping = 1_000
+        let fileURL = directory.appendingPathComponent("badge_count")
+
+        DispatchQueue.concurrentPerform(iterations: mappings) { _ in
+            guard let counter = OSBadgeCounter(fileURL: fileURL, initialValue: 5, previousValue: 0) else {
+                return XCTFail("Badge counter file could not be mapped")
+            }
+            for index in 0..<incrementsPerMapping {
+                // Decrements mixed in, without reaching 0, still have to add up
+                counter.addIncrement(index % 4 == 3 ? -1 : 1)
+            }
+        }
+
+        XCTAssertEqual(try makeCounter().value, 5 + mappings * incrementsPerMapping / 2)
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+final class OSHTTPResponseTests: XCTestCase {
+
+    private func response(_ json: String) -> OSHTTPResponse {
+        return OSHTTPResponse(statusCode: 200, headers: ["Content-Type": "application/json"], data: json.data(using: .utf8))
+    }
+
+    private func elements(of response: OSHTTPResponse, forKey key: String) -> [Any]? {
+        var elements: [Any] = []
+        let found = response.enumerateArray(forKey: key) { element, _ in
+            elements.append(element)
+        }
+        return found ? elements : nil
+    }
+
+    func testJSONObject_isDecodedWithoutTheEnvelope() {
+        let response = response(#"{"identity": {"onesignal_id": "abc"}}"#)
+
+        let json = response.jsonObject as? NSDictionary
+        XCTAssertEqual(json, ["identity": ["onesignal_id": "abc"]])
+        XCTAssertEqual(response.statusCode, 200)
+        XCTAssertEqual(response.headers?["Content-Type"] as? String, "application/json")
+        XCTAssertNil(response.jsonError)
+    }
+
+    func testJSONObject_isNilForEmptyOrInvalidBodies() {
+        XCTAssertNil(response("").jsonObject)
+        XCTAssertNil(response("").jsonError)
+
+        let invalid = response("{")
+        XCTAssertNil(invalid.jsonObject)
+        XCTAssertNotNil(invalid.jsonError)
+    }
+
+    func testEnumerateArray_decodesEachElementOfTheKey() {
+        let response = response("""
+        {
+            "before": {"in_app_messages": [1, 2], "text": "]}\\" ,"},
+            "in_app_messages" : [ {"id": "a", "nested": [[{}], "[{"]}, {"id": "b\\"}"} ,{"id":"c"}],
+            "after": true
+        }
+        """)
+
+        let messages = elements(of: response, forKey: "in_app_messages") as? [[String: AnyHashable]]
+        XCTAssertEqual(messages?.map { $0["id"] }, ["a", "b\"}", "c"])
+    }
+
+    func testEnumerateArray_matchesEscapedKeys() {
+        let response = response(#"{"in\u005fapp": [], "in\u005fapp_messages": ["a"]}"#)
+
+        XCTAssertEqual(elements(of: response, forKey: "in_app_messages") as? [String], ["a"])
+    }
+
+    func testEnumerateArray_handlesEmptyArraysAndScalars() {
+        XCTAssertEqual(elements(of: response(#"{"list": []}"#), forKey: "list")?.count, 0)
+        XCTAssertEqual(elements(of: response(#"{"list": [1, "two", null, false]}"#), forKey: "list")?.count, 4)
+    }
+
+    func testEnumerateArray_failsForMissingKeysAndInvalidJSON() {
+        XCTAssertNil(elements(of: response(#"{"other": [1]}"#), forKey: "list"))
+        XCTAssertNil(elements(of: response(#"{"list": {"a": 1}}"#), forKey: "list"))
+        XCTAssertNil(elements(of: response(#"["list"]"#), forKey: "list"))
+        XCTAssertNil(elements(of: response(#"{"list": [{"a": }]}"#), forKey: "list"))
+        XCTAssertNil(elements(of: response(#"{"list": [1, 2"#), forKey: "list"))
+        XCTAssertNil(elements(of: response(""), forKey: "list"))
+    }
+
+    func testEnumerateArray_stops() {
+        var count = 0
+        let found = response(#"{"list": [1, 2, 3]}"#).enumerateArray(forKey: "list") { _, stop in
+            count += 1
+            stop.pointee = true
+        }
+        XCTAssertTrue(found)
+        XCTAssertEqual(count, 1)
+    }
+
+    func testEnumerateArray_usesTheDecodedObjectWhenThereIsOne() {
+        let response = OSHTTPResponse(statusCode: 200, headers: nil, jsonObject: ["list": [1, 2]])
+
+        XCTAssertEqual(elements(of: response, forKey: "list") as? [Int], [1, 2])
+        XCTAssertNil(elements(of: response, forKey: "other"))
+    }
+
+    // MARK: - Benchmarks
+
+    /// A large get in-app messages response, shaped like those recorded from apps with many messages.
+    private func largeInAppMessagesPayload(messageCount: Int = 2_000) -> Data {
+        let messages: [[String: Any]] = (0..<messageCount).map { index in
+            [
+                "id": UUID().uuidString,
+                "variants": [
+                    "ios": ["default": UUID().uuidString, "en": UUID().uuidString, "es": UUID().uuidString],
+                    "all": ["default": UUID().uuidString]
+                ],
+                "triggers": [
+                    [["id": UUID().uuidString, "kind": "custom", "property": "level_\(index)", "operator": "greater", "value": index]],
+                    [["id": UUID().uuidString, "kind": "session_time", "operator": "greater_or_equal", "value": 30]]
+                ],
+                "redisplay": ["limit": 5, "delay": 3600],
+                "end_time": "2030-01-01T00:00:00.000Z",
+                "has_liquid": index % 2 == 0
+            ]
+        }
+        return try! JSONSerialization.data(withJSONObject: ["in_app_messages": messages])
+    }
+
+    func testBenchmark_decodingWholeInAppMessagesResponse() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let data = largeInAppMessagesPayload()
+
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            let response = OSHTTPResponse(statusCode: 200, headers: nil, data: data)
+            let messages = (response.jsonObject as? [String: Any])?["in_app_messages"] as? [[String: Any]]
+            XCTAssertEqual(messages?.count, 2_000)
+        }
+    }
+
+    func testBenchmark_enumeratingInAppMessagesResponse() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let data = largeInAppMessagesPayload()
+
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            var count = 0
+            let response = OSHTTPResponse(statusCode: 200, headers: nil, data: data)
+            XCTAssertTrue(response.enumerateArray(forKey: "in_app_messages") { element, _ in
+                if (element as? [String: Any])?["id"] != nil {
+                    count += 1
+                }
+            })
+            XCTAssertEqual(count, 2_000)
+        }
+    }
+}
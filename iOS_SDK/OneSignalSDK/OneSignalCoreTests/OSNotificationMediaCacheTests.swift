@@ -0,0 +1,173 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import OneSignalCore
+
+/// Stands in for a campaign's media host, answering conditional requests for unchanged media with a 304.
+private final class StubCampaignMediaProtocol: URLProtocol {
+    static let etag = "\"campaign-v1\""
+    static let body = Data(repeating: 3, count: 512 * 1024)
+    static let lock = NSLock()
+    static var bytesServed = 0
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        let notModified = request.value(forHTTPHeaderField: "If-None-Match") == StubCampaignMediaProtocol.etag
+        let headers = ["Content-Type": "image/png", "ETag": StubCampaignMediaProtocol.etag]
+        let response = HTTPURLResponse(url: request.url!, statusCode: notModified ? 304 : 200, httpVersion: "HTTP/1.1", headerFields: headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        if !notModified {
+            StubCampaignMediaProtocol.lock.lock()
+            StubCampaignMediaProtocol.bytesServed += StubCampaignMediaProtocol.body.count
+            StubCampaignMediaProtocol.lock.unlock()
+            client?.urlProtocol(self, didLoad: StubCampaignMediaProtocol.body)
+        }
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
+final class OSNotificationMediaCacheTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func makeCache(maxBytes: UInt = 1024 * 1024) -> OSNotificationMediaCache {
+        return OSNotificationMediaCache(directory: directory.appendingPathComponent("cache", isDirectory: true), maxBytes: maxBytes)
+    }
+
+    private func downloadedFile(_ data: Data) throws -> URL {
+        let fileURL = directory.appendingPathComponent(UUID().uuidString)
+        try data.write(to: fileURL)
+        return fileURL
+    }
+
+    private func response(_ url: URL, statusCode: Int = 200, etag: String? = nil, lastModified: String? = nil) -> HTTPURLResponse {
+        var headers = ["Content-Type": "image/png"]
+        headers["ETag"] = etag
+        headers["Last-Modified"] = lastModified
+        return HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+    }
+
+    func testStoreFile_returnsALinkThatOutlivesTheAttachment() throws {
+        let cache = makeCache()
+        let url = URL(string: "https://media.example.com/a.png")!
+        let data = Data(repeating: 1, count: 1000)
+
+        let attachment = try XCTUnwrap(cache.storeFile(try downloadedFile(data), for: url, response: response(url), fileExtension: "png"))
+
+        XCTAssertEqual(try Data(contentsOf: attachment), data)
+        XCTAssertEqual(attachment.pathExtension, "png")
+        // iOS moves the attachment's file into its own store once the notification is shown
+        try FileManager.default.removeItem(at: attachment)
+        XCTAssertEqual(cache.totalBytes, 1000)
+        let relinked = try XCTUnwrap(cache.attachmentFile(forRevalidatedURL: url, response: response(url, statusCode: 304)))
+        XCTAssertEqual(try Data(contentsOf: relinked), data)
+    }
+
+    func testSameContentFromDifferentURLsIsStoredOnce() throws {
+        let cache = makeCache()
+        let data = Data(repeating: 2, count: 1000)
+        let first = URL(string: "https://media.example.com/a.png")!
+        let second = URL(string: "https://cdn.example.com/campaign/a.png")!
+
+        XCTAssertNotNil(cache.storeFile(try downloadedFile(data), for: first, response: response(first), fileExtension: "png"))
+        XCTAssertNotNil(cache.storeFile(try downloadedFile(data), for: second, response: response(second), fileExtension: "png"))
+
+        XCTAssertEqual(cache.totalBytes, 1000)
+    }
+
+    func testRequestForURL_isConditionalOnceCached() throws {
+        let cache = makeCache()
+        let url = URL(string: "https://media.example.com/a.png")!
+        let lastModified = "Mon, 12 Jan 1970 13:46:40 GMT"
+
+        XCTAssertNil(cache.request(for: url).value(forHTTPHeaderField: "If-None-Match"))
+
+        cache.storeFile(try downloadedFile(Data(count: 10)), for: url, response: response(url, etag: "\"v1\"", lastModified: lastModified), fileExtension: "png")
+
+        let request = cache.request(for: url)
+        XCTAssertEqual(request.value(forHTTPHeaderField: "If-None-Match"), "\"v1\"")
+        XCTAssertEqual(request.value(forHTTPHeaderField: "If-Modified-Since"), lastModified)
+        XCTAssertNil(cache.attachmentFile(forRevalidatedURL: URL(string: "https://media.example.com/b.png")!, response: response(url, statusCode: 304)))
+    }
+
+    func testEvictsTheLeastRecentlyUsedMedia() throws {
+        let cache = makeCache(maxBytes: 2500)
+        let urls = (0..<3).map { URL(string: "https://media.example.com/\($0).png")! }
+
+        for (index, url) in urls.enumerated() {
+            cache.storeFile(try downloadedFile(Data(repeating: UInt8(index), count: 1000)), for: url, response: response(url, etag: "\"\(index)\""), fileExtension: "png")
+            Thread.sleep(forTimeInterval: 0.01)
+        }
+
+        XCTAssertLessThanOrEqual(cache.totalBytes, 2500)
+        XCTAssertNil(cache.request(for: urls[0]).value(forHTTPHeaderField: "If-None-Match"))
+        XCTAssertEqual(cache.request(for: urls[2]).value(forHTTPHeaderField: "If-None-Match"), "\"2\"")
+    }
+
+    // MARK: - Benchmarks
+
+    /// Sends the same campaign image repeatedly, as a device receiving the same campaign again would.
+    func testBenchmark_repeatedCampaign() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubCampaignMediaProtocol.self]
+        let downloader = OSAttachmentDownloader(sessionConfiguration: configuration, maxBytesPerItem: 50_000_000)
+        let cache = makeCache(maxBytes: 50 * 1024 * 1024)
+        let url = URL(string: "https://media.example.com/campaign.png")!
+        let sends = 20
+
+        StubCampaignMediaProtocol.bytesServed = 0
+        let start = Date()
+        for _ in 0..<sends {
+            let downloads = downloader.downloadRequests(["image": cache.request(for: url)], timeout: 10) { url, response, location in
+                if (response as? HTTPURLResponse)?.statusCode == 304 {
+                    return cache.attachmentFile(forRevalidatedURL: url, response: response)
+                }
+                return cache.storeFile(location, for: url, response: response, fileExtension: "png")
+            }
+            XCTAssertEqual(downloads.count, 1)
+        }
+        let elapsed = Date().timeIntervalSince(start)
+
+        print("Repeated campaign: \(sends) sends in \(String(format: "%.3f", elapsed))s, \(StubCampaignMediaProtocol.bytesServed) bytes downloaded (\(sends * StubCampaignMediaProtocol.body.count) without the cache), \(cache.totalBytes) bytes cached")
+        XCTAssertEqual(StubCampaignMediaProtocol.bytesServed, StubCampaignMediaProtocol.body.count, "Only the first send should download the image")
+    }
+}
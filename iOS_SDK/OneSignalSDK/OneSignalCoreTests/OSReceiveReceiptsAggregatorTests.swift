@@ -0,0 +1,226 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+/// Stands in for the receive receipts endpoint, recording each request and answering with scripted status codes.
+private final class StubReceiptsServerProtocol: URLProtocol {
+    static let lock = NSLock()
+    static var statusCodes: [Int] = []
+    static var requests: [(method: String, path: String, body: [String: Any])] = []
+
+    static func reset(statusCodes: [Int] = []) {
+        lock.lock()
+        self.statusCodes = statusCodes
+        requests = []
+        lock.unlock()
+    }
+
+    /// The notification id each request reported, in the order they arrived
+    static var reportedNotificationIds: [String] {
+        lock.lock()
+        defer { lock.unlock() }
+        return requests.map { $0.path.components(separatedBy: "/").dropFirst(2).first ?? "" }
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        // URLSession hands the body to protocols as a stream
+        var data = request.httpBody ?? Data()
+        if let stream = request.httpBodyStream {
+            stream.open()
+            var buffer = [UInt8](repeating: 0, count: 4096)
+            while stream.hasBytesAvailable {
+                let read = stream.read(&buffer, maxLength: buffer.count)
+                if read <= 0 { break }
+                data.append(buffer, count: read)
+            }
+            stream.close()
+        }
+        let body = (try? JSONSerialization.jsonObject(with: data)) as? [String: Any] ?? [:]
+
+        StubReceiptsServerProtocol.lock.lock()
+        StubReceiptsServerProtocol.requests.append((request.httpMethod ?? "", request.url!.path, body))
+        let statusCode = StubReceiptsServerProtocol.statusCodes.isEmpty ? 200 : StubReceiptsServerProtocol.statusCodes.removeFirst()
+        StubReceiptsServerProtocol.lock.unlock()
+
+        let response = HTTPURLResponse(url: request.url!, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: nil)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: "{}".data(using: .utf8)!)
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
+final class OSReceiveReceiptsAggregatorTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        StubReceiptsServerProtocol.reset()
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func makeOutbox(claimInterval: TimeInterval = 60) -> OSReceiveReceiptsOutbox {
+        return OSReceiveReceiptsOutbox(fileURL: directory.appendingPathComponent("outbox.plist"), claimInterval: claimInterval)
+    }
+
+    private func makeAggregator(_ outbox: OSReceiveReceiptsOutbox, maxBatchSize: UInt = 50, maxBatchAge: TimeInterval = 300) -> OSReceiveReceiptsAggregator {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubReceiptsServerProtocol.self]
+        return OSReceiveReceiptsAggregator(outbox: outbox, client: OneSignalClient(sessionConfiguration: configuration), maxBatchSize: maxBatchSize, maxBatchAge: maxBatchAge)
+    }
+
+    private func send(_ aggregator: OSReceiveReceiptsAggregator, force: Bool) -> [String] {
+        var acknowledged: [String] = []
+        let sent = expectation(description: "receipts answered")
+        aggregator.sendReceipts(forcingPartialBatch: force) { notificationIds in
+            acknowledged = notificationIds
+            sent.fulfill()
+        }
+        wait(for: [sent], timeout: 5)
+        return acknowledged
+    }
+
+    private func addReceipts(_ outbox: OSReceiveReceiptsOutbox, _ notificationIds: [String], playerId: String? = "player-1") {
+        for notificationId in notificationIds {
+            XCTAssertTrue(outbox.addReceipt(notificationId: notificationId, appId: "app-1", playerId: playerId))
+        }
+    }
+
+    func testSend_reportsEachPendingReceiptWithItsOwnRequest() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1", "n2", "n3"])
+        addReceipts(outbox, ["n4"], playerId: "player-2")
+
+        let acknowledged = send(makeAggregator(outbox, maxBatchSize: 2), force: true)
+
+        XCTAssertEqual(Set(acknowledged), ["n1", "n2", "n3", "n4"])
+        XCTAssertEqual(StubReceiptsServerProtocol.requests.count, 4)
+        for request in StubReceiptsServerProtocol.requests {
+            XCTAssertEqual(request.method, "PUT")
+            XCTAssertTrue(request.path.hasSuffix("/report_received"))
+            XCTAssertEqual(request.body["app_id"] as? String, "app-1")
+            XCTAssertEqual(request.body["device_type"] as? Int, 0)
+            XCTAssertEqual(request.body["player_id"] as? String, request.path == "/notifications/n4/report_received" ? "player-2" : "player-1")
+        }
+        XCTAssertEqual(StubReceiptsServerProtocol.reportedNotificationIds.sorted(), ["n1", "n2", "n3", "n4"])
+        XCTAssertEqual(outbox.count(), 0)
+    }
+
+    func testSend_waitsForAFullBatchUnlessForced() {
+        let outbox = makeOutbox()
+        let aggregator = makeAggregator(outbox, maxBatchSize: 3)
+        addReceipts(outbox, ["n1", "n2"])
+
+        XCTAssertEqual(send(aggregator, force: false), [])
+        XCTAssertEqual(StubReceiptsServerProtocol.requests.count, 0)
+
+        addReceipts(outbox, ["n3"])
+        XCTAssertEqual(Set(send(aggregator, force: false)), ["n1", "n2", "n3"])
+        XCTAssertEqual(Set(StubReceiptsServerProtocol.reportedNotificationIds), ["n1", "n2", "n3"])
+    }
+
+    func testSend_sendsAPartialBatchOnceTheOldestReceiptHasWaitedMaxAge() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1"])
+
+        XCTAssertEqual(send(makeAggregator(outbox, maxBatchSize: 3, maxBatchAge: 0), force: false), ["n1"])
+        XCTAssertEqual(StubReceiptsServerProtocol.reportedNotificationIds, ["n1"])
+    }
+
+    func testSend_resendsAReceiptThatFailedWithARetryableError() {
+        let outbox = makeOutbox()
+        let aggregator = makeAggregator(outbox)
+        addReceipts(outbox, ["n1"])
+        StubReceiptsServerProtocol.reset(statusCodes: [429])
+
+        XCTAssertEqual(send(aggregator, force: true), [])
+        XCTAssertEqual(outbox.count(), 1)
+
+        XCTAssertEqual(send(aggregator, force: true), ["n1"])
+        XCTAssertEqual(StubReceiptsServerProtocol.reportedNotificationIds, ["n1", "n1"])
+        XCTAssertEqual(outbox.count(), 0)
+    }
+
+    func testSend_dropsAReceiptTheServerRejects() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1"])
+        StubReceiptsServerProtocol.reset(statusCodes: [400])
+
+        XCTAssertEqual(send(makeAggregator(outbox), force: true), [])
+        XCTAssertEqual(outbox.count(), 0)
+    }
+
+    func testSend_resendsReceiptsTakenByAProcessThatNeverAnswered() {
+        let outbox = makeOutbox(claimInterval: 0)
+        addReceipts(outbox, ["n1"])
+        // Another process took the receipt and was killed before sending it
+        XCTAssertEqual(outbox.takeReceipts().map { $0.notificationId }, ["n1"])
+
+        XCTAssertEqual(send(makeAggregator(outbox), force: true), ["n1"])
+        XCTAssertEqual(StubReceiptsServerProtocol.reportedNotificationIds, ["n1"])
+    }
+
+    func testSend_doesNotTakeReceiptsAnotherProcessIsSending() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1"])
+        XCTAssertEqual(outbox.takeReceipts().count, 1)
+
+        XCTAssertEqual(send(makeAggregator(outbox), force: true), [])
+        XCTAssertEqual(StubReceiptsServerProtocol.requests.count, 0)
+        XCTAssertEqual(outbox.count(), 1)
+    }
+
+    func testAddReceipt_ignoresNotificationsAlreadyAcknowledged() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1"])
+        XCTAssertEqual(send(makeAggregator(outbox), force: true), ["n1"])
+
+        XCTAssertFalse(outbox.addReceipt(notificationId: "n1", appId: "app-1", playerId: "player-1"))
+        XCTAssertEqual(send(makeAggregator(outbox), force: true), [])
+        XCTAssertEqual(StubReceiptsServerProtocol.requests.count, 1)
+    }
+
+    func testOutbox_isSharedThroughItsFile() {
+        let outbox = makeOutbox()
+        addReceipts(outbox, ["n1", "n2"])
+
+        // The extension and the app each open the file
+        let otherProcess = makeOutbox()
+        XCTAssertEqual(otherProcess.count(), 2)
+        XCTAssertFalse(otherProcess.addReceipt(notificationId: "n1", appId: "app-1", playerId: "player-1"))
+    }
+}
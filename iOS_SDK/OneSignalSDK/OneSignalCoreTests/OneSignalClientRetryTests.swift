@@ -0,0 +1,270 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+/// Stands in for the OneSignal API, answering with scripted status codes and then 200s.
+private final class StubBurstProtocol: URLProtocol {
+    static let lock = NSLock()
+    static var statusCodes: [Int] = []
+    static var headers: [String: String] = [:]
+    static var arrivals: [Date] = []
+
+    static func reset(statusCodes: [Int], headers: [String: String] = [:]) {
+        lock.lock()
+        self.statusCodes = statusCodes
+        self.headers = headers
+        arrivals = []
+        lock.unlock()
+    }
+
+    static var arrivalCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return arrivals.count
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        StubBurstProtocol.lock.lock()
+        StubBurstProtocol.arrivals.append(Date())
+        let statusCode = StubBurstProtocol.statusCodes.isEmpty ? 200 : StubBurstProtocol.statusCodes.removeFirst()
+        let headers = statusCode == 200 ? [:] : StubBurstProtocol.headers
+        StubBurstProtocol.lock.unlock()
+
+        let response = HTTPURLResponse(url: request.url!, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: "{}".data(using: .utf8)!)
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
+private final class TestRetryRequest: OneSignalRequest {
+    init(path: String = "apps/test-app-id/retry") {
+        super.init()
+        self.path = path
+        self.method = GET
+    }
+}
+
+final class OneSignalClientRetryTests: XCTestCase {
+    private let host = "api.onesignal.com"
+    private var now: TimeInterval = 1_000_000
+    private var randomValue = 0.5
+
+    private func makePolicy() -> OSRequestRetryPolicy {
+        let policy = OSRequestRetryPolicy(baseDelay: 1, maxDelay: 60, failureThreshold: 3, openInterval: 30)
+        policy.clock = { [unowned self] in self.now }
+        policy.random = { [unowned self] in self.randomValue }
+        return policy
+    }
+
+    // MARK: - Backoff
+
+    func testDelay_isDecorrelatedJitterBetweenBaseAndThreeTimesPreviousDelay() {
+        let policy = makePolicy()
+
+        randomValue = 0
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: nil), 1)
+        XCTAssertEqual(policy.delay(afterDelay: 10, retryAfter: nil), 1)
+
+        randomValue = 0.5
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: nil), 2)
+        XCTAssertEqual(policy.delay(afterDelay: 10, retryAfter: nil), 15.5)
+
+        randomValue = 0.999
+        XCTAssertEqual(policy.delay(afterDelay: 10, retryAfter: nil), 29.971, accuracy: 0.0001)
+        XCTAssertEqual(policy.delay(afterDelay: 50, retryAfter: nil), 60, "Delays are capped at the max delay")
+    }
+
+    func testDelay_honorsRetryAfter() {
+        let policy = makePolicy()
+
+        XCTAssertEqual(policy.delay(afterDelay: 10, retryAfter: "7"), 7)
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: "120"), 120, "Retry-After is honored past the max delay")
+        // 1_000_000 seconds since 1970 is Mon, 12 Jan 1970 13:46:40 GMT
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: "Mon, 12 Jan 1970 13:47:00 GMT"), 20)
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: "Mon, 12 Jan 1970 13:00:00 GMT"), 0)
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: "soon"), 2, "Invalid values fall back to jitter")
+        XCTAssertEqual(policy.delay(afterDelay: 0, retryAfter: "-5"), 2)
+    }
+
+    // MARK: - Circuit breaker
+
+    func testCircuitBreaker_opensAfterConsecutiveFailuresAndLetsOneProbeThrough() {
+        let policy = makePolicy()
+
+        policy.recordFailure(forHost: host)
+        policy.recordFailure(forHost: host)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+        policy.recordFailure(forHost: host)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 30, "Requests are held until the breaker is half open")
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: "other.onesignal.com"), 0, "Breakers are per host")
+
+        now += 29
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 1)
+        now += 1
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0, "The probe is let through once the breaker is half open")
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 1, "Only one probe at a time, others check again after the base delay")
+
+        policy.recordSuccess(forHost: host)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+    }
+
+    func testCircuitBreaker_reopensWhenProbeFails() {
+        let policy = makePolicy()
+        for _ in 0..<3 {
+            policy.recordFailure(forHost: host)
+        }
+
+        now += 30
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+        policy.recordFailure(forHost: host)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 30)
+
+        now += 30
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+    }
+
+    func testCircuitBreaker_successResetsConsecutiveFailures() {
+        let policy = makePolicy()
+        policy.recordFailure(forHost: host)
+        policy.recordFailure(forHost: host)
+        policy.recordSuccess(forHost: host)
+        policy.recordFailure(forHost: host)
+        policy.recordFailure(forHost: host)
+
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+    }
+
+    func testCircuitBreaker_ignoresRequestsWithoutResponse() {
+        let policy = makePolicy()
+        for _ in 0..<5 {
+            policy.recordNoResponse(forHost: host)
+        }
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0, "Being offline does not open the breaker")
+
+        for _ in 0..<3 {
+            policy.recordFailure(forHost: host)
+        }
+        now += 30
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0)
+        policy.recordNoResponse(forHost: host)
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 0, "A probe without a response lets the next request probe")
+        XCTAssertEqual(policy.delayBeforeRequest(toHost: host), 1)
+    }
+
+    // MARK: - OneSignalClient against a stub server
+
+    private func makeClient() -> OneSignalClient {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubBurstProtocol.self]
+        return OneSignalClient(sessionConfiguration: configuration)
+    }
+
+    private func execute(_ client: OneSignalClient, _ request: OneSignalRequest) -> OneSignalClientError? {
+        var failure: OneSignalClientError?
+        let completed = expectation(description: "request completes")
+        client.execute(request) { _ in
+            completed.fulfill()
+        } onFailure: { error in
+            failure = error
+            completed.fulfill()
+        }
+        wait(for: [completed], timeout: 5)
+        return failure
+    }
+
+    func testClient_reattemptsThrough503Burst() {
+        StubBurstProtocol.reset(statusCodes: [503, 503])
+
+        XCTAssertNil(execute(makeClient(), TestRetryRequest()))
+        XCTAssertEqual(StubBurstProtocol.arrivalCount, 3)
+    }
+
+    func testClient_waitsForRetryAfter() {
+        StubBurstProtocol.reset(statusCodes: [503], headers: ["Retry-After": "1"])
+
+        XCTAssertNil(execute(makeClient(), TestRetryRequest()))
+        let arrivals = StubBurstProtocol.arrivals
+        XCTAssertEqual(arrivals.count, 2)
+        XCTAssertGreaterThanOrEqual(arrivals[1].timeIntervalSince(arrivals[0]), 0.9)
+    }
+
+    func testClient_doesNotReattemptWhenRetryAfterExceedsMaxDelay() {
+        StubBurstProtocol.reset(statusCodes: [503], headers: ["Retry-After": "3600"])
+
+        XCTAssertEqual(execute(makeClient(), TestRetryRequest())?.code, 503)
+        XCTAssertEqual(StubBurstProtocol.arrivalCount, 1)
+    }
+
+    func testClient_holdsReattemptWhileCircuitBreakerIsOpen() {
+        let client = makeClient()
+        StubBurstProtocol.reset(statusCodes: Array(repeating: 503, count: Int(CIRCUIT_BREAKER_FAILURE_THRESHOLD)))
+
+        // Each request is attempted MAX_ATTEMPT_COUNT times, the breaker opens during the second request's attempts
+        XCTAssertNotNil(execute(client, TestRetryRequest()))
+        XCTAssertNil(execute(client, TestRetryRequest()), "The remaining reattempt is held, not dropped")
+
+        let arrivals = StubBurstProtocol.arrivals
+        XCTAssertEqual(arrivals.count, Int(CIRCUIT_BREAKER_FAILURE_THRESHOLD) + 1)
+        XCTAssertGreaterThanOrEqual(arrivals[arrivals.count - 1].timeIntervalSince(arrivals[arrivals.count - 2]), CIRCUIT_BREAKER_OPEN_SECONDS * 0.9)
+    }
+
+    func testClient_holdsNewRequestsWhileCircuitBreakerIsOpen() {
+        let client = makeClient()
+        StubBurstProtocol.reset(statusCodes: Array(repeating: 503, count: 100))
+        XCTAssertNotNil(execute(client, TestRetryRequest()))
+        XCTAssertNotNil(execute(client, TestRetryRequest()))
+
+        // Sent once the breaker is half open, one as the probe and the other after the probe closes the breaker.
+        // Distinct paths so the GET requests do not share one HTTP request.
+        StubBurstProtocol.reset(statusCodes: [])
+        let completed = expectation(description: "held requests complete")
+        completed.expectedFulfillmentCount = 2
+        for index in 0..<2 {
+            client.execute(TestRetryRequest(path: "apps/test-app-id/retry-\(index)")) { _ in
+                completed.fulfill()
+            } onFailure: { error in
+                XCTFail("Held request failed with \(error)")
+                completed.fulfill()
+            }
+        }
+        XCTAssertEqual(StubBurstProtocol.arrivalCount, 0, "Requests are not sent while the breaker is open")
+        wait(for: [completed], timeout: 5)
+        XCTAssertEqual(StubBurstProtocol.arrivalCount, 2)
+
+        XCTAssertNil(execute(client, TestRetryRequest()))
+        XCTAssertEqual(StubBurstProtocol.arrivalCount, 3)
+    }
+}
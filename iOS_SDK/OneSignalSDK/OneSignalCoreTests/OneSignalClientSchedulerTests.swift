@@ -0,0 +1,175 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+/// Stands in for the OneSignal API, answering each request after a short delay.
+/// Records the order requests arrive and finish, and how many run at once per lane.
+private final class StubAPIProtocol: URLProtocol {
+    static let lock = NSLock()
+    static var events: [String] = []
+    static var inFlightPerLane: [String: Int] = [:]
+    static var maxInFlightPerLane: [String: Int] = [:]
+    static var inFlight = 0
+    static var maxInFlight = 0
+
+    static func reset() {
+        lock.lock()
+        events = []
+        inFlightPerLane = [:]
+        maxInFlightPerLane = [:]
+        inFlight = 0
+        maxInFlight = 0
+        lock.unlock()
+    }
+
+    static func record(_ block: () -> Void) {
+        lock.lock()
+        block()
+        lock.unlock()
+    }
+
+    // Paths look like apps/<app_id>/<lane>/<name>
+    private var lane: String { request.url?.pathComponents.dropLast().last ?? "" }
+    private var name: String { "\(lane)/\(request.url?.lastPathComponent ?? "")" }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        let lane = self.lane
+        let name = self.name
+        StubAPIProtocol.record {
+            StubAPIProtocol.events.append("start:\(name)")
+            StubAPIProtocol.inFlightPerLane[lane, default: 0] += 1
+            StubAPIProtocol.maxInFlightPerLane[lane] = max(StubAPIProtocol.maxInFlightPerLane[lane] ?? 0, StubAPIProtocol.inFlightPerLane[lane]!)
+            StubAPIProtocol.inFlight += 1
+            StubAPIProtocol.maxInFlight = max(StubAPIProtocol.maxInFlight, StubAPIProtocol.inFlight)
+        }
+        DispatchQueue.global().asyncAfter(deadline: .now() + .milliseconds(5)) {
+            StubAPIProtocol.record {
+                StubAPIProtocol.events.append("end:\(name)")
+                StubAPIProtocol.inFlightPerLane[lane]! -= 1
+                StubAPIProtocol.inFlight -= 1
+            }
+            let response = HTTPURLResponse(url: self.request.url!, statusCode: 200, httpVersion: "HTTP/2", headerFields: nil)!
+            self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            self.client?.urlProtocol(self, didLoad: "{}".data(using: .utf8)!)
+            self.client?.urlProtocolDidFinishLoading(self)
+        }
+    }
+
+    override func stopLoading() {}
+}
+
+private final class TestLaneRequest: OneSignalRequest {
+    private let requestLane: OSRequestLane
+    override var lane: OSRequestLane {
+        return requestLane
+    }
+
+    init(lane: OSRequestLane, name: String) {
+        self.requestLane = lane
+        super.init()
+        let laneName = lane == .user ? "user" : lane == .analytics ? "analytics" : "update"
+        self.path = "apps/test-app-id/\(laneName)/\(name)"
+        self.method = GET
+    }
+}
+
+final class OneSignalClientSchedulerTests: XCTestCase {
+    private var client: OneSignalClient!
+
+    override func setUp() {
+        super.setUp()
+        StubAPIProtocol.reset()
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubAPIProtocol.self]
+        client = OneSignalClient(sessionConfiguration: configuration)
+    }
+
+    private func execute(_ requests: [OneSignalRequest]) {
+        let completed = expectation(description: "all requests complete")
+        completed.expectedFulfillmentCount = requests.count
+        for request in requests {
+            client.execute(request) { _ in
+                completed.fulfill()
+            } onFailure: { error in
+                XCTFail("Request failed: \(error)")
+                completed.fulfill()
+            }
+        }
+        wait(for: [completed], timeout: 5)
+    }
+
+    func testLaneConcurrencyLimits() {
+        let requests = (0..<10).map { TestLaneRequest(lane: .update, name: "\($0)") }
+            + (0..<5).map { TestLaneRequest(lane: .analytics, name: "\($0)") }
+
+        execute(requests)
+
+        XCTAssertLessThanOrEqual(StubAPIProtocol.maxInFlightPerLane["update"]!, Int(OS_REQUEST_LANE_UPDATE_MAX_CONCURRENT))
+        XCTAssertLessThanOrEqual(StubAPIProtocol.maxInFlightPerLane["analytics"]!, Int(OS_REQUEST_LANE_ANALYTICS_MAX_CONCURRENT))
+        XCTAssertLessThanOrEqual(StubAPIProtocol.maxInFlight, Int(OS_REQUEST_MAX_CONCURRENT))
+        XCTAssertEqual(StubAPIProtocol.events.filter { $0.hasPrefix("start:") }.count, 15)
+    }
+
+    func testUserLaneRunsOneAtATimeInOrder() {
+        execute((0..<3).map { TestLaneRequest(lane: .user, name: "\($0)") })
+
+        XCTAssertEqual(StubAPIProtocol.events, ["start:user/0", "end:user/0", "start:user/1", "end:user/1", "start:user/2", "end:user/2"])
+    }
+
+    func testAnalyticsWaitsForWaitingUserRequests() {
+        execute([
+            TestLaneRequest(lane: .user, name: "0"),
+            TestLaneRequest(lane: .user, name: "1"),
+            TestLaneRequest(lane: .analytics, name: "0")
+        ])
+
+        let events = StubAPIProtocol.events
+        XCTAssertGreaterThan(events.firstIndex(of: "start:analytics/0")!, events.firstIndex(of: "end:user/0")!)
+    }
+
+    func testUpdateLaneDoesNotWaitForWaitingUserRequests() {
+        execute([
+            TestLaneRequest(lane: .user, name: "0"),
+            TestLaneRequest(lane: .user, name: "1"),
+            TestLaneRequest(lane: .update, name: "0")
+        ])
+
+        let events = StubAPIProtocol.events
+        XCTAssertLessThan(events.firstIndex(of: "start:update/0")!, events.firstIndex(of: "end:user/0")!)
+    }
+
+    func testIdenticalGetRequestsShareOneInFlightRequest() {
+        execute((0..<3).map { _ in TestLaneRequest(lane: .update, name: "same") })
+
+        XCTAssertEqual(StubAPIProtocol.events, ["start:update/same", "end:update/same"])
+    }
+}
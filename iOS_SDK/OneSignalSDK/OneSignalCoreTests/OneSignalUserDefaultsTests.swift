@@ -0,0 +1,93 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+
+final class OneSignalUserDefaultsTests: XCTestCase {
+
+    private let keys = (0..<5).map { "OneSignalUserDefaultsTests_key_\($0)" }
+
+    override func tearDownWithError() throws {
+        for key in keys {
+            OneSignalUserDefaults.initShared().removeValue(forKey: key)
+        }
+    }
+
+    func testInitShared_reusesOneSuite() {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let allocations = OneSignalUserDefaults.suiteAllocationCount()
+
+        for _ in 0..<10 {
+            XCTAssertTrue(OneSignalUserDefaults.initShared().userDefaults === userDefaults.userDefaults)
+        }
+        XCTAssertEqual(OneSignalUserDefaults.suiteAllocationCount(), allocations)
+        XCTAssertLessThanOrEqual(allocations, 1)
+    }
+
+    func testBatchedWrites_synchronizeOnceWhenOutermostBatchEnds() {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let synchronizeCount = OneSignalUserDefaults.synchronizeCount()
+
+        userDefaults.performBatchedWrites {
+            for (index, key) in keys.enumerated() {
+                userDefaults.saveInteger(forKey: key, withValue: index)
+            }
+            userDefaults.performBatchedWrites {
+                userDefaults.saveString(forKey: keys[0], withValue: "nested")
+            }
+            // Saves are visible right away, only the synchronize is deferred
+            XCTAssertEqual(userDefaults.getSavedString(forKey: keys[0], defaultValue: nil), "nested")
+            XCTAssertEqual(OneSignalUserDefaults.synchronizeCount(), synchronizeCount)
+        }
+
+        XCTAssertEqual(OneSignalUserDefaults.synchronizeCount(), synchronizeCount + 1)
+    }
+
+    func testBatchedWrites_withoutSavesDoNotSynchronize() {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let synchronizeCount = OneSignalUserDefaults.synchronizeCount()
+
+        userDefaults.performBatchedWrites {}
+        userDefaults.flush()
+
+        XCTAssertEqual(OneSignalUserDefaults.synchronizeCount(), synchronizeCount)
+    }
+
+    func testFlush_synchronizesSavesHeldBackByBatch() {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let synchronizeCount = OneSignalUserDefaults.synchronizeCount()
+
+        userDefaults.beginBatchedWrites()
+        userDefaults.saveBool(forKey: keys[0], withValue: true)
+        userDefaults.flush()
+        XCTAssertEqual(OneSignalUserDefaults.synchronizeCount(), synchronizeCount + 1)
+
+        userDefaults.endBatchedWrites()
+        XCTAssertEqual(OneSignalUserDefaults.synchronizeCount(), synchronizeCount + 1, "Nothing is left to synchronize after a flush")
+    }
+}
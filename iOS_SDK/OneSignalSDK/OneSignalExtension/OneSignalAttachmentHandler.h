@@ -31,6 +31,8 @@
 @interface OneSignalAttachmentHandler : NSObject
 
 + (void)addAttachments:(OSNotification*)notification toNotificationContent:(UNMutableNotificationContent*)content;
+// Stops the attachment downloads in flight and adds the attachments that already finished
++ (void)addFinishedAttachments:(OSNotification*)notification toNotificationContent:(UNMutableNotificationContent*)content;
 + (void)addActionButtons:(OSNotification*)notification toNotificationContent:(UNMutableNotificationContent*)content;
 + (UNNotificationAction *)createActionForButton:(NSDictionary *)button;
 @end
@@ -30,126 +30,6 @@
 #import "OneSignalNotificationCategoryController.h"
 #import "OSMacros.h"
 
-@interface DirectDownloadDelegate : NSObject <NSURLSessionDataDelegate> {
-    NSError* error;
-    NSURLResponse* response;
-    BOOL done;
-    NSFileHandle* outputHandle;
-}
-
-@property (readonly, getter=isDone) BOOL done;
-@property (readonly) NSError* error;
-@property (readonly) NSURLResponse* response;
-
-@end
-
-@implementation DirectDownloadDelegate
-@synthesize error, response, done;
-
--(void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
-    NSError * __autoreleasing fileHandleError;
-    NSError * __autoreleasing *fileHandleErrorPointer = &fileHandleError;
-    if (@available(iOS 13.0, *)) {
-        // We need to use NSInvocation for reflection because performSelector cannot take pointer parameters
-        SEL writeDataSelector = NSSelectorFromString(@"writeData:error:");
-        NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:[NSFileHandle instanceMethodSignatureForSelector:writeDataSelector]];
-        [invocation setTarget:outputHandle];
-        [invocation setSelector:writeDataSelector];
-        /*
-         From Apple's Documentation on NSInvocation:
-         Indices 0 and 1 indicate the hidden arguments self and _cmd, respectively;
-         you should set these values directly with the target and selector properties.
-         Use indices 2 and greater for the arguments normally passed in a message.
-        */
-        [invocation setArgument:&data atIndex:2];
-        [invocation setArgument:&fileHandleErrorPointer atIndex:3];
-        [invocation invoke];
-    } else {
-        @try {
-            [outputHandle writeData:data];
-        } @catch (NSException *e) {
-            NSDictionary *userInfo = @{
-                NSLocalizedDescriptionKey : @"Failed to write attachment data to filehandle",
-            };
-            fileHandleError = [NSError errorWithDomain:@"com.onesignal.download" code:0 userInfo:userInfo];
-        }
-    }
-    
-    if (fileHandleError != nil) {
-        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"OneSignal Error encountered while downloading attachment: %@", fileHandleError]];
-    }
-}
-
-- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)aResponse completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
-    response = aResponse;
-    long long expectedLength = response.expectedContentLength;
-    if (expectedLength > MAX_NOTIFICATION_MEDIA_SIZE_BYTES) { //Enforcing 50 mb limit on media before downloading
-        completionHandler(NSURLSessionResponseCancel);
-        return;
-    }
-    completionHandler(NSURLSessionResponseAllow);
-}
-
--(void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)anError {
-    error = anError;
-    done = YES;
-    
-    [outputHandle closeFile];
-}
-
--(void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)anError {
-    done = YES;
-    error = anError;
-    [outputHandle closeFile];
-}
-
-- (id)initWithFilePath:(NSString*)path {
-    if (self = [super init]) {
-        if ([[NSFileManager defaultManager] fileExistsAtPath:path])
-            [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
-        
-        [[NSFileManager defaultManager] createFileAtPath:path contents:nil attributes:nil];
-        outputHandle = [NSFileHandle fileHandleForWritingAtPath:path];
-    }
-    return self;
-}
-@end
-
-@interface NSURLSession (DirectDownload)
-+ (NSString *)downloadItemAtURL:(NSURL *)url toFile:(NSString *)localPath error:(NSError **)error;
-@end
-
-@implementation NSURLSession (DirectDownload)
-
-+ (NSString *)downloadItemAtURL:(NSURL *)url toFile:(NSString *)localPath error:(NSError **)error {
-    NSMutableURLRequest *request = [[NSMutableURLRequest alloc] initWithURL:url];
-    
-    DirectDownloadDelegate *delegate = [[DirectDownloadDelegate alloc] initWithFilePath:localPath];
-    
-    NSURLSession *session = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration] delegate:delegate delegateQueue:nil];
-    
-    NSURLSessionDataTask *task = [session dataTaskWithRequest:request];
-    
-    [task resume];
-    
-    [session finishTasksAndInvalidate];
-    
-    while (![delegate isDone]) {
-        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
-    }
-    
-    NSError *downloadError = [delegate error];
-    if (downloadError != nil) {
-        if (error)
-            *error = downloadError;
-        return nil;
-    }
-    
-    return delegate.response.MIMEType;
-}
-
-@end
-
 @implementation OneSignalAttachmentHandler
 
 + (void)addActionButtons:(OSNotification*)notification
@@ -207,6 +87,56 @@
     if (!notification.attachments)
         return;
     
+    [self removeLegacyCachedMedia];
+    
+    // Remote media is downloaded concurrently, the notification is shown once all of it finished or the time ran out
+    // Media that is already cached is only revalidated
+    let mediaCache = OSNotificationMediaCache.sharedInstance;
+    let requests = [NSMutableDictionary<NSString *, NSURLRequest *> new];
+    let urls = [self remoteAttachmentURLs:notification];
+    for (NSString *key in urls)
+        requests[key] = [mediaCache requestForURL:urls[key]];
+    
+    let downloads = [OSAttachmentDownloader.sharedInstance downloadRequests:requests
+                                                                    timeout:MAX_NSE_ATTACHMENT_DOWNLOAD_SECONDS
+                                                                       file:^NSURL *(NSURL *url, NSURLResponse *response, NSURL *location) {
+        if ([response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode == 304)
+            return [mediaCache attachmentFileForRevalidatedURL:url response:response];
+        
+        NSString *extension = [self getSupportedFileExtensionFromURL:url mimeType:response.MIMEType];
+        if (!extension || [extension isEqualToString:@""])
+            return nil;
+        return [mediaCache storeFile:location forURL:url response:response fileExtension:extension];
+    }];
+    content.attachments = [self attachmentsForNotification:notification downloads:downloads];
+}
+
++ (void)addFinishedAttachments:(OSNotification*)notification
+         toNotificationContent:(UNMutableNotificationContent*)content {
+    if (!notification.attachments)
+        return;
+    
+    let downloads = [OSAttachmentDownloader.sharedInstance cancelDownloads];
+    content.attachments = [self attachmentsForNotification:notification downloads:downloads];
+}
+
++ (NSDictionary<NSString *, NSURL *> *)remoteAttachmentURLs:(OSNotification*)notification {
+    let urls = [NSMutableDictionary<NSString *, NSURL *> new];
+    for (NSString* key in notification.attachments) {
+        let URI = [OneSignalCoreHelper trimURLSpacing:[notification.attachments valueForKey:key]];
+        let nsURL = [NSURL URLWithString:URI];
+        if (nsURL && [self isWWWScheme:nsURL])
+            urls[key] = nsURL;
+    }
+    return urls;
+}
+
++ (NSArray<UNNotificationAttachment *> *)attachmentsForNotification:(OSNotification*)notification
+                                                          downloads:(NSArray<OSAttachmentDownload *> *)downloads {
+    let downloadsByKey = [NSMutableDictionary<NSString *, OSAttachmentDownload *> new];
+    for (OSAttachmentDownload *download in downloads)
+        downloadsByKey[download.identifier] = download;
+    
     let unAttachments = [NSMutableArray new];
     
     for(NSString* key in notification.attachments) {
@@ -216,19 +146,14 @@
         
         // Remote media attachment */
         if (nsURL && [self isWWWScheme:nsURL]) {
-            // Synchroneously download file and chache it
-            let name = [self downloadMediaAndSaveInBundle:URI];
-            
-            if (!name)
+            let download = downloadsByKey[key];
+            if (!download.fileURL || ![download.URL isEqual:nsURL])
                 continue;
             
-            let paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
-            let filePath = [paths[0] stringByAppendingPathComponent:name];
-            let url = [NSURL fileURLWithPath:filePath];
             NSError* error;
             let attachment = [UNNotificationAttachment
                               attachmentWithIdentifier:key
-                              URL:url
+                              URL:download.fileURL
                               options:0
                               error:&error];
             if (attachment)
@@ -259,7 +184,7 @@
         }
     }
     
-    content.attachments = unAttachments;
+    return unAttachments;
 }
 
 + (UNNotificationAction *)createActionForButton:(NSDictionary *)button {
@@ -308,63 +233,24 @@
 }
 
 /*
- Synchroneously downloads an attachment
- On success returns bundle resource name, otherwise returns nil
+ Media used to be saved in the Caches directory under a random name, with the names kept in a list that was never cleaned up
+ The files are removed once, the media cache took their place
 */
-+ (NSString *)downloadMediaAndSaveInBundle:(NSString *)urlString {
-    
-    let url = [NSURL URLWithString:urlString];
-
-    //Download the file
-    var name = [self randomStringWithLength:10];
-
-    NSArray* paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
-    NSString* filePath = [paths[0] stringByAppendingPathComponent:name];
-    
-    //guard against situations where for example, available storage is too low
-    
-    @try {
-        NSError* error;
-        let mimeType = [NSURLSession downloadItemAtURL:url toFile:filePath error:&error];
-        
-        if (error) {
-            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Encountered an error while attempting to download file with URL: %@", error]];
-            return nil;
-        }
-
-        NSString *extension = [self getSupportedFileExtensionFromURL:url mimeType:mimeType];
-        if (!extension || [extension isEqualToString:@""])
-            return nil;
-
-        name = [NSString stringWithFormat:@"%@.%@", name, extension];
-
-        let newPath = [paths[0] stringByAppendingPathComponent:[NSString stringWithFormat:@"%@", name]];
-
-        [[NSFileManager defaultManager] moveItemAtPath:filePath toPath:newPath error:&error];
-        
-        if (error) {
-            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Encountered an error while attempting to download file with URL: %@", error]];
-            return nil;
-        }
-
++ (void)removeLegacyCachedMedia {
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
         let standardUserDefaults = OneSignalUserDefaults.initStandard;
-
-        NSArray* cachedFiles = [standardUserDefaults getSavedObjectForKey:OSUD_TEMP_CACHED_NOTIFICATION_MEDIA defaultValue:nil];
-        NSMutableArray* appendedCache;
-        if (cachedFiles) {
-            appendedCache = [[NSMutableArray alloc] initWithArray:cachedFiles];
-            [appendedCache addObject:name];
-        }
-        else
-            appendedCache = [[NSMutableArray alloc] initWithObjects:name, nil];
-
-        [standardUserDefaults saveObjectForKey:OSUD_TEMP_CACHED_NOTIFICATION_MEDIA withValue:appendedCache];
-        return name;
-    } @catch (NSException *exception) {
-        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"OneSignal encountered an exception while downloading file (%@), exception: %@", url, exception.description]];
+        NSArray *cachedFiles = [standardUserDefaults getSavedObjectForKey:OSUD_TEMP_CACHED_NOTIFICATION_MEDIA defaultValue:nil];
+        if (!cachedFiles)
+            return;
         
-        return nil;
-    }
+        let caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+        for (id name in cachedFiles) {
+            if ([name isKindOfClass:[NSString class]] && [name length] > 0)
+                [NSFileManager.defaultManager removeItemAtPath:[caches stringByAppendingPathComponent:name] error:nil];
+        }
+        [standardUserDefaults removeValueForKey:OSUD_TEMP_CACHED_NOTIFICATION_MEDIA];
+    });
 }
 
 + (BOOL)isWWWScheme:(NSURL*)url {
@@ -372,17 +258,6 @@
     return [urlScheme isEqualToString:@"http"] || [urlScheme isEqualToString:@"https"];
 }
 
-+(NSString*)randomStringWithLength:(int)length {
-    let letters = @"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    let randomString = [[NSMutableString alloc] initWithCapacity:length];
-    for(var i = 0; i < length; i++) {
-        let ln = (uint32_t)letters.length;
-        let rand = arc4random_uniform(ln);
-        [randomString appendFormat:@"%C", [letters characterAtIndex:rand]];
-    }
-    return randomString;
-}
-
 /*
  The preference order for file type determination is as follows:
     1. URL Query parameter called 'filename', such as test.jpg. The SDK will extract the file extension from it
@@ -40,21 +40,11 @@
         return;
     }
     
-    int currentValue = (int)OneSignalExtensionBadgeHandler.currentCachedBadgeValue ?: 0;
-    
-    currentValue += (int)notification.badgeIncrement;
-    
-    //cannot have negative badge values
-    if (currentValue < 0)
-        currentValue = 0;
-    
-    replacementContent.badge = @(currentValue);
-    
-    [OneSignalBadgeHelpers updateCachedBadgeValue:currentValue usePreviousBadgeCount:false];
+    replacementContent.badge = @([OneSignalBadgeHelpers incrementCachedBadgeValue:notification.badgeIncrement]);
 }
 
 + (NSInteger)currentCachedBadgeValue {
-    return [OneSignalUserDefaults.initShared getSavedIntegerForKey:ONESIGNAL_BADGE_KEY defaultValue:0];
+    return [OneSignalBadgeHelpers cachedBadgeValue];
 }
 
 @end
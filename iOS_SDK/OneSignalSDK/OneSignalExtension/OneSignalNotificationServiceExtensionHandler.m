@@ -48,6 +48,9 @@
                 withContentHandler:(void (^)(UNNotificationContent * _Nonnull))contentHandler {
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"NSE request received"];
     
+    // Synchronize the saves made while handling the notification once, before it is shown
+    [OneSignalUserDefaults.initShared beginBatchedWrites];
+
     if (!replacementContent)
         replacementContent = [request.content mutableCopy];
     
@@ -76,16 +79,18 @@
     
     // Trigger the notification to be shown with the replacementContent
     if (contentHandler) {
-        dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
-        [self onNotificationReceived:receivedNotificationId withBlockingTask:semaphore];
-        // Download Media Attachments after kicking off the confirmed delivery task
+        // The confirmed delivery is saved to be sent after a random delay, the extension does not wait for it
+        // If the extension exits first it is sent the next time the app or the extension runs
+        [self onNotificationReceived:receivedNotificationId randomizeReceiptDelay:true];
+        // Download Media Attachments
         [OneSignalAttachmentHandler addAttachments:notification toNotificationContent:replacementContent];
+        [OneSignalUserDefaults.initShared endBatchedWrites];
         contentHandler(replacementContent);
-        dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, MAX_NSE_LIFETIME_SECOUNDS * NSEC_PER_SEC));
     } else {
-        [self onNotificationReceived:receivedNotificationId withBlockingTask:nil];
+        [self onNotificationReceived:receivedNotificationId randomizeReceiptDelay:false];
         // Download Media Attachments
         [OneSignalAttachmentHandler addAttachments:notification toNotificationContent:replacementContent];
+        [OneSignalUserDefaults.initShared endBatchedWrites];
     }
 
     return replacementContent;
@@ -108,6 +113,9 @@
 
 + (UNMutableNotificationContent*)serviceExtensionTimeWillExpireRequest:(UNNotificationRequest*)request
                                         withMutableNotificationContent:(UNMutableNotificationContent*)replacementContent {
+    // The extension may be killed right after this, write out any saves a batch is still holding back
+    [OneSignalUserDefaults.initShared flush];
+
     if (!replacementContent)
         replacementContent = [request.content mutableCopy];
     
@@ -117,6 +125,9 @@
                                  withNotification:notification
               withMutableNotificationContent:replacementContent];
     
+    // Show the notification with the media that finished downloading
+    [OneSignalAttachmentHandler addFinishedAttachments:notification toNotificationContent:replacementContent];
+    
     return replacementContent;
 }
 
@@ -131,7 +142,7 @@
     [OneSignalAttachmentHandler addActionButtons:notification toNotificationContent:replacementContent];
 }
 
-+ (void)onNotificationReceived:(NSString *)receivedNotificationId withBlockingTask:(dispatch_semaphore_t)semaphore {
++ (void)onNotificationReceived:(NSString *)receivedNotificationId randomizeReceiptDelay:(BOOL)randomizeReceiptDelay {
     if (receivedNotificationId && ![receivedNotificationId isEqualToString:@""]) {
         // If update was made without app being initialized/launched before -> migrate
         [OneSignalCoreImpl migrate];
@@ -144,19 +155,13 @@
         NSString *playerId = OneSignalIdentifiers.subscriptionId;
         NSString *appId = OneSignalIdentifiers.storedAppId;
         // Randomize send of confirmed deliveries to lessen traffic for high recipient notifications
-        int randomDelay = semaphore != nil ? arc4random_uniform(MAX_CONF_DELIVERY_DELAY) : 0;
+        int randomDelay = randomizeReceiptDelay ? arc4random_uniform(MAX_CONF_DELIVERY_DELAY) : 0;
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"OneSignal onNotificationReceived sendReceiveReceipt with delay: %i", randomDelay]];
         OneSignalReceiveReceiptsController *controller = [OneSignalReceiveReceiptsController new];
         [controller sendReceiveReceiptWithPlayerId:playerId notificationId:receivedNotificationId appId:appId delay:randomDelay successBlock:^(NSDictionary *result) {
             [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"OneSignal onNotificationReceived sendReceiveReceipt Success for playerId: %@ result: %@", playerId, result]];
-            if (semaphore) {
-                dispatch_semaphore_signal(semaphore);
-            }
         } failureBlock:^(NSError *error) {
             [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"OneSignal onNotificationReceived sendReceiveReceipt Failed for playerId: %@ error: %@", playerId, error]];
-            if (semaphore) {
-                dispatch_semaphore_signal(semaphore);
-            }
         }];
    }
 }
@@ -48,4 +48,7 @@
                           successBlock:(nullable OSResultSuccessBlock)success
                           failureBlock:(nullable OSFailureBlock)failure;
 
+// Sends the receipts saved by earlier launches of the app or its notification service extension
+- (void)sendPendingReceiveReceipts;
+
 @end
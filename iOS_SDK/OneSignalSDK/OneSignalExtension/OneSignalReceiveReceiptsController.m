@@ -30,7 +30,6 @@
 #import <OneSignalCore/OneSignalCore.h>
 #import <OneSignalOSCore/OneSignalOSCore-Swift.h>
 #import "OSMacros.h"
-#import "OneSignalExtensionRequests.h"
 
 @implementation OneSignalReceiveReceiptsController
 
@@ -46,6 +45,13 @@
     return [cached isEqualToString:@"1"];
 }
 
+- (BOOL)isReceiveReceiptsBatchingEnabled {
+    if ([OneSignalUserDefaults.initShared getSavedBoolForKey:OSUD_RECEIVE_RECEIPTS_BATCH_ENABLED defaultValue:NO])
+        return YES;
+    // Same fallback as isReceiveReceiptsEnabled for an NSE running while the device is locked
+    return [[OSResilientStorage stringForKey:OSResilientStorage.keyReceiveReceiptsBatchEnabled] isEqualToString:@"1"];
+}
+
 - (void)sendReceiveReceiptWithNotificationId:(NSString *)notificationId {
     NSString *playerId = OneSignalIdentifiers.subscriptionId;
     NSString *appId = OneSignalIdentifiers.storedAppId;
@@ -73,8 +79,8 @@
                           notificationId:notificationId
                                    appId:appId
                                    delay:0
-                            successBlock:nil
-                            failureBlock:nil];
+                            successBlock:success
+                            failureBlock:failure];
 }
 
 - (void)sendReceiveReceiptWithPlayerId:(nonnull NSString *)playerId
@@ -101,21 +107,77 @@
         return;
     }
 
-    let request = [OSRequestReceiveReceipts withPlayerId:playerId notificationId:notificationId appId:appId];
+    // Saved before anything is sent so the receipt survives the extension exiting before the delay is over
+    [[OSReceiveReceiptsOutbox sharedInstance] addReceiptWithNotificationId:notificationId appId:appId playerId:playerId];
 
     dispatch_time_t dispatchTime = dispatch_time(DISPATCH_TIME_NOW, delay * NSEC_PER_SEC);
-    dispatch_after(dispatchTime, dispatch_get_main_queue(), ^{
+    dispatch_after(dispatchTime, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"OneSignal sendReceiveReceiptWithPlayerId now sending confirmed delievery after: %i second delay", delay]];
+        [self sendPendingReceiveReceiptsReportingNotificationId:notificationId successBlock:success failureBlock:failure];
+    });
+}
+
+- (void)sendPendingReceiveReceipts {
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [self sendPendingReceiveReceiptsReportingNotificationId:nil successBlock:nil failureBlock:nil];
+    });
+}
+
+/*
+ Sends every receipt in the outbox, including ones other launches of the app or the extension added and could not send
+ success or failure is called for the receipt of notificationId, failure without an error if it was left for another process or a later batch
+ */
+- (void)sendPendingReceiveReceiptsReportingNotificationId:(NSString *)notificationId
+                                             successBlock:(OSResultSuccessBlock)success
+                                             failureBlock:(OSFailureBlock)failure {
+    let outbox = [OSReceiveReceiptsOutbox sharedInstance];
+    if (![self isReceiveReceiptsEnabled]) {
+        [outbox removeAll];
+        if (notificationId && failure)
+            failure(nil);
+        return;
+    }
+
+    if ([self isReceiveReceiptsBatchingEnabled]) {
+        // The app has time to send a partial batch, the extension waits until one fills up or gets old
+        let aggregator = [[OSReceiveReceiptsAggregator alloc] initWithOutbox:outbox
+                                                                      client:OneSignalCoreImpl.sharedClient
+                                                                maxBatchSize:OS_RECEIVE_RECEIPTS_BATCH_MAX_SIZE
+                                                                 maxBatchAge:OS_RECEIVE_RECEIPTS_BATCH_MAX_AGE];
+        [aggregator sendReceiptsForcingPartialBatch:notificationId == nil completion:^(NSArray<NSString *> *acknowledgedNotificationIds) {
+            if (!notificationId)
+                return;
+            if ([acknowledgedNotificationIds containsObject:notificationId]) {
+                if (success)
+                    success(nil);
+            } else if (failure) {
+                failure(nil);
+            }
+        }];
+        return;
+    }
+
+    BOOL sendingReported = NO;
+    for (OSReceiveReceipt *receipt in [outbox takeReceipts]) {
+        BOOL reported = [receipt.notificationId isEqualToString:notificationId];
+        sendingReported |= reported;
+        let request = [OSRequestReceiveReceipts withPlayerId:receipt.playerId notificationId:receipt.notificationId appId:receipt.appId];
         [OneSignalCoreImpl.sharedClient executeRequest:request onSuccess:^(NSDictionary *result) {
-            if (success) {
+            [outbox acknowledgeReceiptsWithNotificationIds:@[receipt.notificationId]];
+            if (reported && success)
                 success(result);
-            }
         } onFailure:^(OneSignalClientError *error) {
-            if (failure) {
+            if ([OSNetworkingUtils getResponseStatusType:error.code] == OSResponseStatusRetryable)
+                [outbox returnReceiptsWithNotificationIds:@[receipt.notificationId]];
+            else
+                [outbox removeReceiptsWithNotificationIds:@[receipt.notificationId]];
+            if (reported && failure)
                 failure(error.underlyingError);
-            }
         }];
-    });
+    }
+
+    if (notificationId && !sendingReported && failure)
+        failure(nil);
 }
 
 @end
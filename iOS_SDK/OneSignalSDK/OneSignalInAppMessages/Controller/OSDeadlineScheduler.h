@@ -0,0 +1,60 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSTimeInterval (^OSDeadlineClock)(void);
+
+/**
+ Schedules keyed deadlines on a single timer, backed by a min-heap on a private serial queue.
+ Deadlines are rounded up to a tick, and all the keys expiring in the same tick are delivered in one call.
+ While paused, expired deadlines are held and delivered together when resumed.
+ */
+@interface OSDeadlineScheduler : NSObject
+
+// The clock defaults to the system uptime, the handler is called asynchronously on the callback queue
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval
+                               clock:(OSDeadlineClock _Nullable)clock
+                       callbackQueue:(dispatch_queue_t)callbackQueue
+                             handler:(void (^)(NSArray<NSString *> *expiredKeys))handler;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, getter=isPaused) BOOL paused;
+@property (nonatomic, readonly) NSUInteger count;
+
+// Returns NO without rescheduling if the key already has a deadline
+- (BOOL)scheduleKey:(NSString *)key after:(NSTimeInterval)delay;
+- (BOOL)hasDeadlineForKey:(NSString *)key;
+// Delivers the deadlines that expired by the clock's current time, also called by the timer
+- (void)fireExpiredDeadlines;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,213 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSDeadlineScheduler.h"
+#import "OSMacros.h"
+
+@interface OSDeadline : NSObject
+@property (nonatomic) NSTimeInterval deadline;
+@property (strong, nonatomic, nonnull) NSString *key;
+@end
+
+@implementation OSDeadline
+@end
+
+@interface OSDeadlineScheduler ()
+@property (nonatomic) NSTimeInterval tickInterval;
+@property (copy, nonatomic, nonnull) OSDeadlineClock clock;
+@property (strong, nonatomic, nonnull) dispatch_queue_t queue;
+@property (strong, nonatomic, nonnull) dispatch_queue_t callbackQueue;
+@property (copy, nonatomic, nonnull) void (^handler)(NSArray<NSString *> *);
+@property (strong, nonatomic, nonnull) dispatch_source_t timer;
+// Binary min-heap ordered by deadline
+@property (strong, nonatomic, nonnull) NSMutableArray<OSDeadline *> *heap;
+@property (strong, nonatomic, nonnull) NSMutableSet<NSString *> *scheduledKeys;
+@end
+
+@implementation OSDeadlineScheduler {
+    BOOL _paused;
+}
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval
+                               clock:(OSDeadlineClock)clock
+                       callbackQueue:(dispatch_queue_t)callbackQueue
+                             handler:(void (^)(NSArray<NSString *> *))handler {
+    if (self = [super init]) {
+        _tickInterval = tickInterval;
+        _clock = clock ?: ^NSTimeInterval {
+            return NSProcessInfo.processInfo.systemUptime;
+        };
+        _callbackQueue = callbackQueue;
+        _handler = handler;
+        _heap = [NSMutableArray new];
+        _scheduledKeys = [NSMutableSet new];
+        _queue = dispatch_queue_create("com.onesignal.iam.deadlines", DISPATCH_QUEUE_SERIAL);
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+        __weak OSDeadlineScheduler *weakSelf = self;
+        dispatch_source_set_event_handler(_timer, ^{
+            [weakSelf fireExpiredDeadlinesOnQueue];
+        });
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(_timer);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_timer);
+}
+
+- (BOOL)isPaused {
+    __block BOOL paused;
+    dispatch_sync(self.queue, ^{
+        paused = self->_paused;
+    });
+    return paused;
+}
+
+- (void)setPaused:(BOOL)paused {
+    dispatch_sync(self.queue, ^{
+        self->_paused = paused;
+        // Deadlines that expired while paused are delivered now
+        if (!paused)
+            [self fireExpiredDeadlinesOnQueue];
+        else
+            [self rearmTimer];
+    });
+}
+
+- (NSUInteger)count {
+    __block NSUInteger count;
+    dispatch_sync(self.queue, ^{
+        count = self.heap.count;
+    });
+    return count;
+}
+
+- (BOOL)scheduleKey:(NSString *)key after:(NSTimeInterval)delay {
+    __block BOOL scheduled = NO;
+    dispatch_sync(self.queue, ^{
+        if ([self.scheduledKeys containsObject:key])
+            return;
+
+        let deadline = [OSDeadline new];
+        deadline.deadline = ceil((self.clock() + MAX(delay, 0)) / self.tickInterval) * self.tickInterval;
+        deadline.key = key;
+        [self.scheduledKeys addObject:key];
+        [self pushDeadline:deadline];
+        [self rearmTimer];
+        scheduled = YES;
+    });
+    return scheduled;
+}
+
+- (BOOL)hasDeadlineForKey:(NSString *)key {
+    __block BOOL scheduled;
+    dispatch_sync(self.queue, ^{
+        scheduled = [self.scheduledKeys containsObject:key];
+    });
+    return scheduled;
+}
+
+- (void)fireExpiredDeadlines {
+    dispatch_sync(self.queue, ^{
+        [self fireExpiredDeadlinesOnQueue];
+    });
+}
+
+#pragma mark Private, on the queue
+
+- (void)fireExpiredDeadlinesOnQueue {
+    if (_paused)
+        return;
+
+    let now = self.clock();
+    let expiredKeys = [NSMutableArray<NSString *> new];
+    while (self.heap.count > 0 && self.heap[0].deadline <= now) {
+        let deadline = [self popDeadline];
+        [self.scheduledKeys removeObject:deadline.key];
+        [expiredKeys addObject:deadline.key];
+    }
+    [self rearmTimer];
+
+    if (expiredKeys.count == 0)
+        return;
+    let handler = self.handler;
+    dispatch_async(self.callbackQueue, ^{
+        handler(expiredKeys);
+    });
+}
+
+- (void)rearmTimer {
+    if (_paused || self.heap.count == 0) {
+        dispatch_source_set_timer(self.timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        return;
+    }
+    let delay = MAX(self.heap[0].deadline - self.clock(), 0);
+    dispatch_source_set_timer(self.timer,
+                              dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                              DISPATCH_TIME_FOREVER,
+                              (uint64_t)(self.tickInterval * NSEC_PER_SEC / 10));
+}
+
+- (void)pushDeadline:(OSDeadline *)deadline {
+    [self.heap addObject:deadline];
+    var index = self.heap.count - 1;
+    while (index > 0) {
+        let parent = (index - 1) / 2;
+        if (self.heap[parent].deadline <= self.heap[index].deadline)
+            break;
+        [self.heap exchangeObjectAtIndex:parent withObjectAtIndex:index];
+        index = parent;
+    }
+}
+
+- (OSDeadline *)popDeadline {
+    let top = self.heap[0];
+    [self.heap exchangeObjectAtIndex:0 withObjectAtIndex:self.heap.count - 1];
+    [self.heap removeLastObject];
+
+    NSUInteger index = 0;
+    let count = self.heap.count;
+    while (true) {
+        let left = 2 * index + 1;
+        let right = left + 1;
+        var smallest = index;
+        if (left < count && self.heap[left].deadline < self.heap[smallest].deadline)
+            smallest = left;
+        if (right < count && self.heap[right].deadline < self.heap[smallest].deadline)
+            smallest = right;
+        if (smallest == index)
+            break;
+        [self.heap exchangeObjectAtIndex:index withObjectAtIndex:smallest];
+        index = smallest;
+    }
+    return top;
+}
+
+@end
@@ -27,12 +27,14 @@
 
 #import <Foundation/Foundation.h>
 #import "OSTrigger.h"
+#import "OSDeadlineScheduler.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @protocol OSDynamicTriggerControllerDelegate <NSObject>
 
-- (void)dynamicTriggerFired;
+// Called once on the main thread for all the trigger timers that ended in the same tick
+- (void)dynamicTriggersFired:(NSArray<NSString *> *)triggerIds;
 // Alerts the observer that a trigger evaluated to true
 - (void)dynamicTriggerCompleted:(NSString *)triggerId;
 
@@ -42,7 +44,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (weak, nonatomic, nullable) id<OSDynamicTriggerControllerDelegate> delegate;
 @property (nonatomic) NSDate *timeSinceLastMessage;
+// Holds the trigger timers that end while paused until resumed
+@property (nonatomic, getter=isPaused) BOOL paused;
 
+- (instancetype)initWithScheduler:(OSDeadlineScheduler * _Nullable)scheduler;
 - (BOOL)dynamicTriggerShouldFire:(OSTrigger *)trigger withMessageId:(NSString *)messageId;
 
 @end
@@ -36,88 +36,94 @@
 @interface OSDynamicTriggerController ()
 
 /*
- Maps messageId's to future scheduled time-based triggers
+ Schedules the future time-based triggers, keyed by triggerId
  For example, a message might conceivably have a session_duration trigger
  and an os_time trigger both scheduled for the future
 
- This dictionary prevents the SDK from scheduling multiple duplicate timers
- for the same messageId + trigger type
+ All triggers share one timer, and the scheduler prevents the SDK from
+ scheduling duplicate deadlines for the same trigger
  */
-@property (strong, nonatomic, nonnull) NSMutableSet<NSString *> *scheduledMessages;
+@property (strong, nonatomic, nonnull) OSDeadlineScheduler *scheduler;
 
 @end
 
 @implementation OSDynamicTriggerController
 
 - (instancetype)init {
+    return [self initWithScheduler:nil];
+}
+
+- (instancetype)initWithScheduler:(OSDeadlineScheduler *)scheduler {
     if (self = [super init]) {
-        self.scheduledMessages = [NSMutableSet new];
+        __weak OSDynamicTriggerController *weakSelf = self;
+        self.scheduler = scheduler ?: [[OSDeadlineScheduler alloc] initWithTickInterval:OS_DYNAMIC_TRIGGER_TICK_INTERVAL
+                                                                                  clock:nil
+                                                                          callbackQueue:dispatch_get_main_queue()
+                                                                                handler:^(NSArray<NSString *> *expiredKeys) {
+            [weakSelf timersFiredForTriggers:expiredKeys];
+        }];
         self.timeSinceLastMessage = [NSDate distantPast];
     }
     
     return self;
 }
 
+- (BOOL)isPaused {
+    return self.scheduler.isPaused;
+}
+
+- (void)setPaused:(BOOL)paused {
+    self.scheduler.paused = paused;
+}
+
 - (BOOL)dynamicTriggerShouldFire:(OSTrigger *)trigger withMessageId:(NSString *)messageId {
     if (!trigger.value)
         return false;
 
-    @synchronized (self.scheduledMessages) {
-        // All time-based trigger values should be numbers (either timestamps or offsets)
-        if (![trigger.value isKindOfClass:[NSNumber class]])
-            return false;
+    // All time-based trigger values should be numbers (either timestamps or offsets)
+    if (![trigger.value isKindOfClass:[NSNumber class]])
+        return false;
 
-        // Timer already set for this message trigger
-        if ([self.scheduledMessages containsObject:trigger.triggerId])
-            return false;
+    // Timer already set for this message trigger
+    if ([self.scheduler hasDeadlineForKey:trigger.triggerId])
+        return false;
 
-        let requiredTimeValue = [trigger.value doubleValue];
-
-        // How long to set the timer for (if needed)
-        var offset = 0.0f;
-
-        // Check what type of trigger it is
-        if ([trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_SESSION_TIME]) {
-            let currentDuration = fabs([[OSSessionManager.sharedSessionManager sessionLaunchTime] timeIntervalSinceNow]);
-            if ([self evaluateTimeInterval:requiredTimeValue withCurrentValue:currentDuration forOperator:trigger.operatorType]) {
-                [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"session time trigger completed: %@", trigger.triggerId]];
-                [self.delegate dynamicTriggerCompleted:trigger.triggerId];
-                //[self.delegate dynamicTriggerFired:trigger.triggerId];
-                return true;
-            }
-            offset = requiredTimeValue - currentDuration;
-        } else if ([trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_MIN_TIME_SINCE]) {
-
-            // Make sure no IAM are showng before handling "since_last_message" trigger kind
-            if (OSMessagingController.sharedInstance.isInAppMessageShowing)
-                return false;
-
-            let timestampSinceLastMessage = fabs([self.timeSinceLastMessage timeIntervalSinceNow]);
-
-            if ([self evaluateTimeInterval:requiredTimeValue withCurrentValue:timestampSinceLastMessage forOperator:trigger.operatorType]) {
-                [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"time since last inapp trigger completed: %@", trigger.triggerId]];
-                return true;
-            }
-            offset = requiredTimeValue - timestampSinceLastMessage;
+    let requiredTimeValue = [trigger.value doubleValue];
+
+    // How long to set the timer for (if needed)
+    var offset = 0.0f;
+
+    // Check what type of trigger it is
+    if ([trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_SESSION_TIME]) {
+        let currentDuration = fabs([[OSSessionManager.sharedSessionManager sessionLaunchTime] timeIntervalSinceNow]);
+        if ([self evaluateTimeInterval:requiredTimeValue withCurrentValue:currentDuration forOperator:trigger.operatorType]) {
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"session time trigger completed: %@", trigger.triggerId]];
+            [self.delegate dynamicTriggerCompleted:trigger.triggerId];
+            return true;
         }
+        offset = requiredTimeValue - currentDuration;
+    } else if ([trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_MIN_TIME_SINCE]) {
 
-        // Don't schedule timers for the past
-        if (offset <= 0.0f)
+        // Make sure no IAM are showng before handling "since_last_message" trigger kind
+        if (OSMessagingController.sharedInstance.isInAppMessageShowing)
             return false;
 
-        // If we reach this point, it means we need to return false and set up a timer for a future time
-        NSTimer *timer = [NSTimer timerWithTimeInterval:offset
-                                            target:self
-                                          selector:@selector(timerFiredForMessage:)
-                                          userInfo:@{@"trigger" : trigger}
-                                           repeats:false];
-        if (timer) {
-            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"timer added for triggerId: %@, messageId: %@", trigger.triggerId, messageId]];
-            [[NSRunLoop mainRunLoop] addTimer:timer forMode:NSRunLoopCommonModes];
-        }
+        let timestampSinceLastMessage = fabs([self.timeSinceLastMessage timeIntervalSinceNow]);
 
-        [self.scheduledMessages addObject:trigger.triggerId];
+        if ([self evaluateTimeInterval:requiredTimeValue withCurrentValue:timestampSinceLastMessage forOperator:trigger.operatorType]) {
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"time since last inapp trigger completed: %@", trigger.triggerId]];
+            return true;
+        }
+        offset = requiredTimeValue - timestampSinceLastMessage;
     }
+
+    // Don't schedule timers for the past
+    if (offset <= 0.0f)
+        return false;
+
+    // If we reach this point, it means we need to return false and set up a timer for a future time
+    if ([self.scheduler scheduleKey:trigger.triggerId after:offset])
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"timer added for triggerId: %@, messageId: %@", trigger.triggerId, messageId]];
     return false;
 }
 
@@ -145,14 +151,9 @@
     }
 }
 
-- (void)timerFiredForMessage:(NSTimer *)timer {
-    @synchronized (self.scheduledMessages) {
-        let trigger = (OSTrigger *)timer.userInfo[@"trigger"];
-
-        [self.scheduledMessages removeObject:trigger.triggerId];
-
-        [self.delegate dynamicTriggerFired];
-    }
+- (void)timersFiredForTriggers:(NSArray<NSString *> *)triggerIds {
+    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"timers fired for triggerIds: %@", triggerIds]];
+    [self.delegate dynamicTriggersFired:triggerIds];
 }
 
 @end
@@ -0,0 +1,101 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+#import <OneSignalCore/OneSignalCore.h>
+#import "OSInAppMessageClickResult.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, OSInAppMessageAnalyticsEventType) {
+    OSInAppMessageAnalyticsEventTypeImpression,
+    OSInAppMessageAnalyticsEventTypePageView,
+    OSInAppMessageAnalyticsEventTypeClick
+};
+
+// An impression, page view or click, with everything needed to send it after a restart
+@interface OSInAppMessageAnalyticsEvent : NSObject
+
+@property (nonatomic, readonly) OSInAppMessageAnalyticsEventType type;
+@property (strong, nonatomic, readonly) NSString *messageId;
+@property (strong, nonatomic, readonly) NSString *variantId;
+// The page id of a page view or the click id of a click, nil for impressions
+@property (strong, nonatomic, readonly, nullable) NSString *identifier;
+@property (nonatomic, readonly) BOOL firstClick;
+@property (strong, nonatomic, readonly) NSString *appId;
+@property (strong, nonatomic, readonly, nullable) NSString *subscriptionId;
+// Events with the same key are only queued once
+@property (strong, nonatomic, readonly) NSString *dedupKey;
+
++ (instancetype)impressionWithAppId:(NSString *)appId subscriptionId:(NSString * _Nullable)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId;
++ (instancetype)pageViewWithAppId:(NSString *)appId subscriptionId:(NSString * _Nullable)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId pageId:(NSString *)pageId;
++ (instancetype)clickWithAppId:(NSString *)appId subscriptionId:(NSString * _Nullable)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId action:(OSInAppMessageClickResult *)action;
+
+- (OneSignalRequest *)request;
+
+@end
+
+@class OSInAppMessageAnalyticsQueue;
+
+@protocol OSInAppMessageAnalyticsQueueDelegate <NSObject>
+// Called on the main queue
+- (void)analyticsQueue:(OSInAppMessageAnalyticsQueue *)queue didDeliverEvent:(OSInAppMessageAnalyticsEvent *)event NS_SWIFT_NAME(analyticsQueue(_:didDeliver:));
+// Called on the main queue when the server rejects an event, or it keeps failing, it is not retried
+- (void)analyticsQueue:(OSInAppMessageAnalyticsQueue *)queue didDropEvent:(OSInAppMessageAnalyticsEvent *)event NS_SWIFT_NAME(analyticsQueue(_:didDrop:));
+@end
+
+/**
+ A persisted queue of in-app message impressions, page views and clicks.
+ Events queued within a flush window are sent together, one at a time in queue order, so a multi-page
+ message does not produce a burst of concurrent requests. An event stays queued until the server accepts
+ or rejects it: retryable failures, including being offline, are retried with backoff and after a restart.
+ An event is dropped after `maxAttempts` failed responses from the server, or when it fails after being queued
+ for `maxEventAge`, so it cannot hold back the events behind it for good.
+ */
+@interface OSInAppMessageAnalyticsQueue : NSObject
+
++ (instancetype)sharedInstance;
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                         client:(id<IOneSignalClient>)client
+                  flushInterval:(NSTimeInterval)flushInterval
+                  maxRetryDelay:(NSTimeInterval)maxRetryDelay
+                    maxAttempts:(NSUInteger)maxAttempts
+                    maxEventAge:(NSTimeInterval)maxEventAge;
+
+@property (weak, nonatomic, nullable) id<OSInAppMessageAnalyticsQueueDelegate> delegate;
+@property (nonatomic, readonly) NSUInteger count;
+
+// Returns NO if an event with the same dedup key is already queued
+- (BOOL)enqueueEvent:(OSInAppMessageAnalyticsEvent *)event NS_SWIFT_NAME(enqueue(_:));
+// Sends the queued events without waiting for the flush window or retry delay
+- (void)flush;
+// Deletes the queued events from memory and disk, used by tests
+- (void)removeAllEvents;
+
+@end
+
+NS_ASSUME_NONNULL_END
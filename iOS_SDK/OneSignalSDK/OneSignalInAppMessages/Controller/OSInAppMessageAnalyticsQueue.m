@@ -0,0 +1,373 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <UIKit/UIKit.h>
+#import "OSInAppMessageAnalyticsQueue.h"
+#import "OSInAppMessagingDefines.h"
+#import "OSInAppMessagingRequests.h"
+#import "OSMacros.h"
+
+#define EVENT_TYPE @"type"
+#define EVENT_MESSAGE_ID @"message_id"
+#define EVENT_VARIANT_ID @"variant_id"
+#define EVENT_IDENTIFIER @"identifier"
+#define EVENT_FIRST_CLICK @"first_click"
+#define EVENT_APP_ID @"app_id"
+#define EVENT_SUBSCRIPTION_ID @"subscription_id"
+#define EVENT_QUEUED_AT @"queued_at"
+#define EVENT_ATTEMPTS @"attempts"
+
+@interface OSInAppMessageAnalyticsEvent ()
+@property (nonatomic, readwrite) OSInAppMessageAnalyticsEventType type;
+@property (strong, nonatomic, readwrite) NSString *messageId;
+@property (strong, nonatomic, readwrite) NSString *variantId;
+@property (strong, nonatomic, readwrite, nullable) NSString *identifier;
+@property (nonatomic, readwrite) BOOL firstClick;
+@property (strong, nonatomic, readwrite) NSString *appId;
+@property (strong, nonatomic, readwrite, nullable) NSString *subscriptionId;
+// Seconds since 1970 when the event was first queued
+@property (nonatomic) NSTimeInterval queuedAt;
+// Sends that failed with a retryable response from the server
+@property (nonatomic) NSUInteger attempts;
+@end
+
+@implementation OSInAppMessageAnalyticsEvent
+
++ (instancetype)eventWithType:(OSInAppMessageAnalyticsEventType)type appId:(NSString *)appId subscriptionId:(NSString *)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId identifier:(NSString *)identifier {
+    let event = [OSInAppMessageAnalyticsEvent new];
+    event.type = type;
+    event.appId = appId;
+    event.subscriptionId = subscriptionId;
+    event.messageId = messageId;
+    event.variantId = variantId;
+    event.identifier = identifier;
+    event.queuedAt = [[NSDate date] timeIntervalSince1970];
+    return event;
+}
+
++ (instancetype)impressionWithAppId:(NSString *)appId subscriptionId:(NSString *)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId {
+    return [self eventWithType:OSInAppMessageAnalyticsEventTypeImpression appId:appId subscriptionId:subscriptionId messageId:messageId variantId:variantId identifier:nil];
+}
+
++ (instancetype)pageViewWithAppId:(NSString *)appId subscriptionId:(NSString *)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId pageId:(NSString *)pageId {
+    return [self eventWithType:OSInAppMessageAnalyticsEventTypePageView appId:appId subscriptionId:subscriptionId messageId:messageId variantId:variantId identifier:pageId];
+}
+
++ (instancetype)clickWithAppId:(NSString *)appId subscriptionId:(NSString *)subscriptionId messageId:(NSString *)messageId variantId:(NSString *)variantId action:(OSInAppMessageClickResult *)action {
+    let event = [self eventWithType:OSInAppMessageAnalyticsEventTypeClick appId:appId subscriptionId:subscriptionId messageId:messageId variantId:variantId identifier:action.clickId];
+    event.firstClick = action.firstClick;
+    return event;
+}
+
++ (instancetype)eventWithDictionary:(NSDictionary *)dictionary {
+    NSNumber *type = dictionary[EVENT_TYPE];
+    NSString *appId = dictionary[EVENT_APP_ID];
+    NSString *messageId = dictionary[EVENT_MESSAGE_ID];
+    NSString *variantId = dictionary[EVENT_VARIANT_ID];
+    if (![type isKindOfClass:[NSNumber class]] || type.unsignedIntegerValue > OSInAppMessageAnalyticsEventTypeClick ||
+        ![appId isKindOfClass:[NSString class]] || ![messageId isKindOfClass:[NSString class]] || ![variantId isKindOfClass:[NSString class]])
+        return nil;
+
+    let event = [self eventWithType:type.unsignedIntegerValue appId:appId subscriptionId:dictionary[EVENT_SUBSCRIPTION_ID] messageId:messageId variantId:variantId identifier:dictionary[EVENT_IDENTIFIER]];
+    event.firstClick = [dictionary[EVENT_FIRST_CLICK] boolValue];
+    // Events saved before these were tracked count from when they are loaded
+    if ([dictionary[EVENT_QUEUED_AT] isKindOfClass:[NSNumber class]])
+        event.queuedAt = [dictionary[EVENT_QUEUED_AT] doubleValue];
+    if ([dictionary[EVENT_ATTEMPTS] isKindOfClass:[NSNumber class]])
+        event.attempts = [dictionary[EVENT_ATTEMPTS] unsignedIntegerValue];
+    return event;
+}
+
+- (NSDictionary *)dictionary {
+    let dictionary = [NSMutableDictionary new];
+    dictionary[EVENT_TYPE] = @(self.type);
+    dictionary[EVENT_APP_ID] = self.appId;
+    dictionary[EVENT_SUBSCRIPTION_ID] = self.subscriptionId;
+    dictionary[EVENT_MESSAGE_ID] = self.messageId;
+    dictionary[EVENT_VARIANT_ID] = self.variantId;
+    dictionary[EVENT_IDENTIFIER] = self.identifier;
+    dictionary[EVENT_FIRST_CLICK] = @(self.firstClick);
+    dictionary[EVENT_QUEUED_AT] = @(self.queuedAt);
+    dictionary[EVENT_ATTEMPTS] = @(self.attempts);
+    return dictionary;
+}
+
+- (NSString *)dedupKey {
+    return [NSString stringWithFormat:@"%lu|%@|%@", (unsigned long)self.type, self.messageId, self.identifier ?: @""];
+}
+
+- (OneSignalRequest *)request {
+    switch (self.type) {
+        case OSInAppMessageAnalyticsEventTypeImpression:
+            return [OSRequestInAppMessageViewed withAppId:self.appId
+                                             withPlayerId:self.subscriptionId
+                                            withMessageId:self.messageId
+                                             forVariantId:self.variantId];
+        case OSInAppMessageAnalyticsEventTypePageView:
+            return [OSRequestInAppMessagePageViewed withAppId:self.appId
+                                                 withPlayerId:self.subscriptionId
+                                                withMessageId:self.messageId
+                                                   withPageId:self.identifier
+                                                 forVariantId:self.variantId];
+        case OSInAppMessageAnalyticsEventTypeClick:
+            return [OSRequestInAppMessageClicked withAppId:self.appId
+                                              withPlayerId:self.subscriptionId
+                                             withMessageId:self.messageId
+                                              forVariantId:self.variantId
+                                               withClickId:self.identifier
+                                                firstClick:self.firstClick];
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<OSInAppMessageAnalyticsEvent %@>", self.dedupKey];
+}
+
+@end
+
+@interface OSInAppMessageAnalyticsQueue ()
+@property (strong, nonatomic, readonly) NSURL *fileURL;
+@property (strong, nonatomic, readonly) id<IOneSignalClient> client;
+@property (nonatomic, readonly) NSTimeInterval flushInterval;
+@property (nonatomic, readonly) NSUInteger maxAttempts;
+@property (nonatomic, readonly) NSTimeInterval maxEventAge;
+@property (strong, nonatomic, readonly) OSRequestRetryPolicy *retryPolicy;
+@end
+
+@implementation OSInAppMessageAnalyticsQueue {
+    dispatch_queue_t _queue;
+    // Accessed on _queue only
+    NSMutableArray<OSInAppMessageAnalyticsEvent *> *_events;
+    BOOL _sending;
+    BOOL _flushScheduled;
+    NSTimeInterval _lastRetryDelay;
+}
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageAnalyticsQueue *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSURL *applicationSupport = [NSFileManager.defaultManager URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask].firstObject;
+        NSURL *directory = [applicationSupport URLByAppendingPathComponent:OS_IAM_STATE_DIRECTORY isDirectory:true];
+        sharedInstance = [[OSInAppMessageAnalyticsQueue alloc] initWithFileURL:[directory URLByAppendingPathComponent:OS_IAM_ANALYTICS_QUEUE_FILE]
+                                                                        client:OneSignalCoreImpl.sharedClient
+                                                                 flushInterval:OS_IAM_ANALYTICS_FLUSH_INTERVAL
+                                                                 maxRetryDelay:OS_IAM_ANALYTICS_MAX_RETRY_DELAY
+                                                                   maxAttempts:OS_IAM_ANALYTICS_MAX_ATTEMPTS
+                                                                   maxEventAge:OS_IAM_ANALYTICS_MAX_EVENT_AGE];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL client:(id<IOneSignalClient>)client flushInterval:(NSTimeInterval)flushInterval maxRetryDelay:(NSTimeInterval)maxRetryDelay maxAttempts:(NSUInteger)maxAttempts maxEventAge:(NSTimeInterval)maxEventAge {
+    if (self = [super init]) {
+        _fileURL = fileURL;
+        _client = client;
+        _flushInterval = flushInterval;
+        _maxAttempts = MAX(maxAttempts, 1);
+        _maxEventAge = maxEventAge;
+        // Only the backoff is used, the client already has a circuit breaker per host
+        _retryPolicy = [[OSRequestRetryPolicy alloc] initWithBaseDelay:MAX(flushInterval, 0.001)
+                                                              maxDelay:maxRetryDelay
+                                                      failureThreshold:NSUIntegerMax
+                                                          openInterval:0];
+        _queue = dispatch_queue_create("com.onesignal.inAppMessageAnalyticsQueue", DISPATCH_QUEUE_SERIAL);
+        _events = [NSMutableArray new];
+
+        // Queued first, so every other call sees the loaded events
+        dispatch_async(_queue, ^{
+            [self loadOnQueue];
+            if (self->_events.count > 0)
+                [self scheduleFlushAfter:self.flushInterval];
+        });
+
+        // The app may not run again for a while, send what is queued while it still can
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(flush)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark Public Methods
+
+- (NSUInteger)count {
+    __block NSUInteger count;
+    dispatch_sync(_queue, ^{
+        count = self->_events.count;
+    });
+    return count;
+}
+
+- (BOOL)enqueueEvent:(OSInAppMessageAnalyticsEvent *)event {
+    __block BOOL enqueued = NO;
+    dispatch_sync(_queue, ^{
+        let dedupKey = event.dedupKey;
+        for (OSInAppMessageAnalyticsEvent *queued in self->_events) {
+            if ([queued.dedupKey isEqualToString:dedupKey])
+                return;
+        }
+        [self->_events addObject:event];
+        enqueued = YES;
+    });
+    if (!enqueued) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"In-app message analytics event already queued: %@", event]];
+        return NO;
+    }
+
+    dispatch_async(_queue, ^{
+        [self saveOnQueue];
+        [self scheduleFlushAfter:self.flushInterval];
+    });
+    return YES;
+}
+
+- (void)flush {
+    dispatch_async(_queue, ^{
+        [self sendNextEventOnQueue];
+    });
+}
+
+- (void)removeAllEvents {
+    dispatch_sync(_queue, ^{
+        [self->_events removeAllObjects];
+        self->_lastRetryDelay = 0;
+        [NSFileManager.defaultManager removeItemAtURL:self.fileURL error:nil];
+    });
+}
+
+#pragma mark Private Methods, on _queue
+
+- (void)scheduleFlushAfter:(NSTimeInterval)delay {
+    if (_flushScheduled)
+        return;
+    _flushScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, ^{
+        self->_flushScheduled = NO;
+        [self sendNextEventOnQueue];
+    });
+}
+
+/*
+ Sends the event at the head of the queue, and the next one once it completes, until the queue is empty
+ Sending one at a time keeps the server receiving events in the order they happened
+ */
+- (void)sendNextEventOnQueue {
+    if (_sending || _events.count == 0)
+        return;
+    _sending = YES;
+
+    let event = _events.firstObject;
+    [self.client executeRequest:[event request] onSuccess:^(NSDictionary *result) {
+        dispatch_async(self->_queue, ^{
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Sent in-app message analytics event: %@", event]];
+            self->_lastRetryDelay = 0;
+            [self completeEvent:event delivered:YES];
+        });
+    } onFailure:^(OneSignalClientError *error) {
+        dispatch_async(self->_queue, ^{
+            if ([OSNetworkingUtils getResponseStatusType:error.code] != OSResponseStatusRetryable) {
+                [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Dropping in-app message analytics event %@ rejected with error: %@", event, error.message]];
+                [self completeEvent:event delivered:NO];
+                return;
+            }
+
+            // Being offline (code 0) does not count as an attempt, only the event's age limits it then
+            if (error.code != 0)
+                event.attempts++;
+            let age = [[NSDate date] timeIntervalSince1970] - event.queuedAt;
+            if (event.attempts >= self.maxAttempts || age >= self.maxEventAge) {
+                [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Dropping in-app message analytics event %@ after %lu failed attempts over %.0f seconds, last error: %@", event, (unsigned long)event.attempts, age, error.message]];
+                self->_lastRetryDelay = 0;
+                [self completeEvent:event delivered:NO];
+                return;
+            }
+
+            // Keep the event at the head of the queue so later events are not sent before it
+            [self saveOnQueue];
+            self->_sending = NO;
+            self->_lastRetryDelay = [self.retryPolicy delayAfterDelay:self->_lastRetryDelay retryAfter:error.responseHeaders[@"Retry-After"]];
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"Retrying in-app message analytics event %@ in %.3f seconds after error: %@", event, self->_lastRetryDelay, error.message]];
+            [self scheduleFlushAfter:self->_lastRetryDelay];
+        });
+    }];
+}
+
+- (void)completeEvent:(OSInAppMessageAnalyticsEvent *)event delivered:(BOOL)delivered {
+    _sending = NO;
+    // The queue may have been cleared while the event was being sent
+    if ([_events indexOfObjectIdenticalTo:event] != NSNotFound) {
+        [_events removeObjectIdenticalTo:event];
+        [self saveOnQueue];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (delivered)
+                [self.delegate analyticsQueue:self didDeliverEvent:event];
+            else
+                [self.delegate analyticsQueue:self didDropEvent:event];
+        });
+    }
+    [self sendNextEventOnQueue];
+}
+
+- (void)loadOnQueue {
+    let data = [NSData dataWithContentsOfURL:self.fileURL];
+    if (!data)
+        return;
+    NSArray *dictionaries = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil];
+    if (![dictionaries isKindOfClass:[NSArray class]])
+        return;
+    for (NSDictionary *dictionary in dictionaries) {
+        if (![dictionary isKindOfClass:[NSDictionary class]])
+            continue;
+        let event = [OSInAppMessageAnalyticsEvent eventWithDictionary:dictionary];
+        if (event)
+            [_events addObject:event];
+    }
+}
+
+- (void)saveOnQueue {
+    if (_events.count == 0) {
+        [NSFileManager.defaultManager removeItemAtURL:self.fileURL error:nil];
+        return;
+    }
+    let dictionaries = [NSMutableArray new];
+    for (OSInAppMessageAnalyticsEvent *event in _events)
+        [dictionaries addObject:[event dictionary]];
+
+    NSError *error;
+    let data = [NSPropertyListSerialization dataWithPropertyList:dictionaries format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    [NSFileManager.defaultManager createDirectoryAtURL:self.fileURL.URLByDeletingLastPathComponent withIntermediateDirectories:true attributes:nil error:nil];
+    if (!data || ![data writeToURL:self.fileURL options:NSDataWritingAtomic error:&error])
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to save in-app message analytics events: %@", error]];
+}
+
+@end
@@ -0,0 +1,57 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A size bounded on-disk cache of in-app message content responses, keyed by message and variant.
+ Entries keep the ETag they were served with so they can be revalidated, and the least recently used are evicted first.
+ */
+@interface OSInAppMessageContentCache : NSObject
+
++ (instancetype)sharedInstance;
+- (instancetype)initWithDirectory:(NSURL *)directory maxBytes:(NSUInteger)maxBytes;
+
+@property (nonatomic, readonly) NSUInteger totalBytes;
+// How long after a read the index is persisted, unless a write persists it sooner. Replaceable in tests.
+@property (nonatomic) NSTimeInterval indexSaveDelay;
+
+// Reads the content from disk and marks it as recently used. The last access time is persisted later, off the calling thread.
+- (NSDictionary * _Nullable)contentForMessageId:(NSString *)messageId variantId:(NSString *)variantId;
+- (NSString * _Nullable)etagForMessageId:(NSString *)messageId variantId:(NSString *)variantId;
+- (void)storeContent:(NSData *)data etag:(NSString * _Nullable)etag forMessageId:(NSString *)messageId variantId:(NSString *)variantId;
+- (void)removeContentForMessageId:(NSString *)messageId variantId:(NSString *)variantId;
+// Removes the content of messages that are no longer in the app's message list
+- (void)removeContentForMessagesNotIn:(NSSet<NSString *> *)messageIds;
+- (void)removeAllContent;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,233 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSInAppMessageContentCache.h"
+#import <OneSignalCore/OneSignalCore.h>
+#import "OSInAppMessagingDefines.h"
+
+static NSString * const INDEX_FILE_NAME = @"index.plist";
+static NSString * const ENTRY_MESSAGE_ID = @"message_id";
+static NSString * const ENTRY_FILE_NAME = @"file";
+static NSString * const ENTRY_ETAG = @"etag";
+static NSString * const ENTRY_SIZE = @"size";
+static NSString * const ENTRY_LAST_ACCESS = @"last_access";
+
+@implementation OSInAppMessageContentCache {
+    NSURL *_directory;
+    NSUInteger _maxBytes;
+    dispatch_queue_t _queue;
+    // Accessed on _queue only, entries keyed by "<messageId>/<variantId>"
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *_entries;
+    // Accessed on _queue only, whether a read changed the index since it was last saved
+    BOOL _indexSaveScheduled;
+}
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageContentCache *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSURL *caches = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedInstance = [[OSInAppMessageContentCache alloc] initWithDirectory:[caches URLByAppendingPathComponent:OS_IAM_CONTENT_CACHE_DIRECTORY isDirectory:true]
+                                                                      maxBytes:OS_IAM_CONTENT_CACHE_MAX_BYTES];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithDirectory:(NSURL *)directory maxBytes:(NSUInteger)maxBytes {
+    if (self = [super init]) {
+        _directory = directory;
+        _maxBytes = maxBytes;
+        _queue = dispatch_queue_create("com.onesignal.inAppMessageContentCache", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary new];
+        _indexSaveDelay = OS_IAM_CONTENT_CACHE_INDEX_SAVE_DELAY_SECONDS;
+
+        NSDictionary *index = [NSDictionary dictionaryWithContentsOfURL:[directory URLByAppendingPathComponent:INDEX_FILE_NAME]];
+        for (NSString *key in index) {
+            if ([index[key] isKindOfClass:[NSDictionary class]])
+                _entries[key] = [index[key] mutableCopy];
+        }
+    }
+    return self;
+}
+
+- (NSString *)keyForMessageId:(NSString *)messageId variantId:(NSString *)variantId {
+    return [NSString stringWithFormat:@"%@/%@", messageId, variantId];
+}
+
+- (NSURL *)fileURLForEntry:(NSDictionary *)entry {
+    return [_directory URLByAppendingPathComponent:entry[ENTRY_FILE_NAME] isDirectory:false];
+}
+
+- (NSUInteger)totalBytes {
+    __block NSUInteger total = 0;
+    dispatch_sync(_queue, ^{
+        total = [self totalBytesOnQueue];
+    });
+    return total;
+}
+
+- (NSUInteger)totalBytesOnQueue {
+    NSUInteger total = 0;
+    for (NSDictionary *entry in _entries.allValues) {
+        total += [entry[ENTRY_SIZE] unsignedIntegerValue];
+    }
+    return total;
+}
+
+- (NSDictionary *)contentForMessageId:(NSString *)messageId variantId:(NSString *)variantId {
+    NSString *key = [self keyForMessageId:messageId variantId:variantId];
+    __block NSURL *fileURL;
+    dispatch_sync(_queue, ^{
+        NSMutableDictionary *entry = self->_entries[key];
+        if (!entry)
+            return;
+        fileURL = [self fileURLForEntry:entry];
+        // Only in memory, this is called on the main thread when a message is displayed
+        entry[ENTRY_LAST_ACCESS] = @([[NSDate date] timeIntervalSince1970]);
+        [self scheduleIndexSaveOnQueue];
+    });
+    if (!fileURL)
+        return nil;
+
+    NSData *data = [NSData dataWithContentsOfURL:fileURL];
+    NSDictionary *content = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+    if (![content isKindOfClass:[NSDictionary class]]) {
+        [OneSignalLog onesignalLog:ONE_S_LL_WARN message:[NSString stringWithFormat:@"Discarding unreadable cached in-app message content for %@", key]];
+        [self removeContentForMessageId:messageId variantId:variantId];
+        return nil;
+    }
+    return content;
+}
+
+- (NSString *)etagForMessageId:(NSString *)messageId variantId:(NSString *)variantId {
+    NSString *key = [self keyForMessageId:messageId variantId:variantId];
+    __block NSString *etag;
+    dispatch_sync(_queue, ^{
+        etag = self->_entries[key][ENTRY_ETAG];
+    });
+    return etag;
+}
+
+- (void)storeContent:(NSData *)data etag:(NSString *)etag forMessageId:(NSString *)messageId variantId:(NSString *)variantId {
+    if (data.length > _maxBytes) {
+        return;
+    }
+    NSString *key = [self keyForMessageId:messageId variantId:variantId];
+    dispatch_sync(_queue, ^{
+        [NSFileManager.defaultManager createDirectoryAtURL:self->_directory withIntermediateDirectories:true attributes:nil error:nil];
+        NSMutableDictionary *entry = [NSMutableDictionary new];
+        // Message and variant IDs are not guaranteed to be safe file names
+        entry[ENTRY_FILE_NAME] = [NSString stringWithFormat:@"%@.json", NSUUID.UUID.UUIDString];
+        entry[ENTRY_MESSAGE_ID] = messageId;
+        entry[ENTRY_SIZE] = @(data.length);
+        entry[ENTRY_LAST_ACCESS] = @([[NSDate date] timeIntervalSince1970]);
+        entry[ENTRY_ETAG] = etag;
+
+        NSError *error;
+        if (![data writeToURL:[self fileURLForEntry:entry] options:NSDataWritingAtomic error:&error]) {
+            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to cache in-app message content for %@: %@", key, error]];
+            return;
+        }
+        [self removeEntryOnQueueForKey:key];
+        self->_entries[key] = entry;
+        [self evictOnQueue];
+        [self saveIndex];
+    });
+}
+
+- (void)removeContentForMessageId:(NSString *)messageId variantId:(NSString *)variantId {
+    NSString *key = [self keyForMessageId:messageId variantId:variantId];
+    dispatch_sync(_queue, ^{
+        [self removeEntryOnQueueForKey:key];
+        [self saveIndex];
+    });
+}
+
+- (void)removeContentForMessagesNotIn:(NSSet<NSString *> *)messageIds {
+    dispatch_sync(_queue, ^{
+        for (NSString *key in self->_entries.allKeys) {
+            if (![messageIds containsObject:self->_entries[key][ENTRY_MESSAGE_ID]])
+                [self removeEntryOnQueueForKey:key];
+        }
+        [self saveIndex];
+    });
+}
+
+- (void)removeAllContent {
+    dispatch_sync(_queue, ^{
+        [self->_entries removeAllObjects];
+        self->_indexSaveScheduled = false;
+        [NSFileManager.defaultManager removeItemAtURL:self->_directory error:nil];
+    });
+}
+
+- (void)removeEntryOnQueueForKey:(NSString *)key {
+    NSDictionary *entry = _entries[key];
+    if (!entry)
+        return;
+    [NSFileManager.defaultManager removeItemAtURL:[self fileURLForEntry:entry] error:nil];
+    [_entries removeObjectForKey:key];
+}
+
+// Removes the least recently used entries until the cache fits in its size limit
+- (void)evictOnQueue {
+    NSUInteger total = [self totalBytesOnQueue];
+    if (total <= _maxBytes)
+        return;
+    NSArray *keys = [_entries keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        return [a[ENTRY_LAST_ACCESS] compare:b[ENTRY_LAST_ACCESS]];
+    }];
+    for (NSString *key in keys) {
+        if (total <= _maxBytes)
+            break;
+        total -= [_entries[key][ENTRY_SIZE] unsignedIntegerValue];
+        [self removeEntryOnQueueForKey:key];
+    }
+}
+
+// Saves the index after `indexSaveDelay`, unless a write saves it first
+- (void)scheduleIndexSaveOnQueue {
+    if (_indexSaveScheduled)
+        return;
+    _indexSaveScheduled = true;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.indexSaveDelay * NSEC_PER_SEC)), _queue, ^{
+        if (self->_indexSaveScheduled)
+            [self saveIndex];
+    });
+}
+
+- (void)saveIndex {
+    _indexSaveScheduled = false;
+    if (_entries.count == 0) {
+        [NSFileManager.defaultManager removeItemAtURL:[_directory URLByAppendingPathComponent:INDEX_FILE_NAME] error:nil];
+        return;
+    }
+    [_entries writeToURL:[_directory URLByAppendingPathComponent:INDEX_FILE_NAME] atomically:true];
+}
+
+@end
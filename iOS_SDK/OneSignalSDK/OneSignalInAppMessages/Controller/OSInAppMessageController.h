@@ -34,6 +34,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface OSInAppMessageInternal (OSInAppMessageController)
 
 - (void)loadMessageHTMLContentWithResult:(OSResultSuccessBlock _Nullable)successBlock failure:(OSFailureBlock _Nullable)failureBlock;
+// Fetches the content into OSInAppMessageContentCache, revalidating it if it is already cached
+- (void)prefetchMessageHTMLContent;
 - (void)loadPreviewMessageHTMLContentWithUUID:(NSString * _Nonnull)previewUUID success:(OSResultSuccessBlock _Nullable)successBlock failure:(OSFailureBlock _Nullable)failureBlock;
 
 - (NSString * _Nullable)variantId;
@@ -32,6 +32,7 @@
 #import <OneSignalUser/OneSignalUser.h>
 #import "OSInAppMessagingDefines.h"
 #import "OSInAppMessagingRequests.h"
+#import "OSInAppMessageContentCache.h"
 
 
 @implementation OSInAppMessageInternal (OSInAppMessageController)
@@ -46,10 +47,62 @@
         return;
     }
     
-    let request = [OSRequestLoadInAppMessageContent withAppId:OneSignalIdentifiers.currentAppId withMessageId:self.messageId withVariantId:variantId];
+    // Liquid content is personalized when it is requested, so it is not cached
+    if (!self.hasLiquid) {
+        NSDictionary *cachedContent = [OSInAppMessageContentCache.sharedInstance contentForMessageId:self.messageId variantId:variantId];
+        if (cachedContent) {
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Loaded in-app message content from cache for message ID: %@", self.messageId]];
+            // Cached content is shown as is, without waiting for the server. Revalidating only updates what the next display shows.
+            if (successBlock)
+                successBlock(cachedContent);
+            [self fetchMessageHTMLContentForVariantId:variantId result:nil failure:nil];
+            return;
+        }
+    }
     
-    [OneSignalCoreImpl.sharedClient executeRequest:request onSuccess:successBlock onFailure:^(OneSignalClientError *error) {
-        failureBlock(error.underlyingError);
+    [self fetchMessageHTMLContentForVariantId:variantId result:successBlock failure:failureBlock];
+}
+
+- (void)prefetchMessageHTMLContent {
+    let variantId = [self variantId];
+    if (!variantId || self.hasLiquid || self.isPreview)
+        return;
+    
+    [self fetchMessageHTMLContentForVariantId:variantId result:nil failure:nil];
+}
+
+- (void)fetchMessageHTMLContentForVariantId:(NSString *)variantId result:(OSResultSuccessBlock _Nullable)successBlock failure:(OSFailureBlock _Nullable)failureBlock {
+    let cache = OSInAppMessageContentCache.sharedInstance;
+    let cacheable = !self.hasLiquid;
+    let messageId = self.messageId;
+    NSString *etag = cacheable ? [cache etagForMessageId:messageId variantId:variantId] : nil;
+    let request = [OSRequestLoadInAppMessageContent withAppId:OneSignalIdentifiers.currentAppId withMessageId:messageId withVariantId:variantId ifNoneMatch:etag];
+    
+    [OneSignalCoreImpl.sharedClient executeRequest:request onResponse:^(OSHTTPResponse *response) {
+        NSDictionary *content = response.JSONObject;
+        if (response.JSONError || (content && ![content isKindOfClass:[NSDictionary class]])) {
+            if (failureBlock)
+                failureBlock(response.JSONError);
+            return;
+        }
+        if (cacheable && content && response.data.length > 0)
+            [cache storeContent:response.data etag:[response valueForHeader:@"ETag"] forMessageId:messageId variantId:variantId];
+        if (successBlock)
+            successBlock(content);
+    } onFailure:^(OneSignalClientError *error) {
+        if (error.code == 304) {
+            // Still current, reading it also marks it as recently used
+            NSDictionary *cachedContent = [cache contentForMessageId:messageId variantId:variantId];
+            if (cachedContent) {
+                if (successBlock)
+                    successBlock(cachedContent);
+                return;
+            }
+        } else if (error.code == 404 || error.code == 410) {
+            [cache removeContentForMessageId:messageId variantId:variantId];
+        }
+        if (failureBlock)
+            failureBlock(error.underlyingError);
     }];
 }
 
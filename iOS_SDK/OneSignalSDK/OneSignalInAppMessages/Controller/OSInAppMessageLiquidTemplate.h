@@ -0,0 +1,70 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Liquid markup of an in-app message parsed once, so tag values can be substituted natively before the HTML is loaded.
+ Only output markup outside of scripts and styles is rendered, `{{ key }}` and `{{ key | default: "text" }}`.
+ Any other liquid makes the template not natively renderable, and the message's own script renders it instead.
+ */
+@interface OSInAppMessageLiquidTemplate : NSObject
+
++ (instancetype)templateWithHTML:(NSString *)html;
+
+@property (nonatomic, readonly) NSString *html;
+// False if the HTML has no output markup, or markup the native pass does not cover
+@property (nonatomic, readonly) BOOL isNativelyRenderable;
+// The tag keys the template references
+@property (nonatomic, readonly) NSSet<NSString *> *tagKeys;
+
+// Returns nil if the template is not natively renderable, substituted values are HTML escaped
+- (NSString * _Nullable)renderWithTags:(NSDictionary<NSString *, id> * _Nullable)tags;
+
+@end
+
+/**
+ Renders liquid in-app messages on a background queue, keeping the parsed template of recently displayed variants.
+ */
+@interface OSInAppMessageLiquidRenderer : NSObject
+
++ (instancetype)sharedInstance;
+
+// Calls completion on the main queue, with nil if the template is not natively renderable
+// Templates are only kept when a variant ID is given, preview messages are parsed every time
+- (void)renderHTML:(NSString *)html
+         messageId:(NSString *)messageId
+         variantId:(NSString * _Nullable)variantId
+              tags:(NSDictionary<NSString *, id> * _Nullable)tags
+        completion:(void (^)(NSString * _Nullable renderedHTML))completion;
+- (void)removeAllTemplates;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,259 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import "OSInAppMessageLiquidTemplate.h"
+#import "OSMacros.h"
+#import "OSInAppMessagingDefines.h"
+
+static NSString * const LIQUID_OUTPUT_START = @"{{";
+static NSString * const LIQUID_OUTPUT_END = @"}}";
+static NSString * const LIQUID_TAG_START = @"{%";
+static NSString * const LIQUID_DEFAULT_FILTER = @"default";
+
+// A `{{ key }}` in the template, with the value of its default filter if it has one
+@interface OSInAppMessageLiquidOutput : NSObject
+@property (strong, nonatomic, nonnull) NSString *key;
+@property (strong, nonatomic, nullable) NSString *defaultValue;
+@end
+
+@implementation OSInAppMessageLiquidOutput
+@end
+
+@interface OSInAppMessageLiquidTemplate ()
+@property (strong, nonatomic, readwrite) NSString *html;
+@property (nonatomic, readwrite) BOOL isNativelyRenderable;
+@property (strong, nonatomic, readwrite) NSSet<NSString *> *tagKeys;
+// Literal NSStrings and OSInAppMessageLiquidOutputs in template order
+@property (strong, nonatomic) NSArray *segments;
+@end
+
+@implementation OSInAppMessageLiquidTemplate
+
++ (instancetype)templateWithHTML:(NSString *)html {
+    let template = [OSInAppMessageLiquidTemplate new];
+    template.html = html;
+    NSMutableArray *segments = [NSMutableArray new];
+    NSMutableSet<NSString *> *tagKeys = [NSMutableSet new];
+    template.isNativelyRenderable = [self parseHTML:html segments:segments tagKeys:tagKeys] && tagKeys.count > 0;
+    template.segments = template.isNativelyRenderable ? segments : @[];
+    template.tagKeys = template.isNativelyRenderable ? tagKeys : [NSSet set];
+    return template;
+}
+
++ (NSRange)rangeOfString:(NSString *)string inHTML:(NSString *)html from:(NSUInteger)location options:(NSStringCompareOptions)options {
+    return [html rangeOfString:string options:options | NSLiteralSearch range:NSMakeRange(location, html.length - location)];
+}
+
+/*
+ Splits the HTML into literal text and output markup in a single pass
+ Scripts and styles are copied as they are, the message's own script may contain liquid delimiters
+ */
++ (BOOL)parseHTML:(NSString *)html segments:(NSMutableArray *)segments tagKeys:(NSMutableSet<NSString *> *)tagKeys {
+    let length = html.length;
+    NSUInteger literalStart = 0;
+    NSUInteger position = 0;
+    // The next occurrence of each marker is only searched for again once the scan has passed it
+    NSRange output = NSMakeRange(0, 0), tag = NSMakeRange(0, 0), script = NSMakeRange(0, 0), style = NSMakeRange(0, 0);
+    BOOL searched = NO;
+    while (position < length) {
+        if (!searched || (output.location != NSNotFound && output.location < position))
+            output = [self rangeOfString:LIQUID_OUTPUT_START inHTML:html from:position options:0];
+        if (!searched || (tag.location != NSNotFound && tag.location < position))
+            tag = [self rangeOfString:LIQUID_TAG_START inHTML:html from:position options:0];
+        if (!searched || (script.location != NSNotFound && script.location < position))
+            script = [self rangeOfString:@"<script" inHTML:html from:position options:NSCaseInsensitiveSearch];
+        if (!searched || (style.location != NSNotFound && style.location < position))
+            style = [self rangeOfString:@"<style" inHTML:html from:position options:NSCaseInsensitiveSearch];
+        searched = YES;
+
+        let next = MIN(MIN(output.location, tag.location), MIN(script.location, style.location));
+        if (next == NSNotFound)
+            break;
+
+        if (next == script.location || next == style.location) {
+            let closingTag = next == script.location ? @"</script" : @"</style";
+            let closing = [self rangeOfString:closingTag inHTML:html from:next + 1 options:NSCaseInsensitiveSearch];
+            position = closing.location == NSNotFound ? length : NSMaxRange(closing);
+            continue;
+        }
+
+        // Control flow tags are left to the message's script
+        if (next == tag.location)
+            return NO;
+
+        let end = [self rangeOfString:LIQUID_OUTPUT_END inHTML:html from:NSMaxRange(output) options:0];
+        if (end.location == NSNotFound)
+            return NO;
+        let expression = [html substringWithRange:NSMakeRange(NSMaxRange(output), end.location - NSMaxRange(output))];
+        let liquidOutput = [self outputWithExpression:expression];
+        if (!liquidOutput)
+            return NO;
+
+        if (output.location > literalStart)
+            [segments addObject:[html substringWithRange:NSMakeRange(literalStart, output.location - literalStart)]];
+        [segments addObject:liquidOutput];
+        [tagKeys addObject:liquidOutput.key];
+        literalStart = position = NSMaxRange(end);
+    }
+    if (literalStart < length)
+        [segments addObject:[html substringFromIndex:literalStart]];
+    return YES;
+}
+
+// Parses `key` or `key | default: "text"`, returns nil for anything else
++ (OSInAppMessageLiquidOutput *)outputWithExpression:(NSString *)expression {
+    static NSCharacterSet *keyCharacters;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSMutableCharacterSet *characters = [NSMutableCharacterSet alphanumericCharacterSet];
+        [characters addCharactersInString:@"_-"];
+        keyCharacters = characters;
+    });
+
+    let whitespace = NSCharacterSet.whitespaceAndNewlineCharacterSet;
+    let scanner = [NSScanner scannerWithString:expression];
+    scanner.charactersToBeSkipped = whitespace;
+
+    NSString *key;
+    // A leading "-" is whitespace control, which is not rendered natively
+    if (![scanner scanCharactersFromSet:keyCharacters intoString:&key] || [key hasPrefix:@"-"] || [key hasSuffix:@"-"])
+        return nil;
+
+    let liquidOutput = [OSInAppMessageLiquidOutput new];
+    liquidOutput.key = key;
+
+    if ([scanner scanString:@"|" intoString:nil]) {
+        if (![scanner scanString:LIQUID_DEFAULT_FILTER intoString:nil] || ![scanner scanString:@":" intoString:nil])
+            return nil;
+        NSString *quote;
+        if (![scanner scanString:@"\"" intoString:&quote] && ![scanner scanString:@"'" intoString:&quote])
+            return nil;
+        // Whitespace inside the quotes is part of the default value
+        scanner.charactersToBeSkipped = nil;
+        NSString *defaultValue = @"";
+        [scanner scanUpToString:quote intoString:&defaultValue];
+        if (![scanner scanString:quote intoString:nil])
+            return nil;
+        scanner.charactersToBeSkipped = whitespace;
+        liquidOutput.defaultValue = defaultValue;
+    }
+
+    return scanner.isAtEnd ? liquidOutput : nil;
+}
+
++ (NSString *)escapeHTML:(NSString *)string {
+    if ([string rangeOfCharacterFromSet:[NSCharacterSet characterSetWithCharactersInString:@"&<>\"'"]].location == NSNotFound)
+        return string;
+    NSMutableString *escaped = [string mutableCopy];
+    [escaped replaceOccurrencesOfString:@"&" withString:@"&amp;" options:NSLiteralSearch range:NSMakeRange(0, escaped.length)];
+    [escaped replaceOccurrencesOfString:@"<" withString:@"&lt;" options:NSLiteralSearch range:NSMakeRange(0, escaped.length)];
+    [escaped replaceOccurrencesOfString:@">" withString:@"&gt;" options:NSLiteralSearch range:NSMakeRange(0, escaped.length)];
+    [escaped replaceOccurrencesOfString:@"\"" withString:@"&quot;" options:NSLiteralSearch range:NSMakeRange(0, escaped.length)];
+    [escaped replaceOccurrencesOfString:@"'" withString:@"&#39;" options:NSLiteralSearch range:NSMakeRange(0, escaped.length)];
+    return escaped;
+}
+
+- (NSString *)renderWithTags:(NSDictionary<NSString *, id> *)tags {
+    if (!self.isNativelyRenderable)
+        return nil;
+
+    NSMutableString *rendered = [NSMutableString stringWithCapacity:self.html.length];
+    for (id segment in self.segments) {
+        if ([segment isKindOfClass:[NSString class]]) {
+            [rendered appendString:segment];
+            continue;
+        }
+        OSInAppMessageLiquidOutput *liquidOutput = segment;
+        id value = tags[liquidOutput.key];
+        NSString *text = [value isKindOfClass:[NSString class]] ? value : [value isKindOfClass:[NSNumber class]] ? [value stringValue] : nil;
+        // Like liquid, the default filter also replaces an empty value
+        if (text.length == 0)
+            text = liquidOutput.defaultValue ?: @"";
+        [rendered appendString:[OSInAppMessageLiquidTemplate escapeHTML:text]];
+    }
+    return rendered;
+}
+
+@end
+
+@implementation OSInAppMessageLiquidRenderer {
+    dispatch_queue_t _queue;
+    NSCache<NSString *, OSInAppMessageLiquidTemplate *> *_templates;
+}
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageLiquidRenderer *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        sharedInstance = [OSInAppMessageLiquidRenderer new];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _queue = dispatch_queue_create("com.onesignal.inAppMessageLiquidRenderer", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        _templates = [NSCache new];
+        _templates.countLimit = OS_IAM_LIQUID_TEMPLATE_CACHE_COUNT;
+    }
+    return self;
+}
+
+- (void)renderHTML:(NSString *)html
+         messageId:(NSString *)messageId
+         variantId:(NSString *)variantId
+              tags:(NSDictionary<NSString *, id> *)tags
+        completion:(void (^)(NSString * _Nullable))completion {
+    dispatch_async(_queue, ^{
+        let rendered = [[self templateForHTML:html messageId:messageId variantId:variantId] renderWithTags:tags];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(rendered);
+        });
+    });
+}
+
+// Called on _queue
+- (OSInAppMessageLiquidTemplate *)templateForHTML:(NSString *)html messageId:(NSString *)messageId variantId:(NSString *)variantId {
+    if (!variantId)
+        return [OSInAppMessageLiquidTemplate templateWithHTML:html];
+
+    let key = [NSString stringWithFormat:@"%@/%@", messageId, variantId];
+    OSInAppMessageLiquidTemplate *template = [_templates objectForKey:key];
+    // The content of a variant can change between displays
+    if (template && [template.html isEqualToString:html])
+        return template;
+
+    template = [OSInAppMessageLiquidTemplate templateWithHTML:html];
+    [_templates setObject:template forKey:key];
+    return template;
+}
+
+- (void)removeAllTemplates {
+    [_templates removeAllObjects];
+}
+
+@end
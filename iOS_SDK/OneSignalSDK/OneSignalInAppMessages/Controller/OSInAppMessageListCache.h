@@ -0,0 +1,51 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Keeps the body of the last fetched in-app message list with the ETag it was served with.
+ On launch the cached list is evaluated until the fetch completes, and the fetch sends the ETag
+ so an unchanged list is answered with a 304 instead of being downloaded again.
+ */
+@interface OSInAppMessageListCache : NSObject
+
++ (instancetype)sharedInstance;
+- (instancetype)initWithDirectory:(NSURL *)directory;
+
+// Reads the last fetched list body from disk, whichever subscription it was fetched for
+- (NSData * _Nullable)body;
+// The ETag of the cached list, only if it was fetched for this subscription
+- (NSString * _Nullable)etagForSubscriptionId:(NSString *)subscriptionId;
+- (void)storeBody:(NSData *)body etag:(NSString * _Nullable)etag subscriptionId:(NSString *)subscriptionId;
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
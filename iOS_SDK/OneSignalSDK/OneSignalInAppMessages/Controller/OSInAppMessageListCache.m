@@ -0,0 +1,129 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import "OSInAppMessageListCache.h"
+#import <OneSignalCore/OneSignalCore.h>
+#import "OSInAppMessagingDefines.h"
+#import "OSMacros.h"
+
+#define BODY_FILE_NAME @"body.json"
+// Written after the body, so a body without metadata is never used
+#define METADATA_FILE_NAME @"metadata.plist"
+#define METADATA_ETAG @"etag"
+#define METADATA_SUBSCRIPTION_ID @"subscription_id"
+
+@interface OSInAppMessageListCache ()
+@property (strong, nonatomic, readonly) NSURL *directory;
+// Read from disk on first access, guarded by @synchronized (self)
+@property (strong, nonatomic, nullable) NSDictionary<NSString *, NSString *> *metadata;
+@property (nonatomic) BOOL loadedMetadata;
+@end
+
+@implementation OSInAppMessageListCache
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageListCache *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSURL *caches = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedInstance = [[OSInAppMessageListCache alloc] initWithDirectory:[caches URLByAppendingPathComponent:OS_IAM_LIST_CACHE_DIRECTORY isDirectory:true]];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithDirectory:(NSURL *)directory {
+    if (self = [super init]) {
+        _directory = directory;
+    }
+    return self;
+}
+
+- (NSURL *)bodyURL {
+    return [self.directory URLByAppendingPathComponent:BODY_FILE_NAME];
+}
+
+- (NSURL *)metadataURL {
+    return [self.directory URLByAppendingPathComponent:METADATA_FILE_NAME];
+}
+
+- (NSDictionary<NSString *, NSString *> *)loadMetadata {
+    if (!self.loadedMetadata) {
+        self.loadedMetadata = YES;
+        NSDictionary *metadata = [NSDictionary dictionaryWithContentsOfURL:self.metadataURL];
+        if ([metadata[METADATA_SUBSCRIPTION_ID] isKindOfClass:[NSString class]])
+            self.metadata = metadata;
+    }
+    return self.metadata;
+}
+
+- (NSData *)body {
+    @synchronized (self) {
+        if (![self loadMetadata])
+            return nil;
+        return [NSData dataWithContentsOfURL:self.bodyURL options:NSDataReadingMappedIfSafe error:nil];
+    }
+}
+
+- (NSString *)etagForSubscriptionId:(NSString *)subscriptionId {
+    @synchronized (self) {
+        let metadata = [self loadMetadata];
+        if (![metadata[METADATA_SUBSCRIPTION_ID] isEqualToString:subscriptionId])
+            return nil;
+        NSString *etag = metadata[METADATA_ETAG];
+        return [etag isKindOfClass:[NSString class]] ? etag : nil;
+    }
+}
+
+- (void)storeBody:(NSData *)body etag:(NSString *)etag subscriptionId:(NSString *)subscriptionId {
+    @synchronized (self) {
+        [self removeAll];
+
+        let metadata = [NSMutableDictionary<NSString *, NSString *> new];
+        metadata[METADATA_SUBSCRIPTION_ID] = subscriptionId;
+        metadata[METADATA_ETAG] = etag;
+
+        NSError *error;
+        [NSFileManager.defaultManager createDirectoryAtURL:self.directory withIntermediateDirectories:true attributes:nil error:nil];
+        if (![body writeToURL:self.bodyURL options:NSDataWritingAtomic error:&error] ||
+            ![metadata writeToURL:self.metadataURL error:&error]) {
+            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to cache the in-app message list: %@", error]];
+            return;
+        }
+        self.metadata = metadata;
+    }
+}
+
+- (void)removeAll {
+    @synchronized (self) {
+        [NSFileManager.defaultManager removeItemAtURL:self.metadataURL error:nil];
+        [NSFileManager.defaultManager removeItemAtURL:self.bodyURL error:nil];
+        self.metadata = nil;
+        self.loadedMetadata = YES;
+    }
+}
+
+@end
@@ -0,0 +1,80 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OSInAppMessageInternal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, OSInAppMessageStateSet) {
+    OSInAppMessageStateSetSeen,
+    OSInAppMessageStateSetImpressioned,
+    OSInAppMessageStateSetClicked,
+    OSInAppMessageStateSetViewedPages
+};
+
+@interface OSInAppMessageState : NSObject
+@property (strong, nonatomic, readonly) NSSet<NSString *> *seenMessageIds;
+@property (strong, nonatomic, readonly) NSSet<NSString *> *impressionedMessageIds;
+@property (strong, nonatomic, readonly) NSSet<NSString *> *clickedClickIds;
+@property (strong, nonatomic, readonly) NSSet<NSString *> *viewedPageIds;
+@property (strong, nonatomic, readonly) NSDictionary<NSString *, OSInAppMessageInternal *> *redisplayedMessages;
+@end
+
+/**
+ Persists the in-app message display state as a snapshot plus an append-only journal of changes.
+ Each change appends one record instead of rewriting the whole state, and the journal is folded into the
+ snapshot once it grows. Entries older than OS_IAM_MAX_CACHE_TIME are evicted, except seen messages.
+ All disk I/O happens on a private serial queue.
+ */
+@interface OSInAppMessageStateStore : NSObject
+
++ (instancetype)sharedInstance;
+// maxAge is how long tracking and redisplay entries are kept, the clock returns seconds since 1970
+- (instancetype)initWithDirectory:(NSURL *)directory
+                           maxAge:(NSTimeInterval)maxAge
+                            clock:(NSTimeInterval (^ _Nullable)(void))clock;
+
+// Loads the state, migrating it from NSUserDefaults the first time, the completion is called on the main queue
+- (void)loadState:(void (^)(OSInAppMessageState *state))completion;
+
+- (void)addIdentifier:(NSString *)identifier toSet:(OSInAppMessageStateSet)set;
+- (void)removeIdentifier:(NSString *)identifier fromSet:(OSInAppMessageStateSet)set;
+- (void)removeAllIdentifiersFromSet:(OSInAppMessageStateSet)set;
+// The message is archived on the calling thread, so later changes to it are not persisted
+- (void)saveRedisplayedMessage:(OSInAppMessageInternal *)message;
+- (void)removeRedisplayedMessageWithId:(NSString *)messageId;
+
+// Blocks until the queued changes are written, used by tests
+- (void)flush;
+// Deletes all the state from memory and disk, used by tests
+- (void)removeAllState;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,402 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#import "OSInAppMessageStateStore.h"
+#import <OneSignalCore/OneSignalCore.h>
+#import "OSInAppMessagingDefines.h"
+#import "OSMacros.h"
+
+static NSString * const SNAPSHOT_FILE_NAME = @"state.plist";
+static NSString * const JOURNAL_FILE_NAME = @"journal.log";
+static NSString * const SNAPSHOT_VERSION = @"version";
+static NSString * const SNAPSHOT_SETS = @"sets";
+static NSString * const SNAPSHOT_REDISPLAYED = @"redisplayed";
+static NSString * const RECORD_OP = @"op";
+static NSString * const RECORD_SET = @"set";
+static NSString * const RECORD_ID = @"id";
+static NSString * const RECORD_TIME = @"time";
+static NSString * const RECORD_DATA = @"data";
+
+static const NSUInteger SET_COUNT = OSInAppMessageStateSetViewedPages + 1;
+
+typedef NS_ENUM(NSUInteger, OSInAppMessageStateOp) {
+    OSInAppMessageStateOpAdd,
+    OSInAppMessageStateOpRemove,
+    OSInAppMessageStateOpRemoveAll,
+    OSInAppMessageStateOpSaveRedisplayed,
+    OSInAppMessageStateOpRemoveRedisplayed
+};
+
+@implementation OSInAppMessageState
+
+- (instancetype)initWithSets:(NSArray<NSSet<NSString *> *> *)sets redisplayedMessages:(NSDictionary<NSString *, OSInAppMessageInternal *> *)redisplayedMessages {
+    if (self = [super init]) {
+        _seenMessageIds = sets[OSInAppMessageStateSetSeen];
+        _impressionedMessageIds = sets[OSInAppMessageStateSetImpressioned];
+        _clickedClickIds = sets[OSInAppMessageStateSetClicked];
+        _viewedPageIds = sets[OSInAppMessageStateSetViewedPages];
+        _redisplayedMessages = redisplayedMessages;
+    }
+    return self;
+}
+
+@end
+
+@implementation OSInAppMessageStateStore {
+    NSURL *_directory;
+    NSTimeInterval _maxAge;
+    NSTimeInterval (^_clock)(void);
+    dispatch_queue_t _queue;
+    // Accessed on _queue only
+    // Identifiers of each OSInAppMessageStateSet, mapped to when they were added
+    NSArray<NSMutableDictionary<NSString *, NSNumber *> *> *_sets;
+    // Archived redisplayed messages and their last display time, keyed by message id
+    NSMutableDictionary<NSString *, NSDictionary *> *_redisplayed;
+    NSFileHandle *_journal;
+    NSUInteger _journalRecordCount;
+}
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageStateStore *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSURL *applicationSupport = [NSFileManager.defaultManager URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask].firstObject;
+        sharedInstance = [[OSInAppMessageStateStore alloc] initWithDirectory:[applicationSupport URLByAppendingPathComponent:OS_IAM_STATE_DIRECTORY isDirectory:true]
+                                                                      maxAge:OS_IAM_MAX_CACHE_TIME
+                                                                       clock:nil];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithDirectory:(NSURL *)directory maxAge:(NSTimeInterval)maxAge clock:(NSTimeInterval (^)(void))clock {
+    if (self = [super init]) {
+        _directory = directory;
+        _maxAge = maxAge;
+        _clock = clock ?: ^NSTimeInterval {
+            return [[NSDate date] timeIntervalSince1970];
+        };
+        _queue = dispatch_queue_create("com.onesignal.inAppMessageStateStore", DISPATCH_QUEUE_SERIAL);
+        let sets = [NSMutableArray new];
+        for (NSUInteger set = 0; set < SET_COUNT; set++)
+            [sets addObject:[NSMutableDictionary new]];
+        _sets = sets;
+        _redisplayed = [NSMutableDictionary new];
+
+        // Queued first, so every other call sees the loaded state
+        dispatch_async(_queue, ^{
+            [self loadOnQueue];
+        });
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_journal closeFile];
+}
+
+#pragma mark Public Methods
+
+- (void)loadState:(void (^)(OSInAppMessageState *))completion {
+    dispatch_async(_queue, ^{
+        let sets = [NSMutableArray new];
+        for (NSDictionary *set in self->_sets)
+            [sets addObject:[NSSet setWithArray:set.allKeys]];
+
+        let redisplayedMessages = [NSMutableDictionary<NSString *, OSInAppMessageInternal *> new];
+        for (NSString *messageId in self->_redisplayed) {
+            let message = [self unarchiveMessage:self->_redisplayed[messageId][RECORD_DATA]];
+            if (message)
+                redisplayedMessages[messageId] = message;
+        }
+
+        let state = [[OSInAppMessageState alloc] initWithSets:sets redisplayedMessages:redisplayedMessages];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(state);
+        });
+    });
+}
+
+- (void)addIdentifier:(NSString *)identifier toSet:(OSInAppMessageStateSet)set {
+    [self appendRecord:@{RECORD_OP: @(OSInAppMessageStateOpAdd), RECORD_SET: @(set), RECORD_ID: identifier, RECORD_TIME: @(_clock())}];
+}
+
+- (void)removeIdentifier:(NSString *)identifier fromSet:(OSInAppMessageStateSet)set {
+    [self appendRecord:@{RECORD_OP: @(OSInAppMessageStateOpRemove), RECORD_SET: @(set), RECORD_ID: identifier}];
+}
+
+- (void)removeAllIdentifiersFromSet:(OSInAppMessageStateSet)set {
+    [self appendRecord:@{RECORD_OP: @(OSInAppMessageStateOpRemoveAll), RECORD_SET: @(set)}];
+}
+
+- (void)saveRedisplayedMessage:(OSInAppMessageInternal *)message {
+    NSData *data;
+    @try {
+        data = [NSKeyedArchiver archivedDataWithRootObject:message];
+    } @catch (NSException *exception) {
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to archive in-app message %@ for redisplay: %@", message.messageId, exception.reason]];
+        return;
+    }
+    [self appendRecord:@{RECORD_OP: @(OSInAppMessageStateOpSaveRedisplayed),
+                         RECORD_ID: message.messageId,
+                         RECORD_TIME: @(message.displayStats.lastDisplayTime),
+                         RECORD_DATA: data}];
+}
+
+- (void)removeRedisplayedMessageWithId:(NSString *)messageId {
+    [self appendRecord:@{RECORD_OP: @(OSInAppMessageStateOpRemoveRedisplayed), RECORD_ID: messageId}];
+}
+
+- (void)flush {
+    dispatch_sync(_queue, ^{});
+}
+
+- (void)removeAllState {
+    dispatch_sync(_queue, ^{
+        for (NSMutableDictionary *set in self->_sets)
+            [set removeAllObjects];
+        [self->_redisplayed removeAllObjects];
+        [self->_journal closeFile];
+        self->_journal = nil;
+        self->_journalRecordCount = 0;
+        [NSFileManager.defaultManager removeItemAtURL:self.snapshotURL error:nil];
+        [NSFileManager.defaultManager removeItemAtURL:self.journalURL error:nil];
+    });
+}
+
+#pragma mark Private Methods, on _queue
+
+- (NSURL *)snapshotURL {
+    return [_directory URLByAppendingPathComponent:SNAPSHOT_FILE_NAME isDirectory:false];
+}
+
+- (NSURL *)journalURL {
+    return [_directory URLByAppendingPathComponent:JOURNAL_FILE_NAME isDirectory:false];
+}
+
+- (void)appendRecord:(NSDictionary *)record {
+    dispatch_async(_queue, ^{
+        [self applyRecord:record];
+
+        NSData *data = [NSPropertyListSerialization dataWithPropertyList:record format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+        if (!data || ![self openJournal])
+            return;
+
+        // Records are framed by their length, so a partially written last record can be detected on load
+        uint32_t length = CFSwapInt32HostToLittle((uint32_t)data.length);
+        NSMutableData *frame = [NSMutableData dataWithBytes:&length length:sizeof(length)];
+        [frame appendData:data];
+        @try {
+            [self->_journal writeData:frame];
+        } @catch (NSException *exception) {
+            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to append to the in-app message state journal: %@", exception.reason]];
+            return;
+        }
+
+        if (++self->_journalRecordCount >= OS_IAM_STATE_JOURNAL_COMPACTION_THRESHOLD)
+            [self compact];
+    });
+}
+
+- (BOOL)openJournal {
+    if (_journal)
+        return true;
+
+    let fileManager = NSFileManager.defaultManager;
+    [fileManager createDirectoryAtURL:_directory withIntermediateDirectories:true attributes:nil error:nil];
+    if (![fileManager fileExistsAtPath:self.journalURL.path])
+        [fileManager createFileAtPath:self.journalURL.path contents:nil attributes:nil];
+
+    _journal = [NSFileHandle fileHandleForWritingToURL:self.journalURL error:nil];
+    [_journal seekToEndOfFile];
+    return _journal != nil;
+}
+
+- (void)applyRecord:(NSDictionary *)record {
+    let op = (OSInAppMessageStateOp)[record[RECORD_OP] unsignedIntegerValue];
+    let setIndex = [record[RECORD_SET] unsignedIntegerValue];
+    NSString *identifier = record[RECORD_ID];
+    if (setIndex >= SET_COUNT)
+        return;
+    let set = _sets[setIndex];
+
+    switch (op) {
+        case OSInAppMessageStateOpAdd:
+            if (identifier)
+                set[identifier] = record[RECORD_TIME];
+            break;
+        case OSInAppMessageStateOpRemove:
+            if (identifier)
+                [set removeObjectForKey:identifier];
+            break;
+        case OSInAppMessageStateOpRemoveAll:
+            [set removeAllObjects];
+            break;
+        case OSInAppMessageStateOpSaveRedisplayed:
+            if (identifier && record[RECORD_DATA])
+                _redisplayed[identifier] = @{RECORD_TIME: record[RECORD_TIME] ?: @0, RECORD_DATA: record[RECORD_DATA]};
+            break;
+        case OSInAppMessageStateOpRemoveRedisplayed:
+            if (identifier)
+                [_redisplayed removeObjectForKey:identifier];
+            break;
+    }
+}
+
+- (void)loadOnQueue {
+    let snapshot = [NSDictionary dictionaryWithContentsOfURL:self.snapshotURL];
+    let journal = [NSData dataWithContentsOfURL:self.journalURL];
+    var needsCompaction = false;
+    var migrated = false;
+
+    if (snapshot) {
+        NSArray *sets = [snapshot[SNAPSHOT_SETS] isKindOfClass:[NSArray class]] ? snapshot[SNAPSHOT_SETS] : @[];
+        for (NSUInteger set = 0; set < SET_COUNT && set < sets.count; set++) {
+            if ([sets[set] isKindOfClass:[NSDictionary class]])
+                [_sets[set] addEntriesFromDictionary:sets[set]];
+        }
+        if ([snapshot[SNAPSHOT_REDISPLAYED] isKindOfClass:[NSDictionary class]])
+            [_redisplayed addEntriesFromDictionary:snapshot[SNAPSHOT_REDISPLAYED]];
+    } else if (!journal) {
+        migrated = [self migrateFromUserDefaults];
+        needsCompaction = migrated;
+    }
+
+    NSUInteger offset = 0;
+    while (offset + sizeof(uint32_t) <= journal.length) {
+        uint32_t length;
+        [journal getBytes:&length range:NSMakeRange(offset, sizeof(length))];
+        length = CFSwapInt32LittleToHost(length);
+        if (offset + sizeof(length) + length > journal.length)
+            break;
+        let recordData = [journal subdataWithRange:NSMakeRange(offset + sizeof(length), length)];
+        NSDictionary *record = [NSPropertyListSerialization propertyListWithData:recordData options:NSPropertyListImmutable format:nil error:nil];
+        if (![record isKindOfClass:[NSDictionary class]])
+            break;
+        [self applyRecord:record];
+        offset += sizeof(length) + length;
+        needsCompaction = true;
+    }
+
+    needsCompaction = [self evictExpiredEntries] || needsCompaction;
+    if (needsCompaction && [self compact] && migrated) {
+        let standardUserDefaults = OneSignalUserDefaults.initStandard;
+        for (NSString *key in @[OS_IAM_SEEN_SET_KEY, OS_IAM_IMPRESSIONED_SET_KEY, OS_IAM_CLICKED_SET_KEY, OS_IAM_PAGE_IMPRESSIONED_SET_KEY, OS_IAM_REDISPLAY_DICTIONARY])
+            [standardUserDefaults removeValueForKey:key];
+    }
+}
+
+/*
+ Before the journal, each set and the redisplay dictionary were rewritten to NSUserDefaults on every change
+ Returns true if there was any state to import
+ */
+- (BOOL)migrateFromUserDefaults {
+    let standardUserDefaults = OneSignalUserDefaults.initStandard;
+    let now = @(_clock());
+    NSDictionary<NSString *, NSNumber *> *keysBySet = @{
+        OS_IAM_SEEN_SET_KEY: @(OSInAppMessageStateSetSeen),
+        OS_IAM_IMPRESSIONED_SET_KEY: @(OSInAppMessageStateSetImpressioned),
+        OS_IAM_CLICKED_SET_KEY: @(OSInAppMessageStateSetClicked),
+        OS_IAM_PAGE_IMPRESSIONED_SET_KEY: @(OSInAppMessageStateSetViewedPages)
+    };
+    var migrated = false;
+    for (NSString *key in keysBySet) {
+        let identifiers = [standardUserDefaults getSavedSetForKey:key defaultValue:nil];
+        for (NSString *identifier in identifiers) {
+            _sets[keysBySet[key].unsignedIntegerValue][identifier] = now;
+        }
+        migrated = migrated || identifiers.count > 0;
+    }
+
+    @try {
+        NSDictionary<NSString *, OSInAppMessageInternal *> *redisplayedMessages = [standardUserDefaults getSavedCodeableDataForKey:OS_IAM_REDISPLAY_DICTIONARY defaultValue:nil];
+        for (NSString *messageId in redisplayedMessages) {
+            let message = redisplayedMessages[messageId];
+            _redisplayed[messageId] = @{RECORD_TIME: @(message.displayStats.lastDisplayTime),
+                                        RECORD_DATA: [NSKeyedArchiver archivedDataWithRootObject:message]};
+            migrated = true;
+        }
+    } @catch (NSException *exception) {
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to migrate cached in-app messages for redisplay: %@", exception.reason]];
+    }
+    return migrated;
+}
+
+// Returns true if any entry was evicted
+- (BOOL)evictExpiredEntries {
+    let oldest = _clock() - _maxAge;
+    var evicted = false;
+    for (NSUInteger set = 0; set < SET_COUNT; set++) {
+        // A seen message must never be displayed again, so those are kept
+        if (set == OSInAppMessageStateSetSeen)
+            continue;
+        let expired = [_sets[set] keysOfEntriesPassingTest:^BOOL(NSString *identifier, NSNumber *time, BOOL *stop) {
+            return [time doubleValue] < oldest;
+        }];
+        [_sets[set] removeObjectsForKeys:expired.allObjects];
+        evicted = evicted || expired.count > 0;
+    }
+    let expiredMessages = [_redisplayed keysOfEntriesPassingTest:^BOOL(NSString *messageId, NSDictionary *entry, BOOL *stop) {
+        return [entry[RECORD_TIME] doubleValue] < oldest;
+    }];
+    [_redisplayed removeObjectsForKeys:expiredMessages.allObjects];
+    return evicted || expiredMessages.count > 0;
+}
+
+/*
+ Folds the journal into a new snapshot, written atomically before the journal is truncated
+ Replaying records is idempotent, so being interrupted in between loses nothing
+ */
+- (BOOL)compact {
+    [self evictExpiredEntries];
+    [NSFileManager.defaultManager createDirectoryAtURL:_directory withIntermediateDirectories:true attributes:nil error:nil];
+    NSDictionary *snapshot = @{SNAPSHOT_VERSION: @1, SNAPSHOT_SETS: _sets, SNAPSHOT_REDISPLAYED: _redisplayed};
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:snapshot format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (!data || ![data writeToURL:self.snapshotURL options:NSDataWritingAtomic error:&error]) {
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to write the in-app message state snapshot: %@", error]];
+        return false;
+    }
+
+    if ([self openJournal]) {
+        [_journal truncateFileAtOffset:0];
+    }
+    _journalRecordCount = 0;
+    return true;
+}
+
+- (OSInAppMessageInternal *)unarchiveMessage:(NSData *)data {
+    @try {
+        id message = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+        return [message isKindOfClass:[OSInAppMessageInternal class]] ? message : nil;
+    } @catch (NSException *exception) {
+        [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:[NSString stringWithFormat:@"Failed to unarchive an in-app message for redisplay: %@", exception.reason]];
+        return nil;
+    }
+}
+
+@end
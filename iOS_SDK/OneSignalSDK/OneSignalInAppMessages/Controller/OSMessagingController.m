@@ -33,6 +33,11 @@
 #import "OSInAppMessageClickResult.h"
 #import "OSInAppMessageClickEvent.h"
 #import "OSInAppMessageController.h"
+#import "OSInAppMessageContentCache.h"
+#import "OSInAppMessageListCache.h"
+#import "OSInAppMessageStateStore.h"
+#import "OSInAppMessageAnalyticsQueue.h"
+#import "OSInAppMessageWebViewPool.h"
 #import "OSInAppMessagePrompt.h"
 #import "OSInAppMessagingRequests.h"
 #import "OneSignalWebViewManager.h"
@@ -105,7 +110,53 @@ static NSInteger const IAM_FETCH_DELAY_BUFFER = 0.5;        // Fallback value if
 
 @end
 
-@interface OSMessagingController ()
+/*
+ Messages with their trigger index, built on the parsing queue so the main thread only swaps it in
+ */
+@interface OSInAppMessageList : NSObject
+@property (strong, nonatomic, readonly, nonnull) NSArray<OSInAppMessageInternal *> *messages;
+@property (strong, nonatomic, readonly, nonnull) NSDictionary<NSString *, NSIndexSet *> *messageIndexesByTriggerKey;
+@property (strong, nonatomic, readonly, nonnull) NSIndexSet *untriggeredMessageIndexes;
++ (instancetype)listWithMessages:(NSArray<OSInAppMessageInternal *> *)messages;
+@end
+
+@implementation OSInAppMessageList
+
++ (instancetype)listWithMessages:(NSArray<OSInAppMessageInternal *> *)messages {
+    let messageIndexesByTriggerKey = [NSMutableDictionary<NSString *, NSMutableIndexSet *> new];
+    let untriggeredMessageIndexes = [NSMutableIndexSet new];
+    [messages enumerateObjectsUsingBlock:^(OSInAppMessageInternal *message, NSUInteger index, BOOL *stop) {
+        if (message.triggers.count == 0) {
+            [untriggeredMessageIndexes addIndex:index];
+            return;
+        }
+        for (NSArray<OSTrigger *> *andConditions in message.triggers) {
+            for (OSTrigger *trigger in andConditions) {
+                // Dynamic triggers are referenced by triggerId, triggers set by the app by property
+                for (NSString *key in @[trigger.property ?: @"", trigger.triggerId ?: @""]) {
+                    if (key.length == 0)
+                        continue;
+                    var indexes = messageIndexesByTriggerKey[key];
+                    if (!indexes) {
+                        indexes = [NSMutableIndexSet new];
+                        messageIndexesByTriggerKey[key] = indexes;
+                    }
+                    [indexes addIndex:index];
+                }
+            }
+        }
+    }];
+
+    let list = [OSInAppMessageList new];
+    list->_messages = messages;
+    list->_messageIndexesByTriggerKey = messageIndexesByTriggerKey;
+    list->_untriggeredMessageIndexes = untriggeredMessageIndexes;
+    return list;
+}
+
+@end
+
+@interface OSMessagingController () <OSInAppMessageAnalyticsQueueDelegate>
 
 @property (strong, nonatomic, nullable) UIWindow *window;
 @property (strong, nonatomic, nonnull) NSArray <OSInAppMessageInternal *> *messages;
@@ -144,8 +195,6 @@ static NSInteger const IAM_FETCH_DELAY_BUFFER = 0.5;        // Fallback value if
 
 @property (nonatomic) BOOL isAppInactive;
 
-@property (nonatomic) BOOL calledLoadTags;
-
 /// set when we attempt getInAppMessagesFromServer and no onesignal ID is available yet
 @property (strong, nonatomic, nullable) NSString *shouldFetchOnUserChangeWithSubscriptionID;
 
@@ -155,12 +204,31 @@ static NSInteger const IAM_FETCH_DELAY_BUFFER = 0.5;        // Fallback value if
 /// Tracks trigger keys added early on cold start (before first fetch completes), for redisplay logic
 @property (strong, nonatomic, nonnull) NSMutableSet<NSString *> *earlySessionTriggers;
 
+/// Positions in `messages` of the messages using each trigger property or triggerId, rebuilt whenever `messages` is set
+@property (strong, nonatomic, nonnull) NSDictionary<NSString *, NSIndexSet *> *messageIndexesByTriggerKey;
+
+/// Persists seenInAppMessages, impressionedInAppMessages, clickedClickIds, viewedPageIDs and redisplayedInAppMessages
+@property (strong, nonatomic, nonnull) OSInAppMessageStateStore *stateStore;
+
+/// Sends impressions, page views and clicks, which are saved to stateStore once delivered
+@property (strong, nonatomic, nonnull) OSInAppMessageAnalyticsQueue *analyticsQueue;
+
+/// Messages are not evaluated until the persisted state is loaded, so a seen message is never displayed again
+@property (nonatomic) BOOL hasLoadedState;
+
+/// Positions in `messages` of the messages without triggers
+@property (strong, nonatomic, nonnull) NSIndexSet *untriggeredMessageIndexes;
+
+/// Decodes fetched messages and builds their trigger index off the main thread, in the order responses arrive
+@property (strong, nonatomic, nonnull) dispatch_queue_t parsingQueue;
+
+/// The last fetched message list, evaluated on launch until the fetch completes
+@property (strong, nonatomic, nonnull) OSInAppMessageListCache *listCache;
+
 @end
 
 @implementation OSMessagingController
 @dynamic isInAppMessagingPaused;
-// Maximum time decided to save IAM with redisplay on cache - current value: six months in seconds
-static long OS_IAM_MAX_CACHE_TIME = 6 * 30 * 24 * 60 * 60;
 static OSMessagingController *sharedInstance = nil;
 static dispatch_once_t once;
 + (OSMessagingController *)sharedInstance {
@@ -179,6 +247,9 @@ static dispatch_once_t once;
 + (void)removeInstance {
     sharedInstance = nil;
     once = 0;
+    [OSInAppMessageStateStore.sharedInstance removeAllState];
+    [OSInAppMessageAnalyticsQueue.sharedInstance removeAllEvents];
+    [OSInAppMessageListCache.sharedInstance removeAll];
 }
 
 + (void)start {
@@ -191,6 +262,12 @@ static BOOL _isInAppMessagingPaused = false;
 - (BOOL)isInAppMessagingPaused {
     return _isInAppMessagingPaused;
 }
+
+- (void)setIsInAppMessageShowing:(BOOL)isInAppMessageShowing {
+    _isInAppMessageShowing = isInAppMessageShowing;
+    // Messages can't display over the current one, their timers are delivered once it is dismissed
+    self.triggerController.dynamicTriggersPaused = isInAppMessageShowing;
+}
 - (void)setInAppMessagingPaused:(BOOL)pause {
     _isInAppMessagingPaused = pause;
     
@@ -220,6 +297,9 @@ static BOOL _isInAppMessagingPaused = false;
             return [[NSDate date] timeIntervalSince1970];
         };
         self.messages = [NSArray<OSInAppMessageInternal *> new];
+        self.parsingQueue = dispatch_queue_create("com.onesignal.inAppMessageParsing", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        self.listCache = OSInAppMessageListCache.sharedInstance;
+        [self loadCachedMessages];
         [self initializeTriggerController];
         self.messageDisplayQueue = [NSMutableArray new];
         self.clickListeners = [NSMutableArray new];
@@ -227,15 +307,16 @@ static BOOL _isInAppMessagingPaused = false;
         self.hasCompletedFirstFetch = NO;
         self.earlySessionTriggers = [NSMutableSet new];
         
-        let standardUserDefaults = OneSignalUserDefaults.initStandard;
-        
-        // Get all cached IAM data from NSUserDefaults for shown, impressions, and clicks
-        self.seenInAppMessages = [[NSMutableSet alloc] initWithSet:[standardUserDefaults getSavedSetForKey:OS_IAM_SEEN_SET_KEY defaultValue:nil]];
-        self.redisplayedInAppMessages = [[NSMutableDictionary alloc] initWithDictionary:[standardUserDefaults getSavedCodeableDataForKey:OS_IAM_REDISPLAY_DICTIONARY defaultValue:[NSMutableDictionary new]]];
-        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"init redisplayedInAppMessages with: %@", [_redisplayedInAppMessages description]]];
-        self.clickedClickIds = [[NSMutableSet alloc] initWithSet:[standardUserDefaults getSavedSetForKey:OS_IAM_CLICKED_SET_KEY defaultValue:nil]];
-        self.impressionedInAppMessages = [[NSMutableSet alloc] initWithSet:[standardUserDefaults getSavedSetForKey:OS_IAM_IMPRESSIONED_SET_KEY defaultValue:nil]];
-        self.viewedPageIDs = [[NSMutableSet alloc] initWithSet:[standardUserDefaults getSavedSetForKey:OS_IAM_PAGE_IMPRESSIONED_SET_KEY defaultValue:nil]];
+        // The cached IAM data for shown, impressions, clicks and redisplay is loaded off the main thread
+        self.seenInAppMessages = [NSMutableSet new];
+        self.redisplayedInAppMessages = [NSMutableDictionary new];
+        self.clickedClickIds = [NSMutableSet new];
+        self.impressionedInAppMessages = [NSMutableSet new];
+        self.viewedPageIDs = [NSMutableSet new];
+        self.stateStore = OSInAppMessageStateStore.sharedInstance;
+        [self loadState];
+        self.analyticsQueue = OSInAppMessageAnalyticsQueue.sharedInstance;
+        self.analyticsQueue.delegate = self;
         self.currentPromptAction = nil;
         self.isAppInactive = NO;
         // BOOL that controls if in-app messaging is paused or not (false by default)
@@ -247,6 +328,23 @@ static BOOL _isInAppMessagingPaused = false;
     return self;
 }
 
+- (void)loadState {
+    [self.stateStore loadState:^(OSInAppMessageState *state) {
+        // Changes made before the state was loaded are newer, so they are kept
+        [self.seenInAppMessages unionSet:state.seenMessageIds];
+        [self.impressionedInAppMessages unionSet:state.impressionedMessageIds];
+        [self.clickedClickIds unionSet:state.clickedClickIds];
+        [self.viewedPageIDs unionSet:state.viewedPageIds];
+        for (NSString *messageId in state.redisplayedMessages) {
+            if (!self.redisplayedInAppMessages[messageId])
+                self.redisplayedInAppMessages[messageId] = state.redisplayedMessages[messageId];
+        }
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"init redisplayedInAppMessages with: %@", [self.redisplayedInAppMessages description]]];
+        self.hasLoadedState = YES;
+        [self evaluateMessages];
+    }];
+}
+
 - (void)initializeTriggerController {
     self.triggerController = [OSTriggerController new];
     self.triggerController.delegate = self;
@@ -308,35 +406,24 @@ static BOOL _isInAppMessagingPaused = false;
     OSRequestGetInAppMessages *request = [OSRequestGetInAppMessages withSubscriptionId:subscriptionId
                                                                     withSessionDuration:sessionDuration
                                                                     withRetryCount:attempts
-                                                                    withRywToken:rywToken];
+                                                                    withRywToken:rywToken
+                                                                    ifNoneMatch:[self.listCache etagForSubscriptionId:subscriptionId]];
 
     __block NSNumber *blockRetryLimit = retryLimit;
 
     [OneSignalCoreImpl.sharedClient executeRequest:request
-                                          onSuccess:^(NSDictionary *result) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"getInAppMessagesFromServer success"];
-            if (result[@"in_app_messages"]) {
-                NSMutableArray *messages = [NSMutableArray new];
-                
-                for (NSDictionary *messageJson in result[@"in_app_messages"]) {
-                    OSInAppMessageInternal *message = [OSInAppMessageInternal instanceWithJson:messageJson];
-                    if (message) {
-                        [messages addObject:message];
-                    }
-                }
-                
-                [self updateInAppMessagesFromServer:messages];
-                return;
-            }
-        });
+                                          onResponse:^(OSHTTPResponse *response) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"getInAppMessagesFromServer success"];
+        [self updateInAppMessagesFromResponse:response subscriptionId:subscriptionId];
     }
     onFailure:^(OneSignalClientError *error) {
         NSDictionary* responseHeaders = error.responseHeaders;
         
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"getInAppMessagesFromServer failure: %@", error.description]];
         
-        if (error.code == 425 || error.code == 429) { // 425 Too Early or 429 Too Many Requests
+        if (error.code == 304) { // Not Modified, the cached list is current
+            [self updateInAppMessagesFromCacheForSubscriptionId:subscriptionId];
+        } else if (error.code == 425 || error.code == 429) { // 425 Too Early or 429 Too Many Requests
             NSInteger retryAfter = [responseHeaders[@"Retry-After"] integerValue] ?: DEFAULT_RETRY_AFTER_SECONDS;
             
             // Dynamically set the retry limit from the header, if not already set
@@ -382,43 +469,116 @@ static BOOL _isInAppMessagingPaused = false;
     OSRequestGetInAppMessages *request = [OSRequestGetInAppMessages withSubscriptionId:subscriptionId
                                                                       withSessionDuration:sessionDuration
                                                                       withRetryCount:nil
-                                                                      withRywToken:nil]; // No retries for the final attempt
+                                                                      withRywToken:nil // No retries for the final attempt
+                                                                      ifNoneMatch:[self.listCache etagForSubscriptionId:subscriptionId]];
 
     [OneSignalCoreImpl.sharedClient executeRequest:request
-                                          onSuccess:^(NSDictionary *result) {
+                                          onResponse:^(OSHTTPResponse *response) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Final attempt without token success"];
+        [self updateInAppMessagesFromResponse:response subscriptionId:subscriptionId];
+    } onFailure:^(OneSignalClientError *error) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"getInAppMessagesFromServer failure: %@", error.description]];
+        if (error.code == 304)
+            [self updateInAppMessagesFromCacheForSubscriptionId:subscriptionId];
+    }];
+}
+
+/*
+ Parses the response on the parsing queue and only swaps in the parsed messages on the main queue,
+ so a large message list does not block the main thread during launch
+ */
+- (void)updateInAppMessagesFromResponse:(OSHTTPResponse *)response subscriptionId:(NSString *)subscriptionId {
+    dispatch_async(self.parsingQueue, ^{
+        let messageList = [OSMessagingController messageListFromResponse:response];
+        if (!messageList)
+            return;
+        // Only a raw body can be replayed on the next launch
+        if (response.data.length > 0)
+            [self.listCache storeBody:response.data etag:[response valueForHeader:@"ETag"] subscriptionId:subscriptionId];
         dispatch_async(dispatch_get_main_queue(), ^{
-            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Final attempt without token success"];
-            if (result[@"in_app_messages"]) {
-                NSMutableArray *messages = [NSMutableArray new];
-
-                for (NSDictionary *messageJson in result[@"in_app_messages"]) {
-                    OSInAppMessageInternal *message = [OSInAppMessageInternal instanceWithJson:messageJson];
-                    if (message) {
-                        [messages addObject:message];
-                    }
-                }
+            [self updateInAppMessagesFromServer:messageList];
+        });
+    });
+}
+
+/*
+ The server confirmed the cached list is current, so it is applied as if it had just been fetched
+ */
+- (void)updateInAppMessagesFromCacheForSubscriptionId:(NSString *)subscriptionId {
+    dispatch_async(self.parsingQueue, ^{
+        let messageList = [self cachedMessageList];
+        if (!messageList) {
+            // The cached body was removed since its ETag was sent, fetch the list without one
+            [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:@"In-app message list was not modified but is no longer cached, fetching it again"];
+            [self.listCache removeAll];
+            [self getInAppMessagesFromServer:subscriptionId];
+            return;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self updateInAppMessagesFromServer:messageList];
+        });
+    });
+}
 
-                [self updateInAppMessagesFromServer:messages];
+/*
+ Evaluates the last fetched list on launch, so session start messages do not wait for the fetch
+ The fetched list replaces it once it arrives, the cached list is never used after that
+ */
+- (void)loadCachedMessages {
+    dispatch_async(self.parsingQueue, ^{
+        let messageList = [self cachedMessageList];
+        if (!messageList)
+            return;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (self.hasCompletedFirstFetch)
                 return;
-            }
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Evaluating %lu cached in-app messages until the message list is fetched", (unsigned long)messageList.messages.count]];
+            [self setMessageList:messageList];
+            [self evaluateMessages];
         });
-    } onFailure:^(OneSignalClientError *error) {
-        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"getInAppMessagesFromServer failure: %@", error.description]];
+    });
+}
+
+// Called on the parsing queue
+- (OSInAppMessageList *)cachedMessageList {
+    let body = [self.listCache body];
+    if (!body)
+        return nil;
+    return [OSMessagingController messageListFromResponse:[[OSHTTPResponse alloc] initWithStatusCode:200 headers:nil data:body]];
+}
+
+/*
+ Decodes the messages one at a time, so the whole response is never held decoded at once
+ Decoding a message also resolves its trigger operands, invalid messages and repeated message ids are dropped
+ */
++ (OSInAppMessageList *)messageListFromResponse:(OSHTTPResponse *)response {
+    NSMutableArray *messages = [NSMutableArray new];
+    NSMutableSet<NSString *> *messageIds = [NSMutableSet new];
+    BOOL decoded = [response enumerateArrayForKey:@"in_app_messages" usingBlock:^(id messageJson, BOOL *stop) {
+        if (![messageJson isKindOfClass:[NSDictionary class]])
+            return;
+        OSInAppMessageInternal *message = [OSInAppMessageInternal instanceWithJson:messageJson];
+        if (!message || [messageIds containsObject:message.messageId]) {
+            [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Skipping invalid or repeated in-app message: %@", messageJson[@"id"]]];
+            return;
+        }
+        [messageIds addObject:message.messageId];
+        [messages addObject:message];
     }];
+
+    return decoded ? [OSInAppMessageList listWithMessages:messages] : nil;
 }
 
-- (void)updateInAppMessagesFromServer:(NSArray<OSInAppMessageInternal *> *)newMessages {
+- (void)updateInAppMessagesFromServer:(OSInAppMessageList *)messageList {
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"updateInAppMessagesFromServer"];
-    self.messages = newMessages;
-    self.calledLoadTags = NO;
+    [self setMessageList:messageList];
     [self resetRedisplayMessagesBySession];
 
     // Apply isTriggerChanged for messages that match triggers added too early on cold start
     if (self.earlySessionTriggers.count > 0) {
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Processing triggers added early on cold start: %@", self.earlySessionTriggers]];
-        for (OSInAppMessageInternal *message in self.messages) {
-            if ([self.redisplayedInAppMessages objectForKey:message.messageId] &&
-                [self.triggerController hasSharedTriggers:message newTriggersKeys:self.earlySessionTriggers.allObjects]) {
+        for (OSInAppMessageInternal *message in [self messagesWithTriggerKeys:self.earlySessionTriggers.allObjects]) {
+            if ([self.redisplayedInAppMessages objectForKey:message.messageId]) {
                 [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Setting isTriggerChanged=YES for message %@", message]];
                 message.isTriggerChanged = YES;
             }
@@ -431,6 +591,59 @@ static BOOL _isInAppMessagingPaused = false;
 
     [self evaluateMessages];
     [self deleteOldRedisplayedInAppMessages];
+    [self prefetchMessageContent];
+
+    // With messages to display, have a web view ready before one of them is triggered
+    if (self.messages.count > 0)
+        [OSInAppMessageWebViewPool.sharedInstance prewarm];
+}
+
+/*
+ Warms the content cache for messages likely to display soon, so displaying them only needs a disk read
+ A message is likely to display when its non-time based triggers already match
+ */
+- (void)prefetchMessageContent {
+    NSMutableSet<NSString *> *messageIds = [NSMutableSet new];
+    NSUInteger prefetchCount = 0;
+    for (OSInAppMessageInternal *message in self.messages) {
+        [messageIds addObject:message.messageId];
+        if (prefetchCount >= OS_IAM_PREFETCH_MAX_MESSAGES || [message isFinished])
+            continue;
+        if ([self.seenInAppMessages containsObject:message.messageId] && !message.displayStats.isRedisplayEnabled)
+            continue;
+        if (![self.triggerController messageMatchesNonDynamicTriggers:message])
+            continue;
+        prefetchCount++;
+        [message prefetchMessageHTMLContent];
+    }
+    [OSInAppMessageContentCache.sharedInstance removeContentForMessagesNotIn:messageIds];
+}
+
+- (void)setMessages:(NSArray<OSInAppMessageInternal *> *)messages {
+    [self setMessageList:[OSInAppMessageList listWithMessages:messages]];
+}
+
+- (void)setMessageList:(OSInAppMessageList *)messageList {
+    _messageIndexesByTriggerKey = messageList.messageIndexesByTriggerKey;
+    _untriggeredMessageIndexes = messageList.untriggeredMessageIndexes;
+    _messages = messageList.messages;
+}
+
+- (NSMutableIndexSet *)indexesOfMessagesWithTriggerKeys:(NSArray<NSString *> *)keys {
+    let indexes = [NSMutableIndexSet new];
+    let messageIndexesByTriggerKey = self.messageIndexesByTriggerKey;
+    for (NSString *key in keys) {
+        let keyIndexes = messageIndexesByTriggerKey[key];
+        if (keyIndexes)
+            [indexes addIndexes:keyIndexes];
+    }
+    return indexes;
+}
+
+- (NSArray<OSInAppMessageInternal *> *)messagesWithTriggerKeys:(NSArray<NSString *> *)keys {
+    let messages = self.messages;
+    let indexes = [self indexesOfMessagesWithTriggerKeys:keys];
+    return [messages objectsAtIndexes:indexes];
 }
 
 - (void)resetRedisplayMessagesBySession {
@@ -463,13 +676,9 @@ static BOOL _isInAppMessagingPaused = false;
         }
     }
 
-    if ([messagesIdToRemove count] > 0) {
-        NSMutableDictionary <NSString *, OSInAppMessageInternal *> * newRedisplayDictionary = [_redisplayedInAppMessages mutableCopy];
-        for (NSString * messageId in messagesIdToRemove) {
-            [newRedisplayDictionary removeObjectForKey:messageId];
-        }
-
-        [OneSignalUserDefaults.initStandard saveCodeableDataForKey:OS_IAM_REDISPLAY_DICTIONARY withValue:newRedisplayDictionary];
+    for (NSString *messageId in messagesIdToRemove) {
+        [_redisplayedInAppMessages removeObjectForKey:messageId];
+        [self.stateStore removeRedisplayedMessageWithId:messageId];
     }
 }
 
@@ -597,10 +806,6 @@ static BOOL _isInAppMessagingPaused = false;
 
 - (void)showMessage:(OSInAppMessageInternal *)message {
     self.viewController = [[OSInAppMessageViewController alloc] initWithMessage:message delegate:self];
-    if (message.hasLiquid && !self.calledLoadTags) {
-        self.viewController.waitForTags = YES;
-        [self loadTags];
-    }
     dispatch_async(dispatch_get_main_queue(), ^{
         [[self.viewController view] setNeedsLayout];
     });
@@ -614,13 +819,6 @@ static BOOL _isInAppMessagingPaused = false;
     }
 }
 
-- (void)loadTags {
-    self.calledLoadTags = YES;
-    // TODO: should we always pull new tags?
-    // For now we aren't pulling new tags and we are just using what is already on the user
-    // I am leaving the logic for waiting for tags to be pulled in case this changes
-    self.viewController.waitForTags = NO;
-}
 - (void)messageViewPageImpressionRequest:(OSInAppMessageInternal *)message withPageId:(NSString *)pageId {
     if (message.isPreview) {
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Not sending page impression for preview message. ID: %@",pageId]];
@@ -642,27 +840,11 @@ static BOOL _isInAppMessagingPaused = false;
     [self.viewedPageIDs addObject:messagePrefixedPageId];
     
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Page Impression Request page id: %@",pageId]];
-    // Create the request and attach a payload to it
-    let metricsRequest = [OSRequestInAppMessagePageViewed withAppId:OneSignalIdentifiers.currentAppId
-                                                       withPlayerId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
-                                                      withMessageId:message.messageId
-                                                         withPageId:pageId
-                                                       forVariantId:message.variantId];
-
-    [OneSignalCoreImpl.sharedClient executeRequest:metricsRequest
-                                       onSuccess:^(NSDictionary *result) {
-        NSString *successMessage = [NSString stringWithFormat:@"In App Message with message id: %@ and page id: %@, successful POST page impression update with result: %@", message.messageId, pageId, result];
-                                           [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:successMessage];
-                                            // If the post was successful, save the updated viewedPageIds set
-                                            [OneSignalUserDefaults.initStandard saveSetForKey:OS_IAM_PAGE_IMPRESSIONED_SET_KEY withValue:self.viewedPageIDs];
-                                       }
-                                       onFailure:^(OneSignalClientError *error) {
-        NSString *errorMessage = [NSString stringWithFormat:@"In App Message with message id: %@ and page id: %@, failed POST page impression update with error: %@", message.messageId, pageId, error.message];
-                                            [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:errorMessage];
-                                            if (message) {
-                                                [self.viewedPageIDs removeObject:messagePrefixedPageId];
-                                            }
-                                       }];
+    [self.analyticsQueue enqueueEvent:[OSInAppMessageAnalyticsEvent pageViewWithAppId:OneSignalIdentifiers.currentAppId
+                                                                       subscriptionId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
+                                                                            messageId:message.messageId
+                                                                            variantId:message.variantId
+                                                                               pageId:pageId]];
 }
 
 - (BOOL)shouldSendImpression:(OSInAppMessageInternal *)message {
@@ -682,27 +864,10 @@ static BOOL _isInAppMessagingPaused = false;
     // Add messageId to impressionedInAppMessages
     [self.impressionedInAppMessages addObject:message.messageId];
     
-    // Create the request and attach a payload to it
-    let metricsRequest = [OSRequestInAppMessageViewed withAppId:OneSignalIdentifiers.currentAppId
-                                                   withPlayerId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
-                                                  withMessageId:message.messageId
-                                                   forVariantId:message.variantId];
-    
-    [OneSignalCoreImpl.sharedClient executeRequest:metricsRequest
-                                       onSuccess:^(NSDictionary *result) {
-                                           NSString *successMessage = [NSString stringWithFormat:@"In App Message with id: %@, successful POST impression update with result: %@", message.messageId, result];
-                                           [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:successMessage];
-                                           
-                                           // If the post was successful, save the updated impressionedInAppMessages set
-                                           [OneSignalUserDefaults.initStandard saveSetForKey:OS_IAM_IMPRESSIONED_SET_KEY withValue:self.impressionedInAppMessages];
-                                       }
-                                       onFailure:^(OneSignalClientError *error) {
-                                           NSString *errorMessage = [NSString stringWithFormat:@"In App Message with id: %@, failed POST impression update with error: %@", message.messageId, error.message];
-                                           [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:errorMessage];
-                                           
-                                           // If the post failed, remove the messageId from the impressionedInAppMessages set
-                                           [self.impressionedInAppMessages removeObject:message.messageId];
-                                       }];
+    [self.analyticsQueue enqueueEvent:[OSInAppMessageAnalyticsEvent impressionWithAppId:OneSignalIdentifiers.currentAppId
+                                                                         subscriptionId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
+                                                                              messageId:message.messageId
+                                                                              variantId:message.variantId]];
 }
 
 /*
@@ -713,15 +878,45 @@ static BOOL _isInAppMessagingPaused = false;
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Not evaluating in app messages while paused"];
         return;
     }
+    if (!self.hasLoadedState) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Not evaluating in app messages until their state is loaded"];
+        return;
+    }
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Evaluating in app messages"];
     for (OSInAppMessageInternal *message in self.messages) {
-        if ([self.triggerController messageMatchesTriggers:message]) {
-            // Make changes to IAM if redisplay available
-            [self setDataForRedisplay:message];
-            // Should we show the in app message
-            if ([self shouldShowInAppMessage:message]) {
-                [self presentInAppMessage:message];
-            }
+        [self evaluateMessage:message];
+    }
+}
+
+/*
+ Checks to see if any of the messages using the changed trigger keys should be shown now
+ Messages without triggers are evaluated as well, as before the index they were re-evaluated on every trigger change
+ */
+- (void)evaluateMessagesWithTriggerKeys:(NSArray<NSString *> *)keys {
+    if (_isInAppMessagingPaused) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Not evaluating in app messages while paused"];
+        return;
+    }
+    if (!self.hasLoadedState) {
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Not evaluating in app messages until their state is loaded"];
+        return;
+    }
+    let messages = self.messages;
+    let indexes = [self indexesOfMessagesWithTriggerKeys:keys];
+    [indexes addIndexes:self.untriggeredMessageIndexes];
+    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Evaluating %lu in app messages for changed triggers: %@", (unsigned long)indexes.count, keys]];
+    for (OSInAppMessageInternal *message in [messages objectsAtIndexes:indexes]) {
+        [self evaluateMessage:message];
+    }
+}
+
+- (void)evaluateMessage:(OSInAppMessageInternal *)message {
+    if ([self.triggerController messageMatchesTriggers:message]) {
+        // Make changes to IAM if redisplay available
+        [self setDataForRedisplay:message];
+        // Should we show the in app message, its triggers were just matched
+        if ([self shouldShowMatchedInAppMessage:message]) {
+            [self presentInAppMessage:message];
         }
     }
 }
@@ -765,9 +960,11 @@ static BOOL _isInAppMessagingPaused = false;
             [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"setDataForRedisplay clear arrays"];
 
             [self.seenInAppMessages removeObject:message.messageId];
+            [self.stateStore removeIdentifier:message.messageId fromSet:OSInAppMessageStateSetSeen];
             [self.impressionedInAppMessages removeObject:message.messageId];
+            [self.stateStore removeIdentifier:message.messageId fromSet:OSInAppMessageStateSetImpressioned];
             [self.viewedPageIDs removeAllObjects];
-            [OneSignalUserDefaults.initStandard saveSetForKey:OS_IAM_PAGE_IMPRESSIONED_SET_KEY withValue:self.viewedPageIDs];
+            [self.stateStore removeAllIdentifiersFromSet:OSInAppMessageStateSetViewedPages];
             [message clearClickIds];
             return;
         }
@@ -791,11 +988,14 @@ static BOOL _isInAppMessagingPaused = false;
  Checks if the IAM matches any triggers or if it exists in cached seenInAppMessages set
  */
 - (BOOL)shouldShowInAppMessage:(OSInAppMessageInternal *)message {
+    return [self.triggerController messageMatchesTriggers:message] &&
+           [self shouldShowMatchedInAppMessage:message];
+}
+
+- (BOOL)shouldShowMatchedInAppMessage:(OSInAppMessageInternal *)message {
     return ![self.seenInAppMessages containsObject:message.messageId] &&
-           [self.triggerController messageMatchesTriggers:message] &&
            ![message isFinished] &&
            OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId != nil;
-    return true;
 }
 
 - (void)handleMessageActionWithURL:(OSInAppMessageClickResult *)action {
@@ -820,9 +1020,8 @@ static BOOL _isInAppMessagingPaused = false;
  *   - At least one Trigger has changed
  */
 - (void)evaluateRedisplayedInAppMessages:(NSArray<NSString *> *)newTriggersKeys {
-    for (OSInAppMessageInternal *message in _messages) {
-        if ([_redisplayedInAppMessages objectForKey:message.messageId] &&
-            [self.triggerController hasSharedTriggers:message newTriggersKeys:newTriggersKeys]) {
+    for (OSInAppMessageInternal *message in [self messagesWithTriggerKeys:newTriggersKeys]) {
+        if ([_redisplayedInAppMessages objectForKey:message.messageId]) {
               message.isTriggerChanged = true;
         }
     }
@@ -877,7 +1076,7 @@ static BOOL _isInAppMessagingPaused = false;
             }
             OSInAppMessageInternal *showingIAM = self.messageDisplayQueue.firstObject;
             [self.seenInAppMessages addObject:showingIAM.messageId];
-            [OneSignalUserDefaults.initStandard saveSetForKey:OS_IAM_SEEN_SET_KEY withValue:self.seenInAppMessages];
+            [self.stateStore addIdentifier:showingIAM.messageId toSet:OSInAppMessageStateSetSeen];
             [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Dismissing IAM save seenInAppMessages: %@", _seenInAppMessages]];
             // Remove dismissed IAM from messageDisplayQueue
             [self.messageDisplayQueue removeObjectAtIndex:0];
@@ -953,13 +1152,8 @@ static BOOL _isInAppMessagingPaused = false;
     // Avoid calling the userdefault data again
     [_redisplayedInAppMessages setObject:message forKey:message.messageId];
 
-    [OneSignalUserDefaults.initStandard saveCodeableDataForKey:OS_IAM_REDISPLAY_DICTIONARY withValue:_redisplayedInAppMessages];
+    [self.stateStore saveRedisplayedMessage:message];
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"persistInAppMessageForRedisplay: %@ \nredisplayedInAppMessages: %@", [message description], _redisplayedInAppMessages]];
-
-    let standardUserDefaults = OneSignalUserDefaults.initStandard;
-    let redisplayedInAppMessages = [[NSMutableDictionary alloc] initWithDictionary:[standardUserDefaults getSavedCodeableDataForKey:OS_IAM_REDISPLAY_DICTIONARY defaultValue:[NSMutableDictionary new]]];
-
-    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"persistInAppMessageForRedisplay saved redisplayedInAppMessages: %@", [redisplayedInAppMessages description]]];
 }
 
 - (void)handlePromptActions:(NSArray<NSObject<OSInAppMessagePrompt> *> *)promptActions withMessage:(OSInAppMessageInternal *)inAppMessage {
@@ -1094,27 +1288,43 @@ static BOOL _isInAppMessagingPaused = false;
     // Track clickId per IAM
     [message addClickId:clickId];
     
-    let metricsRequest = [OSRequestInAppMessageClicked withAppId:OneSignalIdentifiers.currentAppId
-                                                    withPlayerId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
-                                                   withMessageId:message.messageId
-                                                    forVariantId:message.variantId
-                                                      withAction:action];
+    [self.analyticsQueue enqueueEvent:[OSInAppMessageAnalyticsEvent clickWithAppId:OneSignalIdentifiers.currentAppId
+                                                                     subscriptionId:OneSignalUserManagerImpl.sharedInstance.pushSubscriptionId
+                                                                          messageId:message.messageId
+                                                                          variantId:message.variantId
+                                                                             action:action]];
+}
 
-   [OneSignalCoreImpl.sharedClient executeRequest:metricsRequest
-                                      onSuccess:^(NSDictionary *result) {
-                                          NSString *successMessage = [NSString stringWithFormat:@"In App Message with id: %@, successful POST click update for click id: %@, with result: %@", message.messageId, action.clickId,  result];
-                                          [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:successMessage];
+#pragma mark OSInAppMessageAnalyticsQueueDelegate Methods
 
-                                          // Save the updated clickedClickIds since click was tracked successfully
-                                          [OneSignalUserDefaults.initStandard saveSetForKey:OS_IAM_CLICKED_SET_KEY withValue:self.clickedClickIds];
-                                      }
-                                      onFailure:^(OneSignalClientError *error) {
-                                          NSString *errorMessage = [NSString stringWithFormat:@"In App Message with id: %@, failed POST click update for click id: %@, with error: %@", message.messageId, action.clickId, error.message];
-                                          [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:errorMessage];
+- (void)analyticsQueue:(OSInAppMessageAnalyticsQueue *)queue didDeliverEvent:(OSInAppMessageAnalyticsEvent *)event {
+    // Save the event once it is tracked, so it is not sent again after a restart
+    switch (event.type) {
+        case OSInAppMessageAnalyticsEventTypeImpression:
+            [self.stateStore addIdentifier:event.messageId toSet:OSInAppMessageStateSetImpressioned];
+            break;
+        case OSInAppMessageAnalyticsEventTypePageView:
+            [self.stateStore addIdentifier:[event.messageId stringByAppendingString:event.identifier] toSet:OSInAppMessageStateSetViewedPages];
+            break;
+        case OSInAppMessageAnalyticsEventTypeClick:
+            [self.stateStore addIdentifier:event.identifier toSet:OSInAppMessageStateSetClicked];
+            break;
+    }
+}
 
-                                          // Remove clickId from local clickedClickIds since click was not tracked
-                                          [self.clickedClickIds removeObject:action.clickId];
-                                      }];
+- (void)analyticsQueue:(OSInAppMessageAnalyticsQueue *)queue didDropEvent:(OSInAppMessageAnalyticsEvent *)event {
+    // The event was not tracked, allow it to be sent again
+    switch (event.type) {
+        case OSInAppMessageAnalyticsEventTypeImpression:
+            [self.impressionedInAppMessages removeObject:event.messageId];
+            break;
+        case OSInAppMessageAnalyticsEventTypePageView:
+            [self.viewedPageIDs removeObject:[event.messageId stringByAppendingString:event.identifier]];
+            break;
+        case OSInAppMessageAnalyticsEventTypeClick:
+            [self.clickedClickIds removeObject:event.identifier];
+            break;
+    }
 }
 
 - (void)sendTagCallWithAction:(OSInAppMessageClickResult *)action {
@@ -1190,9 +1400,8 @@ static BOOL _isInAppMessagingPaused = false;
 }
 
 - (void)makeRedisplayMessagesAvailableWithTriggers:(NSArray<NSString *> *)triggerIds {
-    for (OSInAppMessageInternal *message in self.messages) {
-        if ([self.redisplayedInAppMessages objectForKey:message.messageId]
-            && [_triggerController hasSharedTriggers:message newTriggersKeys:triggerIds]) {
+    for (OSInAppMessageInternal *message in [self messagesWithTriggerKeys:triggerIds]) {
+        if ([self.redisplayedInAppMessages objectForKey:message.messageId]) {
             message.isTriggerChanged = YES;
         }
     }
@@ -1200,10 +1409,10 @@ static BOOL _isInAppMessagingPaused = false;
 
 #pragma mark OSTriggerControllerDelegate Methods
 
-- (void)triggerConditionChanged {
-    // We should re-evaluate all in-app messages
-    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Trigger condition changed"];
-    [self evaluateMessages];
+- (void)triggerConditionChangedForKeys:(NSArray<NSString *> *)keys {
+    // Only the in-app messages using these triggers need to be re-evaluated
+    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"Trigger condition changed for keys: %@", keys]];
+    [self evaluateMessagesWithTriggerKeys:keys];
 }
 
 #pragma mark OSMessagingControllerDelegate Methods
@@ -1277,7 +1486,7 @@ static BOOL _isInAppMessagingPaused = false;
 - (void)messageViewDidSelectAction:(OSInAppMessageInternal *)message withAction:(OSInAppMessageClickResult *)action {}
 - (void)webViewContentFinishedLoading:(OSInAppMessageInternal *)message {}
 #pragma mark OSTriggerControllerDelegate Methods
-- (void)triggerConditionChanged {}
+- (void)triggerConditionChangedForKeys:(NSArray<NSString *> *)keys {}
 - (void)dynamicTriggerCompleted:(NSString *)triggerId {}
 
 @end
@@ -34,20 +34,22 @@ NS_ASSUME_NONNULL_BEGIN
 @protocol OSTriggerControllerDelegate <NSObject>
 
 /*
- Called when a dynamic trigger timer ends
+ Called when the app changes trigger values or when dynamic trigger timers end,
+ only messages using these keys (trigger properties or triggerIds) can be affected
  The message should be shown (assuming no other triggers are false for that message)
- It is also called when the app changes trigger values
  */
-- (void)triggerConditionChanged;
+- (void)triggerConditionChangedForKeys:(NSArray<NSString *> *)keys;
 - (void)dynamicTriggerCompleted:(NSString *)triggerId;
 @end
 
 @interface OSTriggerController : NSObject <OSDynamicTriggerControllerDelegate>
 
 @property (weak, nonatomic) id<OSTriggerControllerDelegate> delegate;
+// Holds dynamic trigger timers ending while an in-app message is showing until it is dismissed
+@property (nonatomic) BOOL dynamicTriggersPaused;
 
 - (BOOL)messageMatchesTriggers:(OSInAppMessageInternal *)message;
-- (BOOL)hasSharedTriggers:(OSInAppMessageInternal *)message newTriggersKeys:(NSArray<NSString *> *)newTriggersKeys;
+- (BOOL)messageMatchesNonDynamicTriggers:(OSInAppMessageInternal *)message;
 - (BOOL)messageHasOnlyDynamicTriggers:(OSInAppMessageInternal *)message;
 - (void)addTriggers:(NSDictionary<NSString *, id> *)triggers;
 - (void)removeTriggersForKeys:(NSArray<NSString *> *)keys;
@@ -29,8 +29,52 @@
 #import "OSInAppMessagingDefines.h"
 #import "OSMacros.h"
 
+/*
+ A trigger value set by the app, resolved once when it is added so evaluating
+ the triggers of every message against it does not inspect or convert it again
+ */
+@interface OSTriggerValue : NSObject
+@property (strong, nonatomic, nullable) NSNumber *number;
+@property (strong, nonatomic, nullable) NSString *string;
+@property (strong, nonatomic, nullable) NSArray *array;
+// Number parsed from a string value, 0 if it does not parse
+@property (nonatomic) double numericValue;
+@property (strong, nonatomic, nullable) NSString *valueDescription;
++ (instancetype)valueWithObject:(id)object;
+@end
+
+@implementation OSTriggerValue
+
++ (NSNumberFormatter *)numberFormatter {
+    static NSNumberFormatter *formatter;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        formatter = [NSNumberFormatter new];
+        formatter.numberStyle = NSNumberFormatterDecimalStyle;
+    });
+    return formatter;
+}
+
++ (instancetype)valueWithObject:(id)object {
+    let value = [OSTriggerValue new];
+    if ([object isKindOfClass:[NSNumber class]]) {
+        value.number = object;
+        value.numericValue = [object doubleValue];
+    } else if ([object isKindOfClass:[NSString class]]) {
+        value.string = object;
+        value.numericValue = [[self.numberFormatter numberFromString:object] doubleValue];
+    } else if ([object isKindOfClass:[NSArray class]]) {
+        value.array = object;
+    }
+    value.valueDescription = [object description];
+    return value;
+}
+
+@end
+
 @interface OSTriggerController ()
 @property (strong, nonatomic, nonnull) NSMutableDictionary<NSString *, id> *triggers;
+@property (strong, nonatomic, nonnull) NSMutableDictionary<NSString *, OSTriggerValue *> *triggerValues;
 @property (strong, nonatomic, nonnull) OSDynamicTriggerController *dynamicTriggerController;
 @end
 
@@ -39,6 +83,7 @@
 - (instancetype _Nonnull)init {
     if (self = [super init]) {
         self.triggers = [NSMutableDictionary<NSString *, id> new];
+        self.triggerValues = [NSMutableDictionary<NSString *, OSTriggerValue *> new];
         self.dynamicTriggerController = [OSDynamicTriggerController new];
         self.dynamicTriggerController.delegate = self;
     }
@@ -50,17 +95,21 @@
 - (void)addTriggers:(NSDictionary<NSString *, id> *)triggers {
     @synchronized (self.triggers) {
         [self.triggers addEntriesFromDictionary:triggers];
+        for (NSString *key in triggers)
+            self.triggerValues[key] = [OSTriggerValue valueWithObject:triggers[key]];
         
-        [self.delegate triggerConditionChanged];
+        [self.delegate triggerConditionChangedForKeys:triggers.allKeys];
     }
 }
 
 - (void)removeTriggersForKeys:(NSArray<NSString *> *)keys {
     @synchronized (self.triggers) {
-        for (NSString *key in keys)
+        for (NSString *key in keys) {
             [self.triggers removeObjectForKey:key];
+            [self.triggerValues removeObjectForKey:key];
+        }
         
-        [self.delegate triggerConditionChanged];
+        [self.delegate triggerConditionChangedForKeys:keys];
     }
 }
 
@@ -70,27 +119,6 @@
     }
 }
 
-/*
- * Part of redisplay logic
- *
- * If trigger key is part of message triggers, then return true, otherwise false
- */
-- (BOOL)hasSharedTriggers:(OSInAppMessageInternal *)message newTriggersKeys:(NSArray<NSString *> *)newTriggersKeys {
-    for (NSString *triggerKey in newTriggersKeys) {
-        for (NSArray <OSTrigger *> *andConditions in message.triggers) {
-            for (OSTrigger *trigger in andConditions) {
-                // Dynamic triggers depends on triggerId
-                // Common triggers changed by user depends on property
-                if ([triggerKey isEqual:trigger.property] || [triggerKey isEqualToString:trigger.triggerId]) {
-                    // At least one trigger has changed
-                    return YES;
-                }
-            }
-        }
-    }
-    return NO;
-}
-
 /*
  * Part of redisplay logic
  *
@@ -102,7 +130,7 @@
 
     for (NSArray <OSTrigger *> *andConditions in message.triggers) {
         for (OSTrigger *trigger in andConditions) {
-            if ([trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_CUSTOM])
+            if (trigger.isCustom)
                 // At least one trigger is not dynamic
                 return false;
          }
@@ -139,15 +167,12 @@
     for (NSArray <OSTrigger *> *conditions in message.triggers) {
 
         // Dynamic triggers should be handled after looping through all other triggers
-        NSMutableArray<OSTrigger *> *dynamicTriggers = [NSMutableArray new];
-        
+        var hasDynamicTriggers = false;
         var foundFalseTrigger = false;
-        for (int i = 0; i < conditions.count; i++) {
-            let trigger = conditions[i];
-            
-            if (OS_IS_DYNAMIC_TRIGGER_KIND(trigger.kind))
-                [dynamicTriggers addObject:trigger];
-            else if (![self evaluateTrigger:trigger forMessage:message]) {
+        for (OSTrigger *trigger in conditions) {
+            if (trigger.isDynamic)
+                hasDynamicTriggers = true;
+            else if (![self evaluateTrigger:trigger]) {
                 foundFalseTrigger = true;
                 break;
             }
@@ -156,7 +181,7 @@
         // If we found a trigger that evaluates to false, loop to the next AND block
         if (foundFalseTrigger)
             continue;
-        else if (dynamicTriggers.count == 0) {
+        else if (!hasDynamicTriggers) {
             // No trigger was false and there are no triggers left to evaluate, so the
             // AND block is true and we should return true.
             return true;
@@ -164,45 +189,73 @@
         
         // If we reach this point, all normal (non-time-based) triggers evaluated to true
         // now we can start setting up timers if needed
-        for (int i = 0; i < dynamicTriggers.count; i++) {
-            let trigger = dynamicTriggers[i];
-            
+        var foundUnfiredDynamicTrigger = false;
+        for (OSTrigger *trigger in conditions) {
             // Even if the trigger evaluates as "false" now, it may become true in the future
             // Ex. if it's a session-duration trigger that launches a timer
-            if (![self.dynamicTriggerController dynamicTriggerShouldFire:trigger withMessageId:message.messageId])
+            if (trigger.isDynamic && ![self.dynamicTriggerController dynamicTriggerShouldFire:trigger withMessageId:message.messageId]) {
+                foundUnfiredDynamicTrigger = true;
                 break;
-            else if (i == dynamicTriggers.count - 1)
-                return true;
+            }
         }
+        if (!foundUnfiredDynamicTrigger)
+            return true;
     }
     return false;
 }
 
-- (BOOL)evaluateTrigger:(OSTrigger *)trigger forMessage:(OSInAppMessageInternal *)message {
-    if (!self.triggers[trigger.property] && [trigger.kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_CUSTOM]) {
+/*
+ Used to prefetch the content of messages likely to display soon
+ Like messageMatchesTriggers: but treats dynamic triggers as true, as they only need time to pass,
+ and does not start their timers
+ */
+- (BOOL)messageMatchesNonDynamicTriggers:(OSInAppMessageInternal *)message {
+    if (message.triggers.count == 0)
+        return true;
+    for (NSArray <OSTrigger *> *conditions in message.triggers) {
+        var foundFalseTrigger = false;
+        for (OSTrigger *trigger in conditions) {
+            if (!trigger.isDynamic && ![self evaluateTrigger:trigger]) {
+                foundFalseTrigger = true;
+                break;
+            }
+        }
+        if (!foundFalseTrigger)
+            return true;
+    }
+    return false;
+}
+
+/*
+ Both the trigger and the value set by the app are resolved ahead of time,
+ so this only compares them and does not allocate
+ */
+- (BOOL)evaluateTrigger:(OSTrigger *)trigger {
+    let realValue = self.triggerValues[trigger.property];
+    let operatorType = trigger.operatorType;
+
+    if (!realValue && trigger.isCustom) {
         // The value doesn't exist
 
         // Only NotExists operator should return true for non-existent values
-        return trigger.operatorType == OSTriggerOperatorTypeNotExists;
+        return operatorType == OSTriggerOperatorTypeNotExists;
 
-    } else if (trigger.operatorType == OSTriggerOperatorTypeExists) {
+    } else if (operatorType == OSTriggerOperatorTypeExists) {
         return true;
-    } else if (trigger.operatorType == OSTriggerOperatorTypeNotExists) {
+    } else if (operatorType == OSTriggerOperatorTypeNotExists) {
         return false;
     }
     
     // If we reach this point, the trigger has been set locally
-    id realValue = self.triggers[trigger.property];
-    
-    if (trigger.operatorType == OSTriggerOperatorTypeContains) {
-        return [self array:realValue containsValue:trigger.value];
-    } else if ([trigger.value isKindOfClass:[NSNumber class]] && [realValue isKindOfClass:[NSNumber class]] &&
-                [self trigger:trigger.value matchesNumericValue:realValue operatorType:trigger.operatorType]) {
+    if (operatorType == OSTriggerOperatorTypeContains) {
+        return [self array:realValue.array containsValue:trigger.value];
+    } else if (trigger.numberValue && realValue.number &&
+                [self trigger:trigger matchesNumber:realValue.number]) {
         return true;
-    } else if ([trigger.value isKindOfClass:[NSString class]] && [realValue isKindOfClass:[NSString class]] &&
-                [self trigger:trigger.value matchesStringValue:realValue operatorType:trigger.operatorType]) {
+    } else if (trigger.stringValue && realValue.string &&
+                [self trigger:trigger.stringValue matchesStringValue:realValue.string operatorType:operatorType]) {
         return true;
-    } else if ([self triggerMatchesFlex:trigger matchesStringValue:realValue]) {
+    } else if ([self triggerMatchesFlex:trigger matchesValue:realValue]) {
         return true;
     }
 
@@ -225,19 +278,15 @@
     return false;
 }
 
-- (BOOL)triggerMatchesFlex:(OSTrigger *)trigger matchesStringValue:(id)realValue {
-    if (![trigger value])
+- (BOOL)triggerMatchesFlex:(OSTrigger *)trigger matchesValue:(OSTriggerValue *)realValue {
+    if (!trigger.value)
         return false;
     
-    if ([trigger operatorType] == OSTriggerOperatorTypeEqualTo || [trigger operatorType] == OSTriggerOperatorTypeNotEqualTo)
-        return [self trigger:[trigger.value description] matchesStringValue:[realValue description] operatorType:trigger.operatorType];
+    if (trigger.operatorType == OSTriggerOperatorTypeEqualTo || trigger.operatorType == OSTriggerOperatorTypeNotEqualTo)
+        return [self trigger:trigger.valueDescription matchesStringValue:realValue.valueDescription operatorType:trigger.operatorType];
     
-    if ([trigger.value isKindOfClass:[NSNumber class]] && [realValue isKindOfClass:[NSString class]]) {
-        NSNumberFormatter *formatter = [[NSNumberFormatter alloc] init];
-        formatter.numberStyle = NSNumberFormatterDecimalStyle;
-        NSNumber *realValueFormatted = [formatter numberFromString:realValue];
-        return [self trigger:trigger.value matchesNumericValue:realValueFormatted operatorType:trigger.operatorType];
-    }
+    if (trigger.numberValue && realValue.string)
+        return [self trigger:trigger.operatorType matchesNumericValue:realValue.numericValue operand:trigger.numericValue];
     
     return false;
 }
@@ -254,20 +303,31 @@
     return false;
 }
 
-- (BOOL)trigger:(NSNumber *)value matchesNumericValue:(id)realValue operatorType:(OSTriggerOperatorType)operatorType{
+- (BOOL)trigger:(OSTrigger *)trigger matchesNumber:(NSNumber *)realValue {
+    switch (trigger.operatorType) {
+        case OSTriggerOperatorTypeEqualTo:
+            return [realValue isEqualToNumber:trigger.numberValue];
+        case OSTriggerOperatorTypeNotEqualTo:
+            return ![realValue isEqualToNumber:trigger.numberValue];
+        default:
+            return [self trigger:trigger.operatorType matchesNumericValue:[realValue doubleValue] operand:trigger.numericValue];
+    }
+}
+
+- (BOOL)trigger:(OSTriggerOperatorType)operatorType matchesNumericValue:(double)realValue operand:(double)value {
     switch (operatorType) {
         case OSTriggerOperatorTypeGreaterThan:
-            return [realValue doubleValue] > [value doubleValue];
+            return realValue > value;
         case OSTriggerOperatorTypeEqualTo:
-            return [realValue isEqualToNumber:value];
+            return realValue == value;
         case OSTriggerOperatorTypeNotEqualTo:
-            return ![realValue isEqualToNumber:value];
+            return realValue != value;
         case OSTriggerOperatorTypeLessThan:
-            return [realValue doubleValue] < [value doubleValue];
+            return realValue < value;
         case OSTriggerOperatorTypeLessThanOrEqualTo:
-            return [realValue doubleValue] <= [value doubleValue];
+            return realValue <= value;
         case OSTriggerOperatorTypeGreaterThanOrEqualTo:
-            return [realValue doubleValue] >= [value doubleValue];
+            return realValue >= value;
         case OSTriggerOperatorTypeExists:
         case OSTriggerOperatorTypeNotExists:
         case OSTriggerOperatorTypeContains:
@@ -276,8 +336,16 @@
     return false;
 }
 
-- (void)dynamicTriggerFired {
-    [self.delegate triggerConditionChanged];
+- (BOOL)dynamicTriggersPaused {
+    return self.dynamicTriggerController.isPaused;
+}
+
+- (void)setDynamicTriggersPaused:(BOOL)paused {
+    self.dynamicTriggerController.paused = paused;
+}
+
+- (void)dynamicTriggersFired:(NSArray<NSString *> *)triggerIds {
+    [self.delegate triggerConditionChangedForKeys:triggerIds];
 }
 
 - (void)dynamicTriggerCompleted:(NSString *)triggerId {
@@ -39,6 +39,15 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) OSTriggerOperatorType operatorType;
 @property (strong, nonatomic, nullable) id value;
 
+// Resolved once from kind and value when they are set, so evaluating the trigger does not inspect them again
+@property (nonatomic, readonly) BOOL isCustom;
+@property (nonatomic, readonly) BOOL isDynamic;
+@property (strong, nonatomic, readonly, nullable) NSNumber *numberValue;
+@property (nonatomic, readonly) double numericValue;
+@property (strong, nonatomic, readonly, nullable) NSString *stringValue;
+// The value as a string, used to compare values of different types
+@property (strong, nonatomic, readonly, nullable) NSString *valueDescription;
+
 @end
 
 NS_ASSUME_NONNULL_END
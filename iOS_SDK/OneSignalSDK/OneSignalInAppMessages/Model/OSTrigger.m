@@ -30,6 +30,20 @@
 
 @implementation OSTrigger
 
+- (void)setKind:(NSString *)kind {
+    _kind = kind;
+    _isCustom = [kind isEqualToString:OS_DYNAMIC_TRIGGER_KIND_CUSTOM];
+    _isDynamic = OS_IS_DYNAMIC_TRIGGER_KIND(kind);
+}
+
+- (void)setValue:(id)value {
+    _value = value;
+    _numberValue = [value isKindOfClass:[NSNumber class]] ? value : nil;
+    _numericValue = [_numberValue doubleValue];
+    _stringValue = [value isKindOfClass:[NSString class]] ? value : nil;
+    _valueDescription = [value description];
+}
+
 + (instancetype)instanceWithData:(NSData *)data {
     NSError *error;
     let json = (NSDictionary *)[NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingAllowFragments error:&error];
@@ -112,10 +126,10 @@
 - (id)initWithCoder:(NSCoder *)decoder {
     if (self = [super init]) {
         _triggerId = [decoder decodeObjectForKey:@"triggerId"];
-        _kind = [decoder decodeObjectForKey:@"kind"];
+        self.kind = [decoder decodeObjectForKey:@"kind"];
         _property = [decoder decodeObjectForKey:@"property"];
         _operatorType = (OSTriggerOperatorType)[decoder decodeIntForKey:@"operatorType"];
-        _value = [decoder decodeObjectForKey:@"value"];
+        self.value = [decoder decodeObjectForKey:@"value"];
     }
     return self;
 }
@@ -76,6 +76,41 @@ typedef NS_ENUM(NSUInteger, OSTriggerOperatorType) {
 #define OS_IAM_REDISPLAY_DICTIONARY @"OS_IAM_REDISPLAY_DICTIONARY"
 #define OS_IAM_TIME_SINCE_LAST_MESSAGE_KEY @"OS_IAM_TIME_SINCE_LAST_MESSAGE"
 
+// In-app message display state (seen, impressions, clicks, pages and redisplay), in the app's Application Support directory
+#define OS_IAM_STATE_DIRECTORY @"OneSignal/InAppMessageState"
+// The journal is folded into the snapshot after this many records
+#define OS_IAM_STATE_JOURNAL_COMPACTION_THRESHOLD 256
+// Maximum time to keep IAM redisplay and tracking state - current value: six months in seconds
+#define OS_IAM_MAX_CACHE_TIME (6 * 30 * 24 * 60 * 60)
+
+// Impressions, page views and clicks waiting to be sent, in the display state directory
+#define OS_IAM_ANALYTICS_QUEUE_FILE @"analytics_queue.plist"
+// Events queued within this window after the first one are sent together
+#define OS_IAM_ANALYTICS_FLUSH_INTERVAL 2.0
+// Longest wait before retrying events after a failed send, unless the server asks for longer
+#define OS_IAM_ANALYTICS_MAX_RETRY_DELAY 300.0
+// An event is dropped once the server has failed it this many times, so it does not hold back the events behind it
+#define OS_IAM_ANALYTICS_MAX_ATTEMPTS 10
+// An event that fails after being queued this long is dropped, even if it never reached the server, ie: while offline
+#define OS_IAM_ANALYTICS_MAX_EVENT_AGE (7 * 24 * 60 * 60)
+
+// In-app message content cache, in the app's Caches directory
+#define OS_IAM_CONTENT_CACHE_DIRECTORY @"OneSignal/InAppMessageContent"
+#define OS_IAM_CONTENT_CACHE_MAX_BYTES (5 * 1024 * 1024)
+// How long reading content waits before persisting the new last access times, so displaying a message does not write the index
+#define OS_IAM_CONTENT_CACHE_INDEX_SAVE_DELAY_SECONDS 5.0
+// The most messages whose content is prefetched after fetching the message list
+#define OS_IAM_PREFETCH_MAX_MESSAGES 10
+
+// The last fetched in-app message list, in the app's Caches directory
+#define OS_IAM_LIST_CACHE_DIRECTORY @"OneSignal/InAppMessageList"
+
+// The most parsed liquid templates kept in memory, one per message variant
+#define OS_IAM_LIQUID_TEMPLATE_CACHE_COUNT 20
+
+// Dynamic trigger deadlines expiring within the same tick are fired together
+#define OS_DYNAMIC_TRIGGER_TICK_INTERVAL 0.5
+
 // Dynamic trigger kind types
 #define OS_DYNAMIC_TRIGGER_KIND_CUSTOM @"custom"
 #define OS_DYNAMIC_TRIGGER_KIND_SESSION_TIME @"session_time"
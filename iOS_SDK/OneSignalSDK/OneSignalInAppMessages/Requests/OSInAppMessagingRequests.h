@@ -30,6 +30,8 @@
 
 @interface OSRequestGetInAppMessages : OneSignalRequest
 + (instancetype _Nonnull)withSubscriptionId:(NSString * _Nonnull)subscriptionId withSessionDuration:(NSNumber * _Nonnull)sessionDuration withRetryCount:(NSNumber *)retryCount withRywToken:(NSString *)rywToken;
+// Revalidates the cached message list, the server responds 304 if it still has the ETag
++ (instancetype _Nonnull)withSubscriptionId:(NSString * _Nonnull)subscriptionId withSessionDuration:(NSNumber * _Nonnull)sessionDuration withRetryCount:(NSNumber *)retryCount withRywToken:(NSString *)rywToken ifNoneMatch:(NSString * _Nullable)etag;
 @end
 
 @interface OSRequestInAppMessageViewed : OneSignalRequest
@@ -42,6 +44,8 @@
 
 @interface OSRequestLoadInAppMessageContent : OneSignalRequest
 + (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId withMessageId:(NSString * _Nonnull)messageId withVariantId:(NSString * _Nonnull)variant;
+// Revalidates cached content, the server responds 304 if it still has the ETag
++ (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId withMessageId:(NSString * _Nonnull)messageId withVariantId:(NSString * _Nonnull)variant ifNoneMatch:(NSString * _Nullable)etag;
 @end
 
 @interface OSRequestLoadInAppMessagePreviewContent : OneSignalRequest
@@ -54,4 +58,10 @@
                      withMessageId:(NSString * _Nonnull)messageId
                       forVariantId:(NSString * _Nonnull)variantId
                      withAction:(OSInAppMessageClickResult * _Nonnull)action;
++ (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
+                      withPlayerId:(NSString * _Nonnull)playerId
+                     withMessageId:(NSString * _Nonnull)messageId
+                      forVariantId:(NSString * _Nonnull)variantId
+                       withClickId:(NSString * _Nullable)clickId
+                        firstClick:(BOOL)firstClick;
 @end
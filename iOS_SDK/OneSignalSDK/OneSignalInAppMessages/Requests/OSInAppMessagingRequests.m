@@ -38,6 +38,15 @@
                             withSessionDuration:(NSNumber * _Nonnull)sessionDuration
                             withRetryCount:(NSNumber *)retryCount
                             withRywToken:(NSString *)rywToken
+{
+    return [self withSubscriptionId:subscriptionId withSessionDuration:sessionDuration withRetryCount:retryCount withRywToken:rywToken ifNoneMatch:nil];
+}
+
++ (instancetype _Nonnull)   withSubscriptionId:(NSString * _Nonnull)subscriptionId
+                            withSessionDuration:(NSNumber * _Nonnull)sessionDuration
+                            withRetryCount:(NSNumber *)retryCount
+                            withRywToken:(NSString *)rywToken
+                            ifNoneMatch:(NSString * _Nullable)etag
 {
     let request = [OSRequestGetInAppMessages new];
     request.method = GET;
@@ -52,8 +61,11 @@
     if ([retryCount intValue] > 0) {
         headers[@"OneSignal-Retry-Count"] = [retryCount stringValue];
     }
+    headers[@"If-None-Match"] = etag;
 
     request.additionalHeaders = headers;
+    // The list is cached by OSInAppMessageListCache instead of the URL cache
+    request.disableLocalCaching = true;
 
     NSString *appId = OneSignalIdentifiers.currentAppId;
     request.path = [NSString stringWithFormat:@"apps/%@/subscriptions/%@/iams", appId, subscriptionId];
@@ -62,6 +74,10 @@
 @end
 
 @implementation OSRequestInAppMessageViewed
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 + (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
                       withPlayerId:(NSString * _Nonnull)playerId
                      withMessageId:(NSString * _Nonnull)messageId
@@ -83,6 +99,10 @@
 @end
 
 @implementation OSRequestInAppMessagePageViewed
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 + (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
                       withPlayerId:(NSString * _Nonnull)playerId
                      withMessageId:(NSString * _Nonnull)messageId
@@ -106,20 +126,33 @@
 @end
 
 @implementation OSRequestInAppMessageClicked
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 + (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
                       withPlayerId:(NSString * _Nonnull)playerId
                      withMessageId:(NSString * _Nonnull)messageId
                       forVariantId:(NSString * _Nonnull)variantId
                      withAction:(OSInAppMessageClickResult * _Nonnull)action {
+    return [self withAppId:appId withPlayerId:playerId withMessageId:messageId forVariantId:variantId withClickId:action.clickId firstClick:action.firstClick];
+}
+
++ (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
+                      withPlayerId:(NSString * _Nonnull)playerId
+                     withMessageId:(NSString * _Nonnull)messageId
+                      forVariantId:(NSString * _Nonnull)variantId
+                       withClickId:(NSString * _Nullable)clickId
+                        firstClick:(BOOL)firstClick {
     let request = [OSRequestInAppMessageClicked new];
 
     let params = [NSMutableDictionary new];
     params[@"app_id"] = appId;
     params[@"device_type"] = @0;
     params[@"player_id"] = playerId;
-    params[@"click_id"] = action.clickId ?: @"";
+    params[@"click_id"] = clickId ?: @"";
     params[@"variant_id"] = variantId;
-    params[@"first_click"] = @(action.firstClick);
+    params[@"first_click"] = @(firstClick);
 
     request.parameters = params;
     request.method = POST;
@@ -133,12 +166,22 @@
 + (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
                      withMessageId:(NSString * _Nonnull)messageId
                      withVariantId:(NSString * _Nonnull)variantId {
+    return [self withAppId:appId withMessageId:messageId withVariantId:variantId ifNoneMatch:nil];
+}
+
++ (instancetype _Nonnull)withAppId:(NSString * _Nonnull)appId
+                     withMessageId:(NSString * _Nonnull)messageId
+                     withVariantId:(NSString * _Nonnull)variantId
+                       ifNoneMatch:(NSString * _Nullable)etag {
     let request = [OSRequestLoadInAppMessageContent new];
 
     request.method = GET;
     request.parameters = @{@"app_id": appId};
     request.path = [NSString stringWithFormat:@"in_app_messages/%@/variants/%@/html", messageId, variantId];
+    // Content is cached by OSInAppMessageContentCache instead of the URL cache
     request.disableLocalCaching = true;
+    if (etag)
+        request.additionalHeaders = @{@"If-None-Match": etag};
 
     return request;
 }
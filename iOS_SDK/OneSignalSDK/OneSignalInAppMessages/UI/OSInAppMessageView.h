@@ -41,6 +41,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface OSInAppMessageView : UIView <WKNavigationDelegate>
 
 @property (weak, nonatomic, nullable) id<OSInAppMessageViewDelegate> delegate;
+// Whether the web view was taken warm from OSInAppMessageWebViewPool
+@property (nonatomic, readonly) BOOL usesWarmWebView;
 
 - (instancetype _Nonnull)initWithMessage:(OSInAppMessageInternal *)inAppMessage withScriptMessageHandler:(id<WKScriptMessageHandler>)messageHandler;
 - (void)resetWebViewToMaxBoundsAndResizeHeight:(void (^) (NSNumber *newHeight)) completion;
@@ -30,6 +30,9 @@
 #import "OSInAppMessageClickResult.h"
 #import <OneSignalUser/OneSignalUser.h>
 #import "OSMacros.h"
+#import "OSInAppMessageWebViewPool.h"
+#import "OSInAppMessageLiquidTemplate.h"
+#import "OSInAppMessageController.h"
 
 @interface OSInAppMessageView () <UIScrollViewDelegate, WKUIDelegate, WKNavigationDelegate>
 
@@ -37,6 +40,7 @@
 @property (strong, nonatomic, nonnull) WKWebView *webView;
 @property (nonatomic) BOOL loaded;
 @property (nonatomic) BOOL isFullscreen;
+@property (nonatomic, readwrite) BOOL usesWarmWebView;
 @end
 
 
@@ -52,16 +56,25 @@
     return self;
 }
 
-- (NSString *)getTagsString {
-    NSError *error;
-    NSDictionary<NSString *, NSString*> *tags = [OneSignalUserManagerImpl.sharedInstance getTagsInternal];
+- (void)dealloc {
+    // Hand the web view back to the pool so the next message can reuse it
+    let webView = _webView;
+    dispatch_block_t recycle = ^{
+        [OSInAppMessageWebViewPool.sharedInstance recycleWebView:webView];
+    };
+    if (NSThread.isMainThread)
+        recycle();
+    else
+        dispatch_async(dispatch_get_main_queue(), recycle);
+}
+
+- (NSString *)getTagsString:(NSDictionary<NSString *, NSString *> *)tags {
     if (tags == nil || tags.count <= 0 ) {
         [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"[getTagsString] no tags found for the player"];
         return nil;
     }
-    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:tags
-                                                       options:NSJSONWritingPrettyPrinted
-                                                         error:&error];
+    NSError *error;
+    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:tags options:0 error:&error];
     NSString *jsonString;
     if (!jsonData) {
         [OneSignalLog onesignalLog:ONE_S_LL_ERROR message:
@@ -72,31 +85,40 @@
     return jsonString;
 }
 
-- (NSString *)addTagsToHTML:(NSString *)html {
-    NSString *tags = [self getTagsString];
-    if (!tags) {
+- (NSString *)addTagsToHTML:(NSString *)html tags:(NSDictionary<NSString *, NSString *> *)tags {
+    NSString *tagsString = [self getTagsString:tags];
+    if (!tagsString) {
         return html;
     }
     //Script to set the tags for liquid tag substitution
     NSString *newHtml = [NSString stringWithFormat:@"%@ \n\n\
                          <script> \
                             setPlayerTags(%@);\
-                         </script>",html, tags];
+                         </script>",html, tagsString];
     return newHtml;
 }
 
 - (void)loadedHtmlContent:(NSString *)html withBaseURL:(NSURL *)url {
     // UI Update must be done on the main thread
-    NSString *taggedHTML = [self addTagsToHTML:html];
-    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"loadedHtmlContent with Tags: \n%@", taggedHTML]];
-    [self.webView loadHTMLString:taggedHTML baseURL:url];
-    
+    if (!self.message.hasLiquid) {
+        [self.webView loadHTMLString:html baseURL:url];
+        return;
+    }
+
+    // Substitute the tags the template references before WebKit sees the markup
+    NSDictionary<NSString *, NSString *> *tags = [OneSignalUserManagerImpl.sharedInstance getTagsInternal];
+    NSString *variantId = self.message.isPreview ? nil : [self.message variantId];
+    [OSInAppMessageLiquidRenderer.sharedInstance renderHTML:html messageId:self.message.messageId variantId:variantId tags:tags completion:^(NSString *renderedHTML) {
+        if (!renderedHTML) {
+            // Liquid the native pass does not cover is rendered by the message's own script
+            renderedHTML = [self addTagsToHTML:html tags:tags];
+        }
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:[NSString stringWithFormat:@"loadedHtmlContent with Tags: \n%@", renderedHTML]];
+        [self.webView loadHTMLString:renderedHTML baseURL:url];
+    }];
 }
 
 - (void)setupWebviewWithMessageHandler:(id<WKScriptMessageHandler>)handler {
-    let configuration = [WKWebViewConfiguration new];
-    [configuration.userContentController addScriptMessageHandler:handler name:@"iosListener"];
-    
     CGFloat marginSpacing = [OneSignalCoreHelper sizeToScale:MESSAGE_MARGIN];
     
     // WebView should use mainBounds as frame since we need to make sure it spans full possible screen size
@@ -105,7 +127,10 @@
     mainBounds.size.width -= (2.0 * marginSpacing);
     
     // Setup WebView, delegates, and disable scrolling inside of the WebView
-    self.webView = [[WKWebView alloc] initWithFrame:mainBounds configuration:configuration];
+    // The web view comes with the "iosListener" bridge already installed, forwarding to the handler
+    BOOL warm = NO;
+    self.webView = [OSInAppMessageWebViewPool.sharedInstance dequeueWebViewWithFrame:mainBounds messageHandler:handler warm:&warm];
+    self.usesWarmWebView = warm;
     self.webView.backgroundColor = [UIColor clearColor];
     self.webView.opaque = NO;
     // https://webkit.org/blog/13936/enabling-the-inspection-of-web-content-in-apps/
@@ -223,10 +248,10 @@
 
 /*
  Make sure to call this method when the message view gets dismissed
- Otherwise a memory leak will occur and the entire view controller will be leaked
+ Otherwise bridge events from the web view keep reaching the dismissed view controller
  */
 - (void)removeScriptMessageHandler {
-    [self.webView.configuration.userContentController removeScriptMessageHandlerForName:@"iosListener"];
+    [OSInAppMessageWebViewPool.sharedInstance detachMessageHandlerFromWebView:self.webView];
 }
 
 - (void)loadReplacementURL:(NSURL *)url {
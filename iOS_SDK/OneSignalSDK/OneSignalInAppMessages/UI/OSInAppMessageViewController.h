@@ -52,7 +52,6 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (weak, nonatomic, nullable) id<OSInAppMessageViewControllerDelegate> delegate;
 @property (strong, nonatomic, nonnull) OSInAppMessageInternal *message;
-@property (nonatomic) BOOL waitForTags;
 
 - (instancetype _Nonnull)initWithMessage:(OSInAppMessageInternal *)inAppMessage delegate:(id<OSInAppMessageViewControllerDelegate>)delegate;
 - (void)dismissCurrentInAppMessage;
@@ -83,7 +83,7 @@
 // This is a fail safe for cases where global contraints are nil and we try to modify them on dismissal of an IAM
 @property (nonatomic) BOOL didPageRenderingComplete;
 
-// BOOL to track if the message content has loaded before tags have finished loading for liquid templating
+// The HTML of the message content, with the safe area insets script added to full screen messages
 @property (nonatomic, nullable) NSString *pendingHTMLContent;
 
 @property (nonatomic) BOOL useHeightMargin;
@@ -92,6 +92,9 @@
 
 @property (nonatomic) BOOL isFullscreen;
 
+// Uptime when the message was handed to this view controller, used to log how long the message took to render
+@property (nonatomic) NSTimeInterval displayStartTime;
+
 @end
 
 @implementation OSInAppMessageViewController
@@ -104,6 +107,7 @@ OSInAppMessageInternal *_dismissingMessage = nil;
         self.delegate = delegate;
         self.useHeightMargin = YES;
         self.useWidthMargin = YES;
+        self.displayStartTime = NSProcessInfo.processInfo.systemUptime;
         _dismissingMessage = nil;
     }
     
@@ -258,9 +262,6 @@ OSInAppMessageInternal *_dismissingMessage = nil;
 
             let baseUrl = [NSURL URLWithString:OS_IAM_WEBVIEW_BASE_URL];
             [self parseContentData:data];
-            if (self.waitForTags) {
-                return;
-            }
             [self updateDropShadow];
             [self.delegate messageWillDisplay:self.message];
             [self.messageView loadedHtmlContent:self.pendingHTMLContent withBaseURL:baseUrl];
@@ -312,16 +313,6 @@ OSInAppMessageInternal *_dismissingMessage = nil;
     return newHTML;
 }
 
-- (void)setWaitForTags:(BOOL)waitForTags {
-    _waitForTags = waitForTags;
-    if (!waitForTags && self.pendingHTMLContent) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [self.messageView loadedHtmlContent:self.pendingHTMLContent withBaseURL:[NSURL URLWithString:OS_IAM_WEBVIEW_BASE_URL]];
-            self.pendingHTMLContent = nil;
-        });
-    }
-}
-
 - (void)loadMessageContent {
     [self.message loadMessageHTMLContentWithResult:[self messageContentOnSuccess] failure:^(NSError *error) {
         [self encounteredErrorLoadingMessageContent:error];
@@ -753,6 +744,7 @@ OSInAppMessageInternal *_dismissingMessage = nil;
                 self.message.dragToDismissDisabled = event.renderingComplete.dragToDismissDisabled;
                 self.message.position = event.renderingComplete.displayLocation;
                 self.message.height = event.renderingComplete.height;
+                [self logDisplayLatency];
 
                 // The page is fully loaded and should now be displayed
                 // This is only fired once the javascript on the page sends the "rendering_complete" type event
@@ -894,6 +886,15 @@ OSInAppMessageInternal *_dismissingMessage = nil;
     }];
 }
 
+/*
+ Logs the time from the message being handed to this view controller until its page finished rendering
+ A warm web view from OSInAppMessageWebViewPool skips creating the web view and starting its WebContent process
+ */
+- (void)logDisplayLatency {
+    let latency = (NSProcessInfo.processInfo.systemUptime - self.displayStartTime) * 1000.0;
+    [OneSignalLog onesignalLog:ONE_S_LL_DEBUG message:[NSString stringWithFormat:@"In-app message %@ rendered in %.0f ms (warm web view: %@)", self.message.messageId, latency, self.messageView.usesWarmWebView ? @"YES" : @"NO"]];
+}
+
 #pragma mark OSInAppMessageViewDelegate Methods
 - (void)messageViewFailedToLoadMessageContent {
     [self.delegate messageViewControllerWasDismissed:self.message displayed:NO];
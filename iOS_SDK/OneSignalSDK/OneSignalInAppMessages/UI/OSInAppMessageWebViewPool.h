@@ -0,0 +1,59 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import <UIKit/UIKit.h>
+#import <WebKit/WebKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Keeps one warm WKWebView, with its WebContent process started and the "iosListener" bridge installed,
+ so displaying an in-app message does not pay for creating a web view from scratch.
+ Web views are handed back after dismissal and reset before being reused.
+ The pool is emptied on memory warnings. All methods must be called on the main thread, except prewarm.
+ */
+@interface OSInAppMessageWebViewPool : NSObject
+
++ (instancetype)sharedInstance;
+
+@property (nonatomic, readonly) BOOL hasWarmWebView;
+
+// Creates the warm web view the next time the main run loop is idle in the default mode, safe to call from any thread
+- (void)prewarm;
+// Returns the warm web view if there is one, otherwise a new web view with the same setup
+- (WKWebView *)dequeueWebViewWithFrame:(CGRect)frame
+                        messageHandler:(id<WKScriptMessageHandler>)messageHandler
+                                  warm:(BOOL * _Nullable)warm;
+// Stops forwarding bridge messages to the handler, the web view itself is not released
+- (void)detachMessageHandlerFromWebView:(WKWebView *)webView;
+// Clears the web view and keeps it as the warm web view, unless the pool already has one
+- (void)recycleWebView:(WKWebView *)webView;
+- (void)drain;
+
+@end
+
+NS_ASSUME_NONNULL_END
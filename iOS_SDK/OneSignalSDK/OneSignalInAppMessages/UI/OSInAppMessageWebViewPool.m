@@ -0,0 +1,158 @@
+/**
+ * Modified MIT License
+ *
+ * Copyright 2026 OneSignal
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * 1. The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * 2. All copies of substantial portions of the Software may only be used in connection
+ * with services provided by OneSignal.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#import "OSInAppMessageWebViewPool.h"
+#import <OneSignalCore/OneSignalCore.h>
+#import "OSMacros.h"
+
+#define OS_IAM_SCRIPT_MESSAGE_HANDLER_NAME @"iosListener"
+
+/*
+ WKUserContentController retains its script message handlers, so the bridge forwards to a weak target.
+ This lets a pooled web view outlive the view controller it was displaying.
+ */
+@interface OSInAppMessageScriptMessageHandlerProxy : NSObject <WKScriptMessageHandler>
+@property (weak, nonatomic, nullable) id<WKScriptMessageHandler> target;
+@end
+
+@implementation OSInAppMessageScriptMessageHandlerProxy
+
+- (void)userContentController:(WKUserContentController *)userContentController didReceiveScriptMessage:(WKScriptMessage *)message {
+    [self.target userContentController:userContentController didReceiveScriptMessage:message];
+}
+
+@end
+
+@interface OSInAppMessageWebViewPool ()
+@property (strong, nonatomic, nullable) WKWebView *warmWebView;
+@property (strong, nonatomic, nonnull) NSMapTable<WKWebView *, OSInAppMessageScriptMessageHandlerProxy *> *handlerProxies;
+@property (nonatomic) BOOL prewarmScheduled;
+@end
+
+@implementation OSInAppMessageWebViewPool
+
++ (instancetype)sharedInstance {
+    static OSInAppMessageWebViewPool *sharedInstance;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        sharedInstance = [OSInAppMessageWebViewPool new];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _handlerProxies = [NSMapTable weakToStrongObjectsMapTable];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(drain)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (BOOL)hasWarmWebView {
+    return self.warmWebView != nil;
+}
+
+- (void)prewarm {
+    // Blocks performed in the default mode do not run while the user is scrolling or a gesture is tracking
+    CFRunLoopPerformBlock(CFRunLoopGetMain(), kCFRunLoopDefaultMode, ^{
+        if (self.warmWebView)
+            return;
+        [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Prewarming in-app message web view"];
+        self.warmWebView = [self createWebViewWithFrame:UIScreen.mainScreen.bounds];
+    });
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+}
+
+- (WKWebView *)createWebViewWithFrame:(CGRect)frame {
+    let proxy = [OSInAppMessageScriptMessageHandlerProxy new];
+    let configuration = [WKWebViewConfiguration new];
+    [configuration.userContentController addScriptMessageHandler:proxy name:OS_IAM_SCRIPT_MESSAGE_HANDLER_NAME];
+
+    let webView = [[WKWebView alloc] initWithFrame:frame configuration:configuration];
+    [self.handlerProxies setObject:proxy forKey:webView];
+    // Loading a page is what starts the WebContent process
+    [webView loadHTMLString:@"" baseURL:nil];
+    return webView;
+}
+
+- (WKWebView *)dequeueWebViewWithFrame:(CGRect)frame
+                        messageHandler:(id<WKScriptMessageHandler>)messageHandler
+                                  warm:(BOOL *)warm {
+    WKWebView *webView = self.warmWebView;
+    self.warmWebView = nil;
+    if (warm)
+        *warm = webView != nil;
+
+    if (webView)
+        webView.frame = frame;
+    else
+        webView = [self createWebViewWithFrame:frame];
+
+    [self.handlerProxies objectForKey:webView].target = messageHandler;
+    return webView;
+}
+
+- (void)detachMessageHandlerFromWebView:(WKWebView *)webView {
+    [self.handlerProxies objectForKey:webView].target = nil;
+}
+
+- (void)recycleWebView:(WKWebView *)webView {
+    [self detachMessageHandlerFromWebView:webView];
+    [webView stopLoading];
+    [webView removeFromSuperview];
+    if (self.warmWebView || ![self.handlerProxies objectForKey:webView])
+        return;
+
+    // Undo what OSInAppMessageView set up, so the next message starts from the same state as a new web view
+    webView.navigationDelegate = nil;
+    webView.UIDelegate = nil;
+    webView.scrollView.delegate = nil;
+    [webView removeConstraints:webView.constraints];
+    webView.translatesAutoresizingMaskIntoConstraints = true;
+    webView.layer.cornerRadius = 0.0f;
+    webView.layer.masksToBounds = false;
+    [webView loadHTMLString:@"" baseURL:nil];
+
+    self.warmWebView = webView;
+}
+
+- (void)drain {
+    if (!self.warmWebView)
+        return;
+    [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"Releasing warm in-app message web view"];
+    [self.warmWebView stopLoading];
+    self.warmWebView = nil;
+}
+
+@end
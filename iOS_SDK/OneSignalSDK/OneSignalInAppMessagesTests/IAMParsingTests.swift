@@ -0,0 +1,137 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import QuartzCore
+import OneSignalCore
+import OneSignalCoreMocks
+import OneSignalUserMocks
+import OneSignalInAppMessagesMocks
+
+/**
+ Tests that fetched in-app messages are parsed off the main thread, with only the swap of the parsed list on main.
+ */
+final class IAMParsingTests: XCTestCase {
+
+    override func setUpWithError() throws {
+        OneSignalCoreMocks.clearUserDefaults()
+        OneSignalUserMocks.reset()
+        OSMessagingController.removeInstance()
+    }
+
+    override func tearDownWithError() throws {
+        OSMessagingController.removeInstance()
+    }
+
+    private func messageJson(index: Int) -> [String: Any] {
+        var json = IAMTestHelpers.testDefaultMessageJson()
+        json["triggers"] = [
+            (0..<3).map { trigger in
+                [
+                    "kind": OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+                    "property": "prop_\(index)_\(trigger)",
+                    "operator": "greater",
+                    "value": "\(trigger)",
+                    "id": "trigger_\(index)_\(trigger)"
+                ]
+            }
+        ]
+        return json
+    }
+
+    private func response(messages: [[String: Any]]) throws -> OSHTTPResponse {
+        let data = try JSONSerialization.data(withJSONObject: IAMTestHelpers.testFetchMessagesResponse(messages: messages))
+        return OSHTTPResponse(statusCode: 200, headers: nil, data: data)
+    }
+
+    func testResponseIsParsedInTheBackgroundAndSwappedInOnMain() throws {
+        /* Setup */
+        let controller = OSMessagingController.sharedInstance()
+        let messages = (0..<50).map { messageJson(index: $0) }
+
+        /* When */
+        controller.updateInAppMessages(from: try response(messages: messages), subscriptionId: "test-subscription-id")
+
+        /* Then */
+        // Returning before the messages are parsed means the main thread did not parse them
+        XCTAssertEqual(controller.messages.count, 0)
+        OneSignalCoreMocks.waitUntil("Messages were not swapped in") { controller.messages.count == 50 }
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["prop_7_1"]).map { $0.messageId }, [messages[7]["id"] as! String])
+    }
+
+    func testInvalidAndRepeatedMessagesAreDropped() throws {
+        /* Setup */
+        let valid = messageJson(index: 0)
+        let missingVariants = ["id": "missing_variants"]
+
+        /* When */
+        let messageList = OSMessagingController.messageList(from: try response(messages: [valid, missingVariants, valid])) as? NSObject
+
+        /* Then */
+        let messages = messageList?.value(forKey: "messages") as? [OSInAppMessageInternal]
+        XCTAssertEqual(messages?.map { $0.messageId }, [valid["id"] as! String])
+    }
+
+    // MARK: - Benchmarks
+
+    func testBenchmark_parse1000Messages() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let response = try response(messages: (0..<1_000).map { messageJson(index: $0) })
+
+        measure {
+            XCTAssertNotNil(OSMessagingController.messageList(from: response))
+        }
+    }
+
+    /**
+     Measures the longest the main thread goes without running its run loop while a 1,000 message response is processed,
+     compared with parsing the same response on the main thread as before.
+     */
+    func testBenchmark_mainThreadHangWhileProcessing1000Messages() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let controller = OSMessagingController.sharedInstance()
+        let response = try response(messages: (0..<1_000).map { messageJson(index: $0) })
+
+        let parseStart = CACurrentMediaTime()
+        XCTAssertNotNil(OSMessagingController.messageList(from: response))
+        let onMainHang = CACurrentMediaTime() - parseStart
+
+        var lastTick = CACurrentMediaTime()
+        var longestHang: CFTimeInterval = 0
+        let heartbeat = Timer.scheduledTimer(withTimeInterval: 0.001, repeats: true) { _ in
+            let now = CACurrentMediaTime()
+            longestHang = max(longestHang, now - lastTick)
+            lastTick = now
+        }
+        defer { heartbeat.invalidate() }
+
+        controller.updateInAppMessages(from: response, subscriptionId: "test-subscription-id")
+        OneSignalCoreMocks.waitUntil("Messages were not swapped in", timeout: 30) { controller.messages.count == 1_000 }
+
+        print("Main thread hang parsing 1,000 messages on main: \(Int(onMainHang * 1000)) ms, off main: \(Int(longestHang * 1000)) ms")
+        XCTAssertLessThan(longestHang, onMainHang)
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+
+final class OSDeadlineSchedulerTests: XCTestCase {
+
+    private var now: TimeInterval = 1_000
+    private var fired: [[String]] = []
+    private let callbackQueue = DispatchQueue(label: "OSDeadlineSchedulerTests")
+    private var scheduler: OSDeadlineScheduler!
+
+    override func setUpWithError() throws {
+        now = 1_000
+        fired = []
+        scheduler = OSDeadlineScheduler(tickInterval: 1, clock: { [unowned self] in self.now }, callbackQueue: callbackQueue) { [unowned self] keys in
+            self.fired.append(keys.sorted())
+        }
+    }
+
+    private func advance(to time: TimeInterval) {
+        now = time
+        scheduler.fireExpiredDeadlines()
+        // Wait for the handler calls made on the callback queue
+        callbackQueue.sync {}
+    }
+
+    func testDeadlinesFireInOrderOnlyOnceExpired() throws {
+        XCTAssertTrue(scheduler.scheduleKey("late", after: 30))
+        XCTAssertTrue(scheduler.scheduleKey("early", after: 10))
+
+        advance(to: 1_009)
+        XCTAssertEqual(fired, [])
+
+        advance(to: 1_010)
+        XCTAssertEqual(fired, [["early"]])
+        XCTAssertFalse(scheduler.hasDeadline(forKey: "early"))
+        XCTAssertTrue(scheduler.hasDeadline(forKey: "late"))
+
+        advance(to: 1_030)
+        XCTAssertEqual(fired, [["early"], ["late"]])
+        XCTAssertEqual(scheduler.count, 0)
+    }
+
+    func testDeadlinesInTheSameTickAreCoalesced() throws {
+        scheduler.scheduleKey("a", after: 4.2)
+        scheduler.scheduleKey("b", after: 4.9)
+        scheduler.scheduleKey("c", after: 5.1)
+
+        advance(to: 1_005)
+        XCTAssertEqual(fired, [["a", "b"]])
+
+        advance(to: 1_006)
+        XCTAssertEqual(fired, [["a", "b"], ["c"]])
+    }
+
+    func testSchedulingAnAlreadyScheduledKeyIsIgnored() throws {
+        XCTAssertTrue(scheduler.scheduleKey("a", after: 10))
+        XCTAssertFalse(scheduler.scheduleKey("a", after: 2))
+
+        advance(to: 1_002)
+        XCTAssertEqual(fired, [])
+
+        advance(to: 1_010)
+        XCTAssertEqual(fired, [["a"]])
+
+        // Once fired, the key can be scheduled again
+        XCTAssertTrue(scheduler.scheduleKey("a", after: 1))
+    }
+
+    func testExpiredDeadlinesAreHeldWhilePaused() throws {
+        scheduler.scheduleKey("a", after: 1)
+        scheduler.scheduleKey("b", after: 3)
+        scheduler.isPaused = true
+
+        advance(to: 1_005)
+        XCTAssertEqual(fired, [])
+
+        scheduler.isPaused = false
+        callbackQueue.sync {}
+        XCTAssertEqual(fired, [["a", "b"]])
+    }
+
+    func testTimerFiresOnTheBackgroundQueue() throws {
+        let realScheduler = OSDeadlineScheduler(tickInterval: 0.01, clock: nil, callbackQueue: callbackQueue) { [unowned self] keys in
+            self.fired.append(keys.sorted())
+        }
+        realScheduler.scheduleKey("a", after: 0.02)
+        realScheduler.scheduleKey("b", after: 0.02)
+
+        let firedExpectation = XCTNSPredicateExpectation(predicate: NSPredicate { [unowned self] _, _ in
+            self.callbackQueue.sync { !self.fired.isEmpty }
+        }, object: nil)
+        XCTAssertEqual(XCTWaiter.wait(for: [firedExpectation], timeout: 5), .completed)
+        callbackQueue.sync {
+            XCTAssertEqual(fired, [["a", "b"]])
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import OneSignalCore
+import OneSignalCoreMocks
+
+/// Stands in for the OneSignal API, answering with scripted status codes and then 200s.
+/// Records the path of every request in the order it arrives.
+private final class StubAnalyticsProtocol: URLProtocol {
+    static let lock = NSLock()
+    static var statusCodes: [Int] = []
+    static var paths: [String] = []
+
+    static func reset(statusCodes: [Int] = []) {
+        lock.lock()
+        self.statusCodes = statusCodes
+        paths = []
+        lock.unlock()
+    }
+
+    static var receivedPaths: [String] {
+        lock.lock()
+        defer { lock.unlock() }
+        return paths
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        StubAnalyticsProtocol.lock.lock()
+        StubAnalyticsProtocol.paths.append(request.url!.path)
+        let statusCode = StubAnalyticsProtocol.statusCodes.isEmpty ? 200 : StubAnalyticsProtocol.statusCodes.removeFirst()
+        StubAnalyticsProtocol.lock.unlock()
+
+        let response = HTTPURLResponse(url: request.url!, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: nil)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: "{}".data(using: .utf8)!)
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
+private final class RecordingAnalyticsDelegate: NSObject, OSInAppMessageAnalyticsQueueDelegate {
+    var delivered: [String] = []
+    var dropped: [String] = []
+
+    func analyticsQueue(_ queue: OSInAppMessageAnalyticsQueue, didDeliver event: OSInAppMessageAnalyticsEvent) {
+        delivered.append(event.messageId)
+    }
+
+    func analyticsQueue(_ queue: OSInAppMessageAnalyticsQueue, didDrop event: OSInAppMessageAnalyticsEvent) {
+        dropped.append(event.messageId)
+    }
+}
+
+final class OSInAppMessageAnalyticsQueueTests: XCTestCase {
+
+    private var fileURL: URL!
+    private var client: OneSignalClient!
+    private let delegate = RecordingAnalyticsDelegate()
+
+    override func setUpWithError() throws {
+        StubAnalyticsProtocol.reset()
+        fileURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString, isDirectory: true)
+            .appendingPathComponent("analytics_queue.plist")
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubAnalyticsProtocol.self]
+        client = OneSignalClient(sessionConfiguration: configuration)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: fileURL.deletingLastPathComponent())
+    }
+
+    private func makeQueue(flushInterval: TimeInterval = 0.01, maxAttempts: UInt = 5, maxEventAge: TimeInterval = 3_600) -> OSInAppMessageAnalyticsQueue {
+        let queue = OSInAppMessageAnalyticsQueue(fileURL: fileURL, client: client, flushInterval: flushInterval, maxRetryDelay: 0.05, maxAttempts: maxAttempts, maxEventAge: maxEventAge)
+        queue.delegate = delegate
+        return queue
+    }
+
+    private func impression(_ messageId: String) -> OSInAppMessageAnalyticsEvent {
+        return OSInAppMessageAnalyticsEvent.impression(withAppId: "test-app-id", subscriptionId: "test-subscription-id", messageId: messageId, variantId: "en")
+    }
+
+    private func pageView(_ messageId: String, _ pageId: String) -> OSInAppMessageAnalyticsEvent {
+        return OSInAppMessageAnalyticsEvent.pageView(withAppId: "test-app-id", subscriptionId: "test-subscription-id", messageId: messageId, variantId: "en", pageId: pageId)
+    }
+
+    func testEventsAreSentOneAtATimeInQueueOrder() throws {
+        let queue = makeQueue()
+        queue.enqueue(impression("m1"))
+        queue.enqueue(pageView("m2", "p1"))
+        queue.enqueue(pageView("m3", "p2"))
+        queue.enqueue(impression("m4"))
+
+        OneSignalCoreMocks.waitUntil("Events were not delivered") { self.delegate.delivered.count == 4 }
+
+        XCTAssertEqual(delegate.delivered, ["m1", "m2", "m3", "m4"])
+        XCTAssertEqual(StubAnalyticsProtocol.receivedPaths, [
+            "/in_app_messages/m1/impression",
+            "/in_app_messages/m2/pageImpression",
+            "/in_app_messages/m3/pageImpression",
+            "/in_app_messages/m4/impression"
+        ])
+        XCTAssertEqual(queue.count, 0)
+    }
+
+    func testDuplicateEventsAreQueuedOnce() throws {
+        let queue = makeQueue()
+        XCTAssertTrue(queue.enqueue(pageView("m1", "p1")))
+        XCTAssertFalse(queue.enqueue(pageView("m1", "p1")))
+        XCTAssertTrue(queue.enqueue(pageView("m1", "p2")))
+        XCTAssertTrue(queue.enqueue(impression("m1")))
+
+        OneSignalCoreMocks.waitUntil("Events were not delivered") { self.delegate.delivered.count == 3 }
+        XCTAssertEqual(StubAnalyticsProtocol.receivedPaths.count, 3)
+    }
+
+    func testRetryableFailuresAreRetriedWithoutReordering() throws {
+        // Enough server errors to exhaust the client's own reattempts, so the queue has to retry
+        StubAnalyticsProtocol.reset(statusCodes: Array(repeating: 503, count: 8))
+        let queue = makeQueue()
+        queue.enqueue(impression("m1"))
+        queue.enqueue(impression("m2"))
+
+        OneSignalCoreMocks.waitUntil("Events were not delivered") { self.delegate.delivered.count == 2 }
+
+        XCTAssertEqual(delegate.delivered, ["m1", "m2"])
+        XCTAssertEqual(delegate.dropped, [])
+        // At least once: m1 is sent until it succeeds, and m2 is only sent after it
+        let paths = StubAnalyticsProtocol.receivedPaths
+        XCTAssertGreaterThan(paths.count, 2)
+        XCTAssertEqual(paths.filter { $0.contains("/m2/") }.count, 1)
+        XCTAssertTrue(paths.last!.contains("/m2/"))
+    }
+
+    func testRejectedEventsAreDroppedAndTheQueueContinues() throws {
+        StubAnalyticsProtocol.reset(statusCodes: [400])
+        let queue = makeQueue()
+        queue.enqueue(impression("m1"))
+        queue.enqueue(impression("m2"))
+
+        OneSignalCoreMocks.waitUntil("Events were not processed") { self.delegate.delivered.count == 1 }
+
+        XCTAssertEqual(delegate.dropped, ["m1"])
+        XCTAssertEqual(delegate.delivered, ["m2"])
+    }
+
+    func testEventsThatKeepFailingAreDroppedAfterMaxAttempts() throws {
+        // Each attempt exhausts the client's own reattempts
+        StubAnalyticsProtocol.reset(statusCodes: Array(repeating: 503, count: 2 * Int(MAX_ATTEMPT_COUNT)))
+        let queue = makeQueue(maxAttempts: 2)
+        queue.enqueue(impression("m1"))
+        queue.enqueue(impression("m2"))
+
+        OneSignalCoreMocks.waitUntil("Events were not processed") { self.delegate.delivered.count == 1 }
+
+        XCTAssertEqual(delegate.dropped, ["m1"])
+        XCTAssertEqual(delegate.delivered, ["m2"])
+        XCTAssertEqual(StubAnalyticsProtocol.receivedPaths.filter { $0.contains("/m1/") }.count, 2 * Int(MAX_ATTEMPT_COUNT))
+    }
+
+    func testOldEventsAreDroppedWhenTheyFail() throws {
+        // Saved by an earlier launch a week ago
+        let saved: [[String: Any]] = [
+            ["type": 0, "app_id": "test-app-id", "message_id": "m1", "variant_id": "en", "queued_at": Date().timeIntervalSince1970 - 7 * 24 * 60 * 60],
+            ["type": 0, "app_id": "test-app-id", "message_id": "m2", "variant_id": "en"]
+        ]
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try PropertyListSerialization.data(fromPropertyList: saved, format: .binary, options: 0).write(to: fileURL)
+        StubAnalyticsProtocol.reset(statusCodes: Array(repeating: 503, count: Int(MAX_ATTEMPT_COUNT)))
+
+        let queue = makeQueue(maxEventAge: 24 * 60 * 60)
+
+        OneSignalCoreMocks.waitUntil("Events were not processed") { self.delegate.delivered.count == 1 }
+        XCTAssertEqual(delegate.dropped, ["m1"])
+        XCTAssertEqual(delegate.delivered, ["m2"])
+        XCTAssertEqual(queue.count, 0)
+    }
+
+    func testQueuedEventsSurviveARestart() throws {
+        // A flush window longer than the test, so the events are still queued when the app "restarts"
+        let firstLaunch = makeQueue(flushInterval: 3_600)
+        firstLaunch.enqueue(impression("m1"))
+        firstLaunch.enqueue(pageView("m1", "p1"))
+        XCTAssertEqual(firstLaunch.count, 2)
+        XCTAssertEqual(StubAnalyticsProtocol.receivedPaths, [])
+
+        let secondLaunch = makeQueue()
+        OneSignalCoreMocks.waitUntil("Restored events were not delivered") { self.delegate.delivered.count == 2 }
+        XCTAssertEqual(secondLaunch.count, 0)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: fileURL.path))
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+
+final class OSInAppMessageContentCacheTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func contentData(_ html: String) -> Data {
+        return try! JSONSerialization.data(withJSONObject: ["html": html])
+    }
+
+    func testStoreAndReadContent() throws {
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        XCTAssertNil(cache.content(forMessageId: "m1", variantId: "en"))
+
+        cache.storeContent(contentData("<html>1</html>"), etag: "\"v1\"", forMessageId: "m1", variantId: "en")
+
+        XCTAssertEqual(cache.content(forMessageId: "m1", variantId: "en")?["html"] as? String, "<html>1</html>")
+        XCTAssertEqual(cache.etag(forMessageId: "m1", variantId: "en"), "\"v1\"")
+        XCTAssertNil(cache.content(forMessageId: "m1", variantId: "es"))
+    }
+
+    func testIndexPersistsAcrossInstances() throws {
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        cache.storeContent(contentData("<html>1</html>"), etag: "\"v1\"", forMessageId: "m1", variantId: "en")
+
+        let reloaded = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        XCTAssertEqual(reloaded.content(forMessageId: "m1", variantId: "en")?["html"] as? String, "<html>1</html>")
+        XCTAssertEqual(reloaded.etag(forMessageId: "m1", variantId: "en"), "\"v1\"")
+        XCTAssertEqual(reloaded.totalBytes, cache.totalBytes)
+    }
+
+    func testLeastRecentlyUsedContentIsEvictedOverBudget() throws {
+        let data = contentData(String(repeating: "a", count: 100))
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: UInt(data.count * 2))
+
+        cache.storeContent(data, etag: nil, forMessageId: "m1", variantId: "en")
+        cache.storeContent(data, etag: nil, forMessageId: "m2", variantId: "en")
+        // Reading m1 makes m2 the least recently used
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "en"))
+        cache.storeContent(data, etag: nil, forMessageId: "m3", variantId: "en")
+
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "en"))
+        XCTAssertNil(cache.content(forMessageId: "m2", variantId: "en"))
+        XCTAssertNotNil(cache.content(forMessageId: "m3", variantId: "en"))
+        XCTAssertLessThanOrEqual(cache.totalBytes, UInt(data.count * 2))
+    }
+
+    func testReadingContentDoesNotRewriteIndex() throws {
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        cache.indexSaveDelay = 60
+        cache.storeContent(contentData("1"), etag: nil, forMessageId: "m1", variantId: "en")
+        let indexURL = directory.appendingPathComponent("index.plist")
+        let savedIndex = try Data(contentsOf: indexURL)
+
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "en"))
+
+        XCTAssertEqual(try Data(contentsOf: indexURL), savedIndex)
+    }
+
+    func testLastAccessIsPersistedAfterDelay() throws {
+        let data = contentData(String(repeating: "a", count: 100))
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: UInt(data.count * 2))
+        cache.indexSaveDelay = 0.05
+        cache.storeContent(data, etag: nil, forMessageId: "m1", variantId: "en")
+        cache.storeContent(data, etag: nil, forMessageId: "m2", variantId: "en")
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "en"))
+        Thread.sleep(forTimeInterval: 0.2)
+
+        // The read of m1 survives a restart, so m2 is the least recently used
+        let reloaded = OSInAppMessageContentCache(directory: directory, maxBytes: UInt(data.count * 2))
+        reloaded.storeContent(data, etag: nil, forMessageId: "m3", variantId: "en")
+
+        XCTAssertNotNil(reloaded.content(forMessageId: "m1", variantId: "en"))
+        XCTAssertNil(reloaded.content(forMessageId: "m2", variantId: "en"))
+    }
+
+    func testRemoveContentForMessagesNotInList() throws {
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        cache.storeContent(contentData("1"), etag: nil, forMessageId: "m1", variantId: "en")
+        cache.storeContent(contentData("1"), etag: nil, forMessageId: "m1", variantId: "es")
+        cache.storeContent(contentData("2"), etag: nil, forMessageId: "m2", variantId: "en")
+
+        cache.removeContentForMessages(notIn: ["m1"])
+
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "en"))
+        XCTAssertNotNil(cache.content(forMessageId: "m1", variantId: "es"))
+        XCTAssertNil(cache.content(forMessageId: "m2", variantId: "en"))
+    }
+
+    func testRemoveContent() throws {
+        let cache = OSInAppMessageContentCache(directory: directory, maxBytes: 1024 * 1024)
+        cache.storeContent(contentData("1"), etag: "\"v1\"", forMessageId: "m1", variantId: "en")
+        cache.storeContent(contentData("2"), etag: nil, forMessageId: "m2", variantId: "en")
+
+        cache.removeContent(forMessageId: "m1", variantId: "en")
+        XCTAssertNil(cache.content(forMessageId: "m1", variantId: "en"))
+        XCTAssertNil(cache.etag(forMessageId: "m1", variantId: "en"))
+
+        cache.removeAllContent()
+        XCTAssertNil(cache.content(forMessageId: "m2", variantId: "en"))
+        XCTAssertEqual(cache.totalBytes, 0)
+    }
+}
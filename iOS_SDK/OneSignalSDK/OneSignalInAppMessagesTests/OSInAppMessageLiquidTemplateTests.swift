@@ -0,0 +1,106 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+
+final class OSInAppMessageLiquidTemplateTests: XCTestCase {
+
+    func testSubstitutesReferencedTags() throws {
+        let template = OSInAppMessageLiquidTemplate(html: "<p>Hi {{ first_name }}, you have {{points}} points</p>")
+
+        XCTAssertTrue(template.isNativelyRenderable)
+        XCTAssertEqual(template.tagKeys, ["first_name", "points"])
+        XCTAssertEqual(template.render(withTags: ["first_name": "Ada", "points": "12", "unused": "x"]),
+                       "<p>Hi Ada, you have 12 points</p>")
+    }
+
+    func testDefaultFilter() throws {
+        let template = OSInAppMessageLiquidTemplate(html: "<p>Hi {{ first_name | default: \"there\" }}{{ suffix | default: '!' }}</p>")
+
+        XCTAssertEqual(template.render(withTags: nil), "<p>Hi there!</p>")
+        XCTAssertEqual(template.render(withTags: ["first_name": ""]), "<p>Hi there!</p>")
+        XCTAssertEqual(template.render(withTags: ["first_name": "Ada", "suffix": "?"]), "<p>Hi Ada?</p>")
+    }
+
+    func testMissingTagWithoutDefaultIsEmpty() throws {
+        let template = OSInAppMessageLiquidTemplate(html: "<p>Hi {{ first_name }}</p>")
+
+        XCTAssertEqual(template.render(withTags: [:]), "<p>Hi </p>")
+    }
+
+    func testValuesAreEscaped() throws {
+        let template = OSInAppMessageLiquidTemplate(html: "<p>{{ name }}</p>")
+
+        XCTAssertEqual(template.render(withTags: ["name": "<b>\"A&B\"</b>"]), "<p>&lt;b&gt;&quot;A&amp;B&quot;&lt;/b&gt;</p>")
+    }
+
+    func testScriptsAndStylesAreNotRendered() throws {
+        let html = "<style>a{{color:red}}</style><script>var t = '{{ name }}'; if (x) {% raw %}</script><p>{{ name }}</p>"
+        let template = OSInAppMessageLiquidTemplate(html: html)
+
+        XCTAssertTrue(template.isNativelyRenderable)
+        XCTAssertEqual(template.render(withTags: ["name": "Ada"]),
+                       "<style>a{{color:red}}</style><script>var t = '{{ name }}'; if (x) {% raw %}</script><p>Ada</p>")
+    }
+
+    func testUnsupportedLiquidIsLeftToTheMessageScript() throws {
+        let unsupported = [
+            "<p>{% if name %}{{ name }}{% endif %}</p>",
+            "<p>{{ name | upcase }}</p>",
+            "<p>{{- name -}}</p>",
+            "<p>{{ user.name }}</p>",
+            "<p>{{ name </p>",
+            // Without output markup there is nothing to render natively
+            "<p>Hello</p>"
+        ]
+        for html in unsupported {
+            let template = OSInAppMessageLiquidTemplate(html: html)
+            XCTAssertFalse(template.isNativelyRenderable, html)
+            XCTAssertNil(template.render(withTags: ["name": "Ada"]), html)
+        }
+    }
+
+    func testRendererCompletesOnMainQueue() throws {
+        let renderer = OSInAppMessageLiquidRenderer.sharedInstance()
+        renderer.removeAllTemplates()
+
+        let rendered = expectation(description: "rendered")
+        renderer.renderHTML("<p>{{ name }}</p>", messageId: "m1", variantId: "en", tags: ["name": "Ada"]) { html in
+            XCTAssertTrue(Thread.isMainThread)
+            XCTAssertEqual(html, "<p>Ada</p>")
+            rendered.fulfill()
+        }
+        wait(for: [rendered], timeout: 5)
+
+        // The variant's content changed, so its template is parsed again
+        let updated = expectation(description: "updated")
+        renderer.renderHTML("<b>{{ name }}</b>", messageId: "m1", variantId: "en", tags: ["name": "Ada"]) { html in
+            XCTAssertEqual(html, "<b>Ada</b>")
+            updated.fulfill()
+        }
+        wait(for: [updated], timeout: 5)
+    }
+}
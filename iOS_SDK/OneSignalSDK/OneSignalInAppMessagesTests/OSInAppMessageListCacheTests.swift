@@ -0,0 +1,135 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import OneSignalOSCore
+import OneSignalCoreMocks
+import OneSignalOSCoreMocks
+import OneSignalUserMocks
+import OneSignalInAppMessagesMocks
+
+final class OSInAppMessageListCacheTests: XCTestCase {
+
+    private let testSubscriptionId = "test-subscription-id-12345"
+    private let testOneSignalId = "test-onesignal-id-12345"
+    private let testAppId = "test-app-id"
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        OneSignalCoreMocks.clearUserDefaults()
+        OneSignalUserMocks.reset()
+        OSConsistencyManager.shared.reset()
+        OSMessagingController.removeInstance()
+        OneSignalIdentifiers.currentAppId = testAppId
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+        OSMessagingController.removeInstance()
+    }
+
+    private func listBody(messageCount: Int) -> Data {
+        let messages = (0..<messageCount).map { _ in IAMTestHelpers.testDefaultMessageJson() }
+        return try! JSONSerialization.data(withJSONObject: IAMTestHelpers.testFetchMessagesResponse(messages: messages))
+    }
+
+    func testStoreAndReadBody() throws {
+        let cache = OSInAppMessageListCache(directory: directory)
+        XCTAssertNil(cache.body())
+
+        let body = listBody(messageCount: 2)
+        cache.storeBody(body, etag: "\"v1\"", subscriptionId: testSubscriptionId)
+
+        XCTAssertEqual(cache.body(), body)
+        // A new instance reads what the previous launch stored
+        XCTAssertEqual(OSInAppMessageListCache(directory: directory).body(), body)
+    }
+
+    func testEtagIsOnlySentForTheSubscriptionItWasFetchedFor() throws {
+        let cache = OSInAppMessageListCache(directory: directory)
+        cache.storeBody(listBody(messageCount: 1), etag: "\"v1\"", subscriptionId: testSubscriptionId)
+
+        XCTAssertEqual(cache.etag(forSubscriptionId: testSubscriptionId), "\"v1\"")
+        XCTAssertNil(cache.etag(forSubscriptionId: "other-subscription-id"))
+        // The body is still evaluated on launch after the subscription changed
+        XCTAssertNotNil(cache.body())
+    }
+
+    func testRemoveAll() throws {
+        let cache = OSInAppMessageListCache(directory: directory)
+        cache.storeBody(listBody(messageCount: 1), etag: "\"v1\"", subscriptionId: testSubscriptionId)
+
+        cache.removeAll()
+
+        XCTAssertNil(cache.body())
+        XCTAssertNil(cache.etag(forSubscriptionId: testSubscriptionId))
+    }
+
+    /**
+     The list cached by the previous launch is evaluated before the first fetch completes.
+     */
+    func testCachedListIsLoadedBeforeFirstFetch() throws {
+        /* Setup */
+        OSInAppMessageListCache.sharedInstance().storeBody(listBody(messageCount: 2), etag: "\"v1\"", subscriptionId: testSubscriptionId)
+
+        /* Execute */
+        let controller = OSMessagingController.sharedInstance()
+
+        /* Verify */
+        OneSignalCoreMocks.waitUntil("Cached messages were not loaded") { controller.messages.count == 2 }
+        XCTAssertFalse(controller.hasCompletedFirstFetch)
+    }
+
+    /**
+     A 304 for the cached ETag applies the cached list as the fetched list.
+     */
+    func testNotModifiedResponseAppliesCachedList() throws {
+        /* Setup */
+        OSInAppMessageListCache.sharedInstance().storeBody(listBody(messageCount: 3), etag: "\"v1\"", subscriptionId: testSubscriptionId)
+
+        let client = MockOneSignalClient()
+        client.executeInstantaneously = true
+        OneSignalCoreImpl.setSharedClient(client)
+        MockUserRequests.setDefaultCreateAnonUserResponses(with: client, onesignalId: testOneSignalId, subscriptionId: testSubscriptionId)
+        ConsistencyManagerTestHelpers.setDefaultRywToken(id: testOneSignalId)
+        client.setMockFailureResponseForRequest(
+            request: "<OSRequestGetInAppMessages from apps/\(testAppId)/subscriptions/\(testSubscriptionId)/iams>",
+            error: OneSignalClientError(code: 304, message: "not-modified", responseHeaders: nil, response: nil, underlyingError: nil))
+        OSMessagingController.start()
+        let controller = OSMessagingController.sharedInstance()
+
+        /* Execute */
+        OneSignalUserManagerImpl.sharedInstance.start()
+
+        /* Verify */
+        OneSignalCoreMocks.waitUntil("Fetch did not complete") { controller.hasCompletedFirstFetch }
+        XCTAssertEqual(controller.messages.count, 3)
+        let fetch = client.executedRequests.first { $0 is OSRequestGetInAppMessages }
+        XCTAssertEqual(fetch?.additionalHeaders?["If-None-Match"], "\"v1\"")
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+import OneSignalCoreMocks
+import OneSignalInAppMessagesMocks
+
+final class OSInAppMessageStateStoreTests: XCTestCase {
+
+    private let maxAge: TimeInterval = 100
+    private var now: TimeInterval = 1_000
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        OneSignalCoreMocks.clearUserDefaults()
+        now = 1_000
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func makeStore() -> OSInAppMessageStateStore {
+        return OSInAppMessageStateStore(directory: directory, maxAge: maxAge, clock: { [unowned self] in self.now })
+    }
+
+    private func loadState(_ store: OSInAppMessageStateStore) -> OSInAppMessageState {
+        let loaded = expectation(description: "state loaded")
+        var loadedState: OSInAppMessageState?
+        store.loadState { state in
+            loadedState = state
+            loaded.fulfill()
+        }
+        wait(for: [loaded], timeout: 5)
+        return loadedState!
+    }
+
+    private func journalSize() -> Int {
+        let attributes = try? FileManager.default.attributesOfItem(atPath: directory.appendingPathComponent("journal.log").path)
+        return (attributes?[.size] as? Int) ?? 0
+    }
+
+    func testChangesArePersistedAcrossInstances() throws {
+        let store = makeStore()
+        store.addIdentifier("seen_1", to: .seen)
+        store.addIdentifier("seen_2", to: .seen)
+        store.addIdentifier("impression_1", to: .impressioned)
+        store.addIdentifier("click_1", to: .clicked)
+        store.addIdentifier("page_1", to: .viewedPages)
+        store.removeIdentifier("seen_2", from: .seen)
+        store.flush()
+
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.seenMessageIds, ["seen_1"])
+        XCTAssertEqual(state.impressionedMessageIds, ["impression_1"])
+        XCTAssertEqual(state.clickedClickIds, ["click_1"])
+        XCTAssertEqual(state.viewedPageIds, ["page_1"])
+    }
+
+    func testRemoveAllIdentifiersFromSet() throws {
+        let store = makeStore()
+        store.addIdentifier("page_1", to: .viewedPages)
+        store.addIdentifier("page_2", to: .viewedPages)
+        store.addIdentifier("seen_1", to: .seen)
+        store.removeAllIdentifiers(from: .viewedPages)
+        store.flush()
+
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.viewedPageIds, [])
+        XCTAssertEqual(state.seenMessageIds, ["seen_1"])
+    }
+
+    func testRedisplayedMessagesArePersisted() throws {
+        let store = makeStore()
+        let message = OSInAppMessageInternal.instance(withJson: IAMTestHelpers.testDefaultMessageJson())!
+        message.displayStats.lastDisplayTime = now
+        store.saveRedisplayedMessage(message)
+        store.flush()
+
+        var state = loadState(makeStore())
+        XCTAssertEqual(state.redisplayedMessages[message.messageId]?.displayStats.lastDisplayTime, now)
+
+        let reloaded = makeStore()
+        reloaded.removeRedisplayedMessage(withId: message.messageId)
+        reloaded.flush()
+        state = loadState(makeStore())
+        XCTAssertNil(state.redisplayedMessages[message.messageId])
+    }
+
+    func testJournalIsCompactedIntoSnapshot() throws {
+        let store = makeStore()
+        for index in 0..<Int(OS_IAM_STATE_JOURNAL_COMPACTION_THRESHOLD) {
+            store.addIdentifier("seen_\(index)", to: .seen)
+        }
+        store.flush()
+        XCTAssertEqual(journalSize(), 0)
+        XCTAssertTrue(FileManager.default.fileExists(atPath: directory.appendingPathComponent("state.plist").path))
+
+        store.addIdentifier("after_compaction", to: .seen)
+        store.flush()
+        XCTAssertGreaterThan(journalSize(), 0)
+
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.seenMessageIds.count, Int(OS_IAM_STATE_JOURNAL_COMPACTION_THRESHOLD) + 1)
+    }
+
+    func testPartiallyWrittenRecordIsIgnored() throws {
+        let store = makeStore()
+        store.addIdentifier("seen_1", to: .seen)
+        store.flush()
+
+        let handle = try FileHandle(forWritingTo: directory.appendingPathComponent("journal.log"))
+        handle.seekToEndOfFile()
+        handle.write(Data([0xFF, 0x00, 0x00, 0x00, 0x01, 0x02]))
+        handle.closeFile()
+
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.seenMessageIds, ["seen_1"])
+    }
+
+    func testExpiredEntriesAreEvictedButSeenMessagesAreKept() throws {
+        let store = makeStore()
+        store.addIdentifier("seen_1", to: .seen)
+        store.addIdentifier("impression_1", to: .impressioned)
+        let message = OSInAppMessageInternal.instance(withJson: IAMTestHelpers.testDefaultMessageJson())!
+        message.displayStats.lastDisplayTime = now
+        store.saveRedisplayedMessage(message)
+        store.flush()
+
+        now += maxAge / 2
+        store.addIdentifier("impression_2", to: .impressioned)
+        store.flush()
+
+        now += maxAge / 2 + 1
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.seenMessageIds, ["seen_1"])
+        XCTAssertEqual(state.impressionedMessageIds, ["impression_2"])
+        XCTAssertTrue(state.redisplayedMessages.isEmpty)
+    }
+
+    func testStateIsMigratedFromUserDefaults() throws {
+        let userDefaults = OneSignalUserDefaults.initStandard()
+        userDefaults.saveSet(forKey: OS_IAM_SEEN_SET_KEY, withValue: ["seen_1"])
+        userDefaults.saveSet(forKey: OS_IAM_CLICKED_SET_KEY, withValue: ["click_1"])
+
+        let state = loadState(makeStore())
+        XCTAssertEqual(state.seenMessageIds, ["seen_1"])
+        XCTAssertEqual(state.clickedClickIds, ["click_1"])
+        XCTAssertFalse(userDefaults.keyExists(OS_IAM_SEEN_SET_KEY))
+
+        // Later loads read the migrated snapshot
+        XCTAssertEqual(loadState(makeStore()).seenMessageIds, ["seen_1"])
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+import XCTest
+import WebKit
+import OneSignalCoreMocks
+
+private class StubScriptMessageHandler: NSObject, WKScriptMessageHandler {
+    func userContentController(_ userContentController: WKUserContentController, didReceive message: WKScriptMessage) {}
+}
+
+final class OSInAppMessageWebViewPoolTests: XCTestCase {
+
+    private var pool: OSInAppMessageWebViewPool!
+    private let frame = CGRect(x: 0, y: 0, width: 300, height: 400)
+
+    override func setUpWithError() throws {
+        pool = OSInAppMessageWebViewPool()
+    }
+
+    private func prewarm() {
+        pool.prewarm()
+        OneSignalCoreMocks.waitUntil("Web view was not prewarmed") { self.pool.hasWarmWebView }
+    }
+
+    func testDequeueWithoutPrewarmCreatesAColdWebView() throws {
+        var warm = ObjCBool(true)
+        let webView = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: &warm)
+
+        XCTAssertFalse(warm.boolValue)
+        XCTAssertEqual(webView.frame, frame)
+        XCTAssertFalse(pool.hasWarmWebView)
+    }
+
+    func testPrewarmedWebViewIsDequeuedOnce() throws {
+        prewarm()
+        // Prewarming again while a web view is warm is a no-op
+        pool.prewarm()
+
+        var warm = ObjCBool(false)
+        let webView = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: &warm)
+        XCTAssertTrue(warm.boolValue)
+        XCTAssertEqual(webView.frame, frame)
+        XCTAssertFalse(pool.hasWarmWebView)
+
+        pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: &warm)
+        XCTAssertFalse(warm.boolValue)
+    }
+
+    func testRecycledWebViewIsResetAndReused() throws {
+        var warm = ObjCBool(false)
+        let webView = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: &warm)
+        let superview = UIView()
+        superview.addSubview(webView)
+        webView.translatesAutoresizingMaskIntoConstraints = false
+        webView.layer.cornerRadius = 10
+
+        pool.recycleWebView(webView)
+
+        XCTAssertTrue(pool.hasWarmWebView)
+        XCTAssertNil(webView.superview)
+        XCTAssertTrue(webView.translatesAutoresizingMaskIntoConstraints)
+        XCTAssertEqual(webView.layer.cornerRadius, 0)
+
+        let reused = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: &warm)
+        XCTAssertTrue(warm.boolValue)
+        XCTAssertTrue(reused === webView)
+    }
+
+    func testPoolKeepsASingleWarmWebView() throws {
+        let first = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: nil)
+        let second = pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: nil)
+
+        pool.recycleWebView(first)
+        pool.recycleWebView(second)
+
+        XCTAssertTrue(pool.dequeueWebView(withFrame: frame, messageHandler: StubScriptMessageHandler(), warm: nil) === first)
+        XCTAssertFalse(pool.hasWarmWebView)
+    }
+
+    func testMemoryWarningDrainsThePool() throws {
+        prewarm()
+
+        NotificationCenter.default.post(name: UIApplication.didReceiveMemoryWarningNotification, object: nil)
+
+        XCTAssertFalse(pool.hasWarmWebView)
+    }
+}
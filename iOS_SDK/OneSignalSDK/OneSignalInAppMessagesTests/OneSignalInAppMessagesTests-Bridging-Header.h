@@ -5,6 +5,13 @@
 #import "OSInAppMessageInternal.h"
 #import "OSMessagingController.h"
 #import "OSInAppMessagingRequests.h"
+#import "OSInAppMessageContentCache.h"
+#import "OSInAppMessageListCache.h"
+#import "OSInAppMessageLiquidTemplate.h"
+#import "OSDeadlineScheduler.h"
+#import "OSInAppMessageStateStore.h"
+#import "OSInAppMessageWebViewPool.h"
+#import "OSInAppMessageAnalyticsQueue.h"
 
 // Expose private properties and methods for testing
 @interface OSMessagingController (Testing)
@@ -17,4 +24,8 @@
 + (void)start;
 + (void)removeInstance;
 - (void)presentInAppPreviewMessage:(OSInAppMessageInternal *)message;
+- (NSArray<OSInAppMessageInternal *> *)messagesWithTriggerKeys:(NSArray<NSString *> *)keys;
+- (void)updateInAppMessagesFromResponse:(OSHTTPResponse *)response subscriptionId:(NSString *)subscriptionId NS_SWIFT_NAME(updateInAppMessages(from:subscriptionId:));
+// Returns the parsed message list, or nil if the response could not be decoded
++ (id _Nullable)messageListFromResponse:(OSHTTPResponse *)response NS_SWIFT_NAME(messageList(from:));
 @end
@@ -0,0 +1,126 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalInAppMessagesMocks
+
+/**
+ Micro-benchmark of trigger evaluation.
+ Set `ONESIGNAL_RUN_BENCHMARKS` to run it, evaluations per second are printed to the test log.
+ */
+final class TriggerEvaluationBenchmarkTests: XCTestCase {
+
+    private let evaluationCount = 200_000
+
+    // A mix of the comparisons messages use: numeric, string, numeric against a numeric string, and exists
+    private func benchmarkMessages() -> [OSInAppMessageInternal] {
+        let triggers: [(property: String, type: Int32, value: Any)] = [
+            ("level", 0, 5),        // OSTriggerOperatorTypeGreaterThan
+            ("screen", 2, "home"),  // OSTriggerOperatorTypeEqualTo
+            ("score", 5, 100),      // OSTriggerOperatorTypeGreaterThanOrEqualTo, set as a string
+            ("vip", 6, "")          // OSTriggerOperatorTypeExists
+        ]
+        return triggers.enumerated().map { index, trigger in
+            let json = IAMTestHelpers.testMessageJsonWithTrigger(
+                kind: OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+                property: trigger.property,
+                triggerId: "trigger_\(index)",
+                type: trigger.type,
+                value: trigger.value
+            )
+            return OSInAppMessageInternal.instance(withJson: json)!
+        }
+    }
+
+    private let appTriggers: [String: Any] = ["level": 10, "screen": "home", "score": "250", "vip": true]
+
+    /**
+     The evaluation this replaces, inspecting both values and allocating a number formatter for every
+     comparison of a number with a string. Kept here only as the baseline of the benchmark.
+     */
+    private func legacyEvaluate(_ trigger: OSTrigger, _ triggers: [String: Any]) -> Bool {
+        let realValue = triggers[trigger.property]
+        if realValue == nil && trigger.kind == OS_DYNAMIC_TRIGGER_KIND_CUSTOM {
+            return trigger.operatorType == .notExists
+        } else if trigger.operatorType == .exists {
+            return true
+        } else if trigger.operatorType == .notExists {
+            return false
+        }
+        if let value = trigger.value as? NSNumber, let real = realValue as? NSNumber {
+            switch trigger.operatorType {
+            case .greaterThan: if real.doubleValue > value.doubleValue { return true }
+            case .greaterThanOrEqualTo: if real.doubleValue >= value.doubleValue { return true }
+            case .equalTo: if real.isEqual(to: value) { return true }
+            default: break
+            }
+        } else if let value = trigger.value as? NSString, let real = realValue as? NSString,
+                  trigger.operatorType == .equalTo, real.isEqual(to: value as String) {
+            return true
+        }
+        guard let value = trigger.value else { return false }
+        if trigger.operatorType == .equalTo {
+            return String(describing: value) == String(describing: realValue as Any)
+        }
+        if let number = value as? NSNumber, let real = realValue as? String {
+            let formatter = NumberFormatter()
+            formatter.numberStyle = .decimal
+            let parsed = formatter.number(from: real)?.doubleValue ?? 0
+            return trigger.operatorType == .greaterThanOrEqualTo ? parsed >= number.doubleValue : parsed > number.doubleValue
+        }
+        return false
+    }
+
+    private func evaluationsPerSecond(_ evaluate: (OSInAppMessageInternal) -> Bool, messages: [OSInAppMessageInternal]) -> Double {
+        var matches = 0
+        let start = CFAbsoluteTimeGetCurrent()
+        for index in 0..<evaluationCount {
+            if evaluate(messages[index % messages.count]) {
+                matches += 1
+            }
+        }
+        let elapsed = CFAbsoluteTimeGetCurrent() - start
+        XCTAssertEqual(matches, evaluationCount)
+        return Double(evaluationCount) / elapsed
+    }
+
+    func testBenchmark_triggerEvaluationsPerSecond() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let messages = benchmarkMessages()
+        let triggerController = OSTriggerController()
+        triggerController.addTriggers(appTriggers)
+
+        let legacy = evaluationsPerSecond({ message in
+            autoreleasepool { self.legacyEvaluate(message.triggers[0][0], self.appTriggers) }
+        }, messages: messages)
+        let compiled = evaluationsPerSecond({ message in
+            autoreleasepool { triggerController.messageMatchesTriggers(message) }
+        }, messages: messages)
+
+        print(String(format: "Trigger evaluations per second: before %.0f, after %.0f (%.1fx)", legacy, compiled, compiled / legacy))
+    }
+}
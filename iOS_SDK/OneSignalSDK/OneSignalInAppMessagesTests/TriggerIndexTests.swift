@@ -0,0 +1,125 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCoreMocks
+import OneSignalUserMocks
+import OneSignalInAppMessagesMocks
+
+/**
+ Tests for the index from trigger keys to the in-app messages using them.
+ */
+final class TriggerIndexTests: XCTestCase {
+
+    override func setUpWithError() throws {
+        OneSignalCoreMocks.clearUserDefaults()
+        OneSignalUserMocks.reset()
+        OSMessagingController.removeInstance()
+    }
+
+    override func tearDownWithError() throws {
+        OSMessagingController.removeInstance()
+    }
+
+    private func messageJson(properties: [String], triggerIdPrefix: String = "trigger") -> [String: Any] {
+        var json = IAMTestHelpers.testDefaultMessageJson()
+        json["triggers"] = [
+            properties.enumerated().map { index, property in
+                [
+                    "kind": OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+                    "property": property,
+                    "operator": "equal",
+                    "value": "value",
+                    "id": "\(triggerIdPrefix)_\(index)"
+                ]
+            }
+        ]
+        return json
+    }
+
+    /**
+     Test that messages are looked up by trigger property and by triggerId, in message list order.
+     */
+    func testMessagesWithTriggerKeys_matchesPropertyAndTriggerId() throws {
+        /* Setup */
+        let controller = OSMessagingController.sharedInstance()
+        let first = OSInAppMessageInternal.instance(withJson: messageJson(properties: ["a", "b"], triggerIdPrefix: "first"))!
+        let second = OSInAppMessageInternal.instance(withJson: messageJson(properties: ["b", "c"], triggerIdPrefix: "second"))!
+        let untriggered = OSInAppMessageInternal.instance(withJson: IAMTestHelpers.testDefaultMessageJson())!
+        controller.messages = NSMutableArray(array: [first, second, untriggered])
+
+        /* Verify */
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["a"]), [first])
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["c", "b"]), [first, second])
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["second_0"]), [second])
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["unknown"]), [])
+
+        // The index follows the message list
+        controller.messages = NSMutableArray(array: [second])
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["a"]), [])
+        XCTAssertEqual(controller.messagesWithTriggerKeys(["b"]), [second])
+    }
+
+    /**
+     Test that adding a trigger only makes the redisplayed messages using it available to redisplay.
+     */
+    func testAddTriggers_onlyMarksRedisplayedMessagesUsingTheKey() throws {
+        /* Setup */
+        let controller = OSMessagingController.sharedInstance()
+        let affected = OSInAppMessageInternal.instance(withJson: messageJson(properties: ["a"]))!
+        let unaffected = OSInAppMessageInternal.instance(withJson: messageJson(properties: ["b"]))!
+        controller.messages = NSMutableArray(array: [affected, unaffected])
+        controller.redisplayedInAppMessages[affected.messageId] = affected
+        controller.redisplayedInAppMessages[unaffected.messageId] = unaffected
+
+        /* Execute */
+        controller.addTriggers(["a": "value"])
+
+        /* Verify */
+        XCTAssertTrue(affected.isTriggerChanged)
+        XCTAssertFalse(unaffected.isTriggerChanged)
+    }
+
+    /**
+     Benchmark of a stream of `addTriggers` calls against 500 in-app messages with 20 triggers each.
+     Set `ONESIGNAL_RUN_BENCHMARKS` to run it.
+     */
+    func testBenchmark_addTriggersWith500Messages() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let controller = OSMessagingController.sharedInstance()
+        let messages = (0..<500).map { messageIndex in
+            OSInAppMessageInternal.instance(withJson: messageJson(properties: (0..<20).map { "prop_\(messageIndex)_\($0)" }))!
+        }
+        controller.messages = NSMutableArray(array: messages)
+
+        measure {
+            for call in 0..<1_000 {
+                controller.addTriggers(["prop_\(call % 500)_\(call % 20)": "value"])
+            }
+        }
+    }
+}
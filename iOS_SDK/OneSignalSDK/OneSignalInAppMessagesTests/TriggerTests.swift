@@ -119,4 +119,84 @@ final class TriggerTests: XCTestCase {
         triggerController.addTriggers(["prop": "other"])
         XCTAssertTrue(triggerController.messageMatchesTriggers(message!))
     }
+
+    /**
+     Test that messages whose custom triggers match are considered for prefetch, whatever their time based triggers.
+     */
+    func testMessageMatchesNonDynamicTriggers_ignoresTimeBasedTriggers() throws {
+        /* Setup */
+        let triggerController = OSTriggerController()
+
+        let customJson = IAMTestHelpers.testMessageJsonWithTrigger(
+            kind: OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+            property: "prop",
+            triggerId: "custom_trigger",
+            type: 2, // OSTriggerOperatorTypeEqualTo
+            value: "value"
+        )
+        let sessionTimeJson = IAMTestHelpers.testMessageJsonWithTrigger(
+            kind: OS_DYNAMIC_TRIGGER_KIND_SESSION_TIME,
+            property: OS_TRIGGER_PROPERTY_SESSION_TIME,
+            triggerId: "session_trigger",
+            type: 0, // OSTriggerOperatorTypeGreaterThan
+            value: 3600
+        )
+        let customMessage = OSInAppMessageInternal.instance(withJson: customJson)!
+        let sessionTimeMessage = OSInAppMessageInternal.instance(withJson: sessionTimeJson)!
+
+        XCTAssertFalse(triggerController.messageMatchesNonDynamicTriggers(customMessage))
+        XCTAssertTrue(triggerController.messageMatchesNonDynamicTriggers(sessionTimeMessage))
+
+        triggerController.addTriggers(["prop": "value"])
+        XCTAssertTrue(triggerController.messageMatchesNonDynamicTriggers(customMessage))
+    }
+
+    /**
+     Test that numeric triggers compare against numeric strings set by the app.
+     */
+    func testNumericTrigger_matchesNumericStringValue() throws {
+        /* Setup */
+        let triggerController = OSTriggerController()
+
+        let messageJson = IAMTestHelpers.testMessageJsonWithTrigger(
+            kind: OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+            property: "prop",
+            triggerId: "test_trigger",
+            type: 0, // OSTriggerOperatorTypeGreaterThan
+            value: 5
+        )
+        let message = OSInAppMessageInternal.instance(withJson: messageJson)!
+
+        triggerController.addTriggers(["prop": "10"])
+        XCTAssertTrue(triggerController.messageMatchesTriggers(message))
+
+        triggerController.addTriggers(["prop": "2"])
+        XCTAssertFalse(triggerController.messageMatchesTriggers(message))
+
+        triggerController.addTriggers(["prop": 7])
+        XCTAssertTrue(triggerController.messageMatchesTriggers(message))
+    }
+
+    /**
+     Test that changing the value of a trigger is reflected in its evaluation.
+     */
+    func testTriggerValueChange_isReflectedInEvaluation() throws {
+        /* Setup */
+        let triggerController = OSTriggerController()
+
+        let messageJson = IAMTestHelpers.testMessageJsonWithTrigger(
+            kind: OS_DYNAMIC_TRIGGER_KIND_CUSTOM,
+            property: "prop",
+            triggerId: "test_trigger",
+            type: 2, // OSTriggerOperatorTypeEqualTo
+            value: "value"
+        )
+        let message = OSInAppMessageInternal.instance(withJson: messageJson)!
+        triggerController.addTriggers(["prop": "other"])
+        XCTAssertFalse(triggerController.messageMatchesTriggers(message))
+
+        let trigger = message.triggers[0][0]
+        trigger.value = "other"
+        XCTAssertTrue(triggerController.messageMatchesTriggers(message))
+    }
 }
@@ -0,0 +1,138 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import OneSignalCore
+
+/**
+ Decides when the Operation Repo flushes, replacing a fixed poll.
+ Sleeps while nothing is pending. The first enqueue arms a debounce window that later enqueues extend, bounded by a maximum
+ latency measured from the first pending delta. A full batch flushes right away. While executors still hold unsent requests,
+ or one of them requeues a failed request, it re-arms at the maximum latency so they are retried.
+ All methods must be called on the `queue` the scheduler was created with, and `flush` is invoked on it.
+ */
+final class OSFlushScheduler {
+    private let queue: OSDispatchQueue
+    private let now: () -> DispatchTime
+    private let flush: () -> Void
+
+    // Read on every enqueue so changes to `OneSignalConfig` apply immediately
+    var debounceMilliseconds: () -> Int = { OneSignalConfig.operationRepoFlushDebounceMilliseconds }
+    var maxLatencyMilliseconds: () -> Int = { OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds }
+    var maxBatchSize: () -> Int = { OneSignalConfig.operationRepoMaxFlushBatchSize }
+
+    private var firstPendingAt: DispatchTime?
+    // When the next flush should happen; may be later than the armed timer, which then re-arms instead of flushing.
+    private var targetDeadline: DispatchTime?
+    private var armedDeadline: DispatchTime?
+    // Incremented to invalidate armed timers that are no longer needed
+    private var generation = 0
+
+    /// Number of times an armed timer fired, exposed for tests.
+    private(set) var wakeups = 0
+
+    init(queue: OSDispatchQueue, now: @escaping () -> DispatchTime = { DispatchTime.now() }, flush: @escaping () -> Void) {
+        self.queue = queue
+        self.now = now
+        self.flush = flush
+    }
+
+    var isArmed: Bool {
+        return armedDeadline != nil
+    }
+
+    /**
+     Called after a delta is added to the queue, with the resulting number of pending deltas.
+     */
+    func deltaEnqueued(pendingCount: Int) {
+        let current = now()
+        if pendingCount >= maxBatchSize() {
+            schedule(at: current)
+            return
+        }
+        let firstPendingAt = self.firstPendingAt ?? current
+        self.firstPendingAt = firstPendingAt
+        let debounced = current + .milliseconds(debounceMilliseconds())
+        let latest = firstPendingAt + .milliseconds(maxLatencyMilliseconds())
+        schedule(at: min(debounced, latest))
+    }
+
+    /**
+     Called after every flush, scheduled or explicit. Goes idle unless executors still have unsent requests.
+     */
+    func didFlush(hasPendingRequests: Bool) {
+        firstPendingAt = nil
+        targetDeadline = nil
+        armedDeadline = nil
+        generation += 1
+        if hasPendingRequests {
+            schedule(at: now() + .milliseconds(maxLatencyMilliseconds()))
+        }
+    }
+
+    /**
+     Called when an executor makes a failed request eligible to be sent again, so it is retried without waiting for a new delta.
+     */
+    func requestRetry() {
+        let deadline = now() + .milliseconds(maxLatencyMilliseconds())
+        if let targetDeadline = targetDeadline, targetDeadline <= deadline {
+            return
+        }
+        schedule(at: deadline)
+    }
+
+    private func schedule(at deadline: DispatchTime) {
+        targetDeadline = deadline
+        // An earlier timer re-arms itself on firing, so only arm when the new deadline is sooner
+        if let armedDeadline = armedDeadline, armedDeadline <= deadline {
+            return
+        }
+        arm(at: deadline)
+    }
+
+    private func arm(at deadline: DispatchTime) {
+        generation += 1
+        let armedGeneration = generation
+        armedDeadline = deadline
+        queue.asyncAfterTime(deadline: deadline) { [weak self] in
+            self?.fire(generation: armedGeneration)
+        }
+    }
+
+    private func fire(generation armedGeneration: Int) {
+        guard armedGeneration == generation else {
+            return
+        }
+        wakeups += 1
+        armedDeadline = nil
+        if let targetDeadline = targetDeadline, now() < targetDeadline {
+            arm(at: targetDeadline)
+            return
+        }
+        flush()
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import OneSignalCore
+
+/**
+ Compact replacement for `NSKeyedArchiver` when persisting models.
+ An `NSCoding` object is flattened into a dictionary of its keyed fields plus its class name, and written as a binary property list.
+ There is no object graph or UID table, so a model costs roughly the size of its values. Nested `NSCoding` objects, arrays and
+ dictionaries are supported. Values that are neither property list types nor `NSCoding` are skipped.
+ */
+public enum OSModelBinaryCoder {
+    static let classKey = "$os_class"
+    static let wrappedDictionaryKey = "$os_dict"
+
+    public static func encode(_ object: NSCoding) -> Data? {
+        guard let encoded = OSModelBinaryEncoder.encodeValue(object) else {
+            return nil
+        }
+        do {
+            return try PropertyListSerialization.data(fromPropertyList: encoded, format: .binary, options: 0)
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSModelBinaryCoder could not encode \(object): \(error)")
+            return nil
+        }
+    }
+
+    public static func decode(_ data: Data) -> Any? {
+        do {
+            let plist = try PropertyListSerialization.propertyList(from: data, options: [], format: nil)
+            return OSModelBinaryDecoder.decodeValue(plist)
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSModelBinaryCoder could not decode data: \(error)")
+            return nil
+        }
+    }
+}
+
+private final class OSModelBinaryEncoder: NSCoder {
+    private(set) var fields: [String: Any] = [:]
+
+    override var allowsKeyedCoding: Bool {
+        return true
+    }
+
+    /// Converts a value into property list types, or nil if it cannot be represented.
+    static func encodeValue(_ value: Any) -> Any? {
+        switch value {
+        case is String, is NSNumber, is Data, is Date:
+            return value
+        case let array as [Any]:
+            return array.compactMap { encodeValue($0) }
+        case let dictionary as [String: Any]:
+            let encoded = dictionary.compactMapValues { encodeValue($0) }
+            // Wrap dictionaries that could be mistaken for an encoded object
+            if encoded[OSModelBinaryCoder.classKey] != nil || (encoded.count == 1 && encoded[OSModelBinaryCoder.wrappedDictionaryKey] != nil) {
+                return [OSModelBinaryCoder.wrappedDictionaryKey: encoded]
+            }
+            return encoded
+        case let object as NSObject & NSCoding:
+            let encoder = OSModelBinaryEncoder()
+            object.encode(with: encoder)
+            var fields = encoder.fields
+            fields[OSModelBinaryCoder.classKey] = NSStringFromClass(type(of: object))
+            return fields
+        default:
+            OneSignalLog.onesignalLog(.LL_WARN, message: "OSModelBinaryCoder skipping unsupported value of type \(type(of: value))")
+            return nil
+        }
+    }
+
+    override func encode(_ object: Any?, forKey key: String) {
+        guard let object = object, let encoded = OSModelBinaryEncoder.encodeValue(object) else {
+            return
+        }
+        fields[key] = encoded
+    }
+
+    override func encode(_ value: Bool, forKey key: String) {
+        fields[key] = value
+    }
+
+    override func encode(_ value: Int, forKey key: String) {
+        fields[key] = value
+    }
+
+    override func encode(_ value: Int32, forKey key: String) {
+        fields[key] = value
+    }
+
+    override func encode(_ value: Int64, forKey key: String) {
+        fields[key] = value
+    }
+
+    override func encode(_ value: Float, forKey key: String) {
+        fields[key] = value
+    }
+
+    override func encode(_ value: Double, forKey key: String) {
+        fields[key] = value
+    }
+}
+
+private final class OSModelBinaryDecoder: NSCoder {
+    private let fields: [String: Any]
+
+    init(fields: [String: Any]) {
+        self.fields = fields
+    }
+
+    override var allowsKeyedCoding: Bool {
+        return true
+    }
+
+    static func decodeValue(_ value: Any) -> Any? {
+        switch value {
+        case let array as [Any]:
+            return array.compactMap { decodeValue($0) }
+        case let dictionary as [String: Any]:
+            if let className = dictionary[OSModelBinaryCoder.classKey] as? String {
+                guard let objectClass = NSClassFromString(className) as? NSCoding.Type else {
+                    OneSignalLog.onesignalLog(.LL_ERROR, message: "OSModelBinaryCoder cannot decode unknown class \(className)")
+                    return nil
+                }
+                return objectClass.init(coder: OSModelBinaryDecoder(fields: dictionary))
+            }
+            if dictionary.count == 1, let wrapped = dictionary[OSModelBinaryCoder.wrappedDictionaryKey] as? [String: Any] {
+                return wrapped.compactMapValues { decodeValue($0) }
+            }
+            return dictionary.compactMapValues { decodeValue($0) }
+        default:
+            return value
+        }
+    }
+
+    override func containsValue(forKey key: String) -> Bool {
+        return fields[key] != nil
+    }
+
+    override func decodeObject(forKey key: String) -> Any? {
+        guard let value = fields[key] else {
+            return nil
+        }
+        return OSModelBinaryDecoder.decodeValue(value)
+    }
+
+    override func decodeBool(forKey key: String) -> Bool {
+        return (fields[key] as? NSNumber)?.boolValue ?? false
+    }
+
+    override func decodeInteger(forKey key: String) -> Int {
+        return (fields[key] as? NSNumber)?.intValue ?? 0
+    }
+
+    override func decodeInt32(forKey key: String) -> Int32 {
+        return (fields[key] as? NSNumber)?.int32Value ?? 0
+    }
+
+    override func decodeInt64(forKey key: String) -> Int64 {
+        return (fields[key] as? NSNumber)?.int64Value ?? 0
+    }
+
+    override func decodeFloat(forKey key: String) -> Float {
+        return (fields[key] as? NSNumber)?.floatValue ?? 0
+    }
+
+    override func decodeDouble(forKey key: String) -> Double {
+        return (fields[key] as? NSNumber)?.doubleValue ?? 0
+    }
+}
@@ -32,19 +32,28 @@ open class OSModelStore<TModel: OSModel>: NSObject {
     let changeSubscription: OSEventProducer<OSModelStoreChangedHandler>
     var models: [String: TModel]
     let lock = NSLock()
+    // Each model is persisted on its own, so an update rewrites only that model. Accessed while holding `lock`.
+    private let persistence: OSModelStorePersistence
 
     public init(changeSubscription: OSEventProducer<OSModelStoreChangedHandler>, storeKey: String) {
         self.storeKey = storeKey
         self.changeSubscription = changeSubscription
-        self.models = OSModelStore.loadModelsFromUserDefaults(storeKey: storeKey)
+        self.persistence = OSModelStorePersistence(storeKey: storeKey)
+        self.models = OSModelStore.loadModelsFromUserDefaults(persistence)
         super.init()
         subscribeToOwnedModels()
     }
 
-    /// Reads the archived `[String: TModel]` dict for `storeKey` from shared UserDefaults.
-    /// Returns an empty dict if the entry is missing or the unarchive fails.
-    private static func loadModelsFromUserDefaults(storeKey: String) -> [String: TModel] {
-        return (OneSignalUserDefaults.initShared().getSavedCodeableData(forKey: storeKey, defaultValue: [:]) as? [String: TModel]) ?? [:]
+    /// Reads the `[String: TModel]` dict for `storeKey` from shared UserDefaults.
+    /// Returns an empty dict if nothing is stored; models that fail to decode are dropped.
+    private static func loadModelsFromUserDefaults(_ persistence: OSModelStorePersistence) -> [String: TModel] {
+        return persistence.load().compactMapValues { $0 as? TModel }
+    }
+
+    /// The store ID to `modelId` mapping that is persisted as the store's index.
+    /// Callers must hold `lock`.
+    private func modelIndex() -> [String: String] {
+        return models.mapValues { $0.modelId }
     }
 
     /// Subscribes this store as a change observer on every model currently in `models`.
@@ -107,7 +116,7 @@ open class OSModelStore<TModel: OSModel>: NSObject {
     public func refresh() {
         lock.withLock {
             guard models.isEmpty else { return }
-            let stored = OSModelStore.loadModelsFromUserDefaults(storeKey: self.storeKey)
+            let stored = OSModelStore.loadModelsFromUserDefaults(self.persistence)
             guard !stored.isEmpty else { return }
             OneSignalLog.onesignalLog(.LL_DEBUG, message: "OSModelStore[\(self.storeKey)] refresh hydrated \(stored.count) model(s) from UserDefaults")
             self.models = stored
@@ -122,8 +131,9 @@ open class OSModelStore<TModel: OSModel>: NSObject {
         lock.withLock {
             models[id] = model
 
-            // persist the models (including new model) to storage
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: self.storeKey, withValue: self.models)
+            // persist the new model and the index to storage
+            persistence.save(model)
+            persistence.saveIndex(modelIndex())
 
             // listen for changes to this model
             model.changeNotifier.subscribe(self)
@@ -148,8 +158,8 @@ open class OSModelStore<TModel: OSModel>: NSObject {
                 model = foundModel
                 models.removeValue(forKey: id)
 
-                // persist the models (with removed model) to storage
-                OneSignalUserDefaults.initShared().saveCodeableData(forKey: self.storeKey, withValue: self.models)
+                // persist the index (without the removed model) to storage, which also removes the model
+                persistence.saveIndex(modelIndex())
             } else {
                 OneSignalLog.onesignalLog(.LL_ERROR, message: "OSModelStore cannot remove \(id) because it doesn't exist in the store.")
                 return
@@ -171,7 +181,9 @@ open class OSModelStore<TModel: OSModel>: NSObject {
      */
     @objc func removeModelsFromUserDefaults() {
         // Clear the UserDefaults models cache when OS_ON_USER_WILL_CHANGEclearModelsFromStore() called
-        OneSignalUserDefaults.initShared().removeValue(forKey: self.storeKey)
+        lock.withLock {
+            persistence.removeAll()
+        }
     }
 
     /**
@@ -188,9 +200,12 @@ open class OSModelStore<TModel: OSModel>: NSObject {
 
 extension OSModelStore: OSModelChangedHandler {
     public func onModelUpdated(args: OSModelChangedArgs, hydrating: Bool) {
-        // persist the changed models to storage
+        // persist only the changed model to storage, if it is still in this store
         lock.withLock {
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: self.storeKey, withValue: self.models)
+            guard let model = models.values.first(where: { $0.modelId == args.model.modelId }) else {
+                return
+            }
+            persistence.saveUpdated(model, index: modelIndex())
         }
         guard !hydrating else {
             return
@@ -0,0 +1,153 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import OneSignalCore
+
+/**
+ Per-model storage for an `OSModelStore` in shared UserDefaults, so updating one model rewrites only that model.
+ Layout for a store key `K`:
+   * `K_INDEX`: a dictionary of store ID (ie: email address) to `modelId`, rewritten only when models are added or removed.
+   * `K_MODEL_<modelId>`: the model encoded with `OSModelBinaryCoder`.
+ Stores persisted by older SDKs as a single `NSKeyedArchiver` blob under `K` are migrated on first load. The blob is left in
+ place, so an app downgraded to an SDK that only reads it keeps its user. It is removed with the rest of the store.
+ Not thread-safe: the owning store calls it while holding its lock.
+ */
+@objc(OSModelStorePersistence)
+public final class OSModelStorePersistence: NSObject {
+    private static let indexSuffix = "_INDEX"
+    private static let modelInfix = "_MODEL_"
+
+    private let storeKey: String
+    // The model IDs currently in the persisted index, used to remove entries that drop out of it
+    private var persistedModelIds: Set<String> = []
+
+    init(storeKey: String) {
+        self.storeKey = storeKey
+    }
+
+    private static func indexKey(_ storeKey: String) -> String {
+        return storeKey + indexSuffix
+    }
+
+    private static func modelKey(_ storeKey: String, modelId: String) -> String {
+        return storeKey + modelInfix + modelId
+    }
+
+    private static func loadIndex(_ storeKey: String) -> [String: String]? {
+        return OneSignalUserDefaults.initShared().getSavedDictionary(forKey: indexKey(storeKey), defaultValue: nil) as? [String: String]
+    }
+
+    /// Reads all models keyed by store ID, migrating a legacy blob if that is all there is.
+    /// Models that fail to decode are dropped.
+    func load() -> [String: Any] {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        if let index = OSModelStorePersistence.loadIndex(storeKey) {
+            var models: [String: Any] = [:]
+            for (id, modelId) in index {
+                guard let data = userDefaults.getSavedObject(forKey: OSModelStorePersistence.modelKey(storeKey, modelId: modelId), defaultValue: nil) as? Data,
+                      let model = OSModelBinaryCoder.decode(data)
+                else {
+                    OneSignalLog.onesignalLog(.LL_ERROR, message: "OSModelStorePersistence[\(storeKey)] could not load model \(modelId)")
+                    continue
+                }
+                models[id] = model
+            }
+            persistedModelIds = Set(index.values)
+            return models
+        }
+
+        guard userDefaults.keyExists(storeKey),
+              let legacyModels = userDefaults.getSavedCodeableData(forKey: storeKey, defaultValue: nil) as? [String: OSModel]
+        else {
+            return [:]
+        }
+        OneSignalLog.onesignalLog(.LL_DEBUG, message: "OSModelStorePersistence[\(storeKey)] migrating \(legacyModels.count) model(s) to per-model storage")
+        for model in legacyModels.values {
+            save(model)
+        }
+        saveIndex(legacyModels.mapValues { $0.modelId })
+        // Not removed, the index takes precedence from now on and older SDKs still read the blob
+        return legacyModels
+    }
+
+    /// Writes a single model. Writes the index too if the model is not in it yet, ie: after `removeAll()`.
+    func saveUpdated(_ model: OSModel, index: @autoclosure () -> [String: String]) {
+        save(model)
+        if !persistedModelIds.contains(model.modelId) {
+            saveIndex(index())
+        }
+    }
+
+    func save(_ model: OSModel) {
+        guard let data = OSModelBinaryCoder.encode(model) else {
+            return
+        }
+        OneSignalUserDefaults.initShared().saveObject(forKey: OSModelStorePersistence.modelKey(storeKey, modelId: model.modelId), withValue: data)
+    }
+
+    /// Writes the index, then removes the entries of models no longer in it.
+    func saveIndex(_ index: [String: String]) {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        userDefaults.saveDictionary(forKey: OSModelStorePersistence.indexKey(storeKey), withValue: index)
+        let modelIds = Set(index.values)
+        for removedModelId in persistedModelIds.subtracting(modelIds) {
+            userDefaults.removeValue(forKey: OSModelStorePersistence.modelKey(storeKey, modelId: removedModelId))
+        }
+        persistedModelIds = modelIds
+    }
+
+    func removeAll() {
+        OSModelStorePersistence.removeAll(storeKey: storeKey, knownModelIds: persistedModelIds)
+        persistedModelIds = []
+    }
+
+    private static func removeAll(storeKey: String, knownModelIds: Set<String>) {
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let modelIds = knownModelIds.union(loadIndex(storeKey).map { Array($0.values) } ?? [])
+        userDefaults.removeValue(forKey: indexKey(storeKey))
+        for modelId in modelIds {
+            userDefaults.removeValue(forKey: modelKey(storeKey, modelId: modelId))
+        }
+        // Legacy blob
+        userDefaults.removeValue(forKey: storeKey)
+    }
+
+    /// Whether anything is persisted for the store, in either layout.
+    @objc public static func hasPersistedModels(storeKey: String) -> Bool {
+        if let index = loadIndex(storeKey) {
+            return !index.isEmpty
+        }
+        let legacyModels = OneSignalUserDefaults.initShared().getSavedCodeableData(forKey: storeKey, defaultValue: nil) as? [String: Any]
+        return !(legacyModels?.isEmpty ?? true)
+    }
+
+    /// Removes everything persisted for the store, in either layout.
+    @objc public static func removeAll(storeKey: String) {
+        removeAll(storeKey: storeKey, knownModelIds: [])
+    }
+}
@@ -36,4 +36,26 @@ public protocol OSOperationExecutor {
     func enqueueDelta(_ delta: OSDelta)
     func cacheDeltaQueue()
     func processDeltaQueue(inBackground: Bool)
+
+    /**
+     Called by the Operation Repo before persisting and dispatching, to fold `delta` into the deltas already queued for this executor.
+     Returns this executor's queued deltas, in order, with `delta` applied. Redundant deltas may be merged or dropped so the queue stays proportional to the final state.
+     */
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta]
+
+    /**
+     Whether the executor holds requests it could not send yet. The Operation Repo keeps scheduling flushes while any executor does, and is idle otherwise.
+     */
+    var hasUnsentRequests: Bool { get }
+}
+
+public extension OSOperationExecutor {
+    /// By default, deltas are not coalesced.
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta] {
+        return queued + [delta]
+    }
+
+    var hasUnsentRequests: Bool {
+        return false
+    }
 }
@@ -0,0 +1,184 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import OneSignalCore
+
+/// Append-only, file-backed journal of `NSCoding` records.
+///
+/// Each record is a 4-byte big-endian length followed by the `NSKeyedArchiver` payload of a
+/// single object, so enqueueing costs one archive of the new object instead of re-archiving the
+/// whole queue. Callers compact the journal by calling `rewrite(_:)` with the live contents,
+/// ie: after a flush has drained the queue. A truncated trailing record (crash mid-append) is
+/// discarded on `load()`.
+///
+/// Not thread-safe: callers are expected to serialize access on their own dispatch queue.
+public final class OSOperationJournal {
+    private static let directoryName = "OneSignal"
+    private static let lengthPrefixSize = MemoryLayout<UInt32>.size
+
+    private let fileURL: URL?
+
+    /// Number of records currently in the file, used by callers to decide when to compact.
+    public private(set) var recordCount = 0
+
+    /// Total bytes written to disk by this journal, exposed for benchmarks.
+    public private(set) var bytesWritten = 0
+
+    public init(fileName: String) {
+        self.fileURL = OSOperationJournal.directoryURL()?.appendingPathComponent(fileName)
+    }
+
+    init(fileURL: URL) {
+        self.fileURL = fileURL
+    }
+
+    /// The journal lives in the app's private Application Support directory; it is only read by
+    /// the process that wrote it, unlike identifiers stored in `OSResilientStorage`.
+    private static func directoryURL() -> URL? {
+        do {
+            let support = try FileManager.default.url(
+                for: .applicationSupportDirectory,
+                in: .userDomainMask,
+                appropriateFor: nil,
+                create: true
+            )
+            let directory = support.appendingPathComponent(directoryName, isDirectory: true)
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            return directory
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal could not resolve a directory: \(error)")
+            return nil
+        }
+    }
+
+    public var exists: Bool {
+        guard let url = fileURL else { return false }
+        return FileManager.default.fileExists(atPath: url.path)
+    }
+
+    /// Reads every complete record in order. Returns nil when the journal file does not exist,
+    /// so callers can fall back to a legacy cache.
+    public func load() -> [Any]? {
+        guard let url = fileURL, exists else { return nil }
+        let data: Data
+        do {
+            data = try Data(contentsOf: url)
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal could not read \(url.lastPathComponent): \(error)")
+            return nil
+        }
+
+        var objects: [Any] = []
+        var offset = 0
+        var isTruncated = false
+        while offset < data.count {
+            guard data.count - offset >= OSOperationJournal.lengthPrefixSize else {
+                isTruncated = true
+                break
+            }
+            let length = data[offset..<offset + OSOperationJournal.lengthPrefixSize].reduce(0) { ($0 << 8) | Int($1) }
+            let start = offset + OSOperationJournal.lengthPrefixSize
+            guard data.count - start >= length else {
+                isTruncated = true
+                break
+            }
+            if let object = try? NSKeyedUnarchiver.unarchiveTopLevelObjectWithData(data.subdata(in: start..<start + length)) {
+                objects.append(object)
+            } else {
+                OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal dropped an unreadable record in \(url.lastPathComponent)")
+            }
+            offset = start + length
+        }
+
+        recordCount = objects.count
+        if isTruncated {
+            OneSignalLog.onesignalLog(.LL_WARN, message: "OSOperationJournal discarding truncated record in \(url.lastPathComponent)")
+            rewrite(objects)
+        }
+        return objects
+    }
+
+    /// Appends a single record to the end of the journal.
+    public func append(_ object: Any) {
+        guard let url = fileURL, let record = OSOperationJournal.record(for: object) else { return }
+        let fd = open(url.path, O_WRONLY | O_APPEND | O_CREAT, 0o644)
+        guard fd >= 0 else {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal could not open \(url.lastPathComponent) errno: \(errno)")
+            return
+        }
+        defer { close(fd) }
+        let written = record.withUnsafeBytes { write(fd, $0.baseAddress, record.count) }
+        guard written == record.count else {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal short write to \(url.lastPathComponent) errno: \(errno)")
+            return
+        }
+        recordCount += 1
+        bytesWritten += written
+    }
+
+    /// Compacts the journal so it contains exactly `objects`, replacing the file atomically.
+    public func rewrite(_ objects: [Any]) {
+        guard let url = fileURL else { return }
+        var data = Data()
+        var count = 0
+        for object in objects {
+            if let record = OSOperationJournal.record(for: object) {
+                data.append(record)
+                count += 1
+            }
+        }
+        do {
+            try data.write(to: url, options: .atomic)
+            recordCount = count
+            bytesWritten += data.count
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal could not rewrite \(url.lastPathComponent): \(error)")
+        }
+    }
+
+    /// Deletes the journal file.
+    public func remove() {
+        guard let url = fileURL, exists else { return }
+        try? FileManager.default.removeItem(at: url)
+        recordCount = 0
+    }
+
+    private static func record(for object: Any) -> Data? {
+        let payload: Data
+        do {
+            payload = try NSKeyedArchiver.archivedData(withRootObject: object, requiringSecureCoding: false)
+        } catch {
+            OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationJournal could not archive \(object): \(error)")
+            return nil
+        }
+        var length = UInt32(payload.count).bigEndian
+        var record = Data(bytes: &length, count: lengthPrefixSize)
+        record.append(payload)
+        return record
+    }
+}
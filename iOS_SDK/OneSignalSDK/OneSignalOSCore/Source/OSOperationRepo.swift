@@ -44,9 +44,27 @@ public class OSOperationRepo: NSObject {
     var executors: [OSOperationExecutor] = []
     var deltaQueue: [OSDelta] = [] // non-private for unit test access
 
-    // TODO: This could come from a config, plist, method, remote params
-    var pollIntervalMilliseconds = Int(POLL_INTERVAL_MS)
-    public var paused = false
+    // Persists `deltaQueue`: each enqueue appends one record, and each flush compacts it.
+    var journal = OSOperationJournal(fileName: OS_OPERATION_REPO_JOURNAL_FILE_NAME) // non-private for unit test access
+
+    // Deltas read from the journal were persisted before coalescing, so they are coalesced on the next flush.
+    private var needsCoalescing = false
+    // Compact the journal early once it holds this many more records than the coalesced queue.
+    private let journalCompactionSlack = 32
+
+    // Arms a flush when deltas are enqueued and stays idle otherwise. Knobs are read from `OneSignalConfig`.
+    lazy var flushScheduler = OSFlushScheduler(queue: dispatchQueue) { [weak self] in
+        self?.flushDeltaQueue()
+    } // non-private for unit test access
+
+    public var paused = false {
+        didSet {
+            // Nothing polls the queue, so flush what accumulated while paused
+            if oldValue && !paused {
+                addFlushDeltaQueueToDispatchQueue()
+            }
+        }
+    }
 
     /**
      Initilize this Operation Repo. Read from the cache. Executors may not be available by this time.
@@ -69,21 +87,34 @@ public class OSOperationRepo: NSObject {
                                                name: Notification.Name(OS_ON_USER_WILL_CHANGE),
                                                object: nil)
         // Read the Deltas from cache, if any...
+        uncacheDeltas()
+
+        dispatchQueue.async {
+            if !self.deltaQueue.isEmpty {
+                self.flushScheduler.deltaEnqueued(pendingCount: self.deltaQueue.count)
+            }
+        }
+    }
+
+    /**
+     Reads the Deltas from the journal. Falls back to the legacy UserDefaults cache once, and migrates it to the journal.
+     */
+    private func uncacheDeltas() {
+        if let journaled = journal.load() {
+            self.deltaQueue = journaled.compactMap { $0 as? OSDelta }
+            self.needsCoalescing = journal.recordCount > 1
+            OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo.start() with deltaQueue: \(deltaQueue)")
+            return
+        }
+
         if let deltaQueue = OneSignalUserDefaults.initShared().getSavedCodeableData(forKey: OS_OPERATION_REPO_DELTA_QUEUE_KEY, defaultValue: []) as? [OSDelta] {
             self.deltaQueue = deltaQueue
             OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo.start() with deltaQueue: \(deltaQueue)")
         } else {
             OneSignalLog.onesignalLog(.LL_ERROR, message: "OSOperationRepo.start() is unable to uncache the OSDelta queue.")
         }
-
-        pollFlushQueue()
-    }
-
-    private func pollFlushQueue() {
-        self.dispatchQueue.asyncAfter(deadline: .now() + .milliseconds(pollIntervalMilliseconds)) { [weak self] in
-            self?.flushDeltaQueue()
-            self?.pollFlushQueue()
-        }
+        journal.rewrite(self.deltaQueue)
+        OneSignalUserDefaults.initShared().removeValue(forKey: OS_OPERATION_REPO_DELTA_QUEUE_KEY)
     }
 
     /**
@@ -114,23 +145,72 @@ public class OSOperationRepo: NSObject {
         start()
         self.dispatchQueue.async {
             OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo enqueueDelta: \(delta)")
-            self.deltaQueue.append(delta)
+            self.insertCoalesced(delta)
 
-            // Persist the deltas (including new delta) to storage
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_OPERATION_REPO_DELTA_QUEUE_KEY, withValue: self.deltaQueue)
+            // Persist the new delta to storage, compacting if coalescing has left the journal mostly redundant
+            if self.journal.recordCount >= self.deltaQueue.count + self.journalCompactionSlack {
+                self.journal.rewrite(self.deltaQueue)
+            } else {
+                self.journal.append(delta)
+            }
 
             if flush {
                 self.flushDeltaQueue()
+            } else {
+                self.flushScheduler.deltaEnqueued(pendingCount: self.deltaQueue.count)
             }
         }
     }
 
+    /**
+     Adds the delta to `deltaQueue`, letting its executor fold it into the deltas already queued for that executor.
+     Deltas belonging to other executors, or without an executor yet, keep their positions.
+     This method is called on the dispatch queue only.
+     */
+    private func insertCoalesced(_ delta: OSDelta) {
+        guard let executor = deltasToExecutorMap[delta.name] else {
+            deltaQueue.append(delta)
+            return
+        }
+        let supportedDeltas = Set(executor.supportedDeltas)
+        let queued = deltaQueue.filter { supportedDeltas.contains($0.name) }
+        let coalesced = executor.coalesce(delta, into: queued)
+        if coalesced.count != queued.count + 1 {
+            OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo coalesced \(queued.count + 1) deltas into \(coalesced.count)")
+        }
+
+        var result: [OSDelta] = []
+        result.reserveCapacity(deltaQueue.count + 1)
+        var iterator = coalesced.makeIterator()
+        for queuedDelta in deltaQueue {
+            if !supportedDeltas.contains(queuedDelta.name) {
+                result.append(queuedDelta)
+            } else if let next = iterator.next() {
+                result.append(next)
+            }
+        }
+        while let next = iterator.next() {
+            result.append(next)
+        }
+        deltaQueue = result
+    }
+
     @objc public func addFlushDeltaQueueToDispatchQueue(inBackground: Bool = false) {
         self.dispatchQueue.async {
             self.flushDeltaQueue(inBackground: inBackground)
         }
     }
 
+    /**
+     Executors call this after a retryable failure puts a request back in their queue. Nothing else may be enqueued, so the
+     flush scheduler is woken up to send it again.
+     */
+    public func requestRetry() {
+        self.dispatchQueue.async {
+            self.flushScheduler.requestRetry()
+        }
+    }
+
     func flushAndWait() {
         dispatchQueue.sync {
             flushDeltaQueue()
@@ -140,6 +220,8 @@ public class OSOperationRepo: NSObject {
     private func flushDeltaQueue(inBackground: Bool = false) {
         guard !paused else {
             OneSignalLog.onesignalLog(.LL_DEBUG, message: "OSOperationRepo not flushing queue due to being paused")
+            // Unpausing flushes, so stay idle until then
+            flushScheduler.didFlush(hasPendingRequests: false)
             return
         }
 
@@ -153,6 +235,20 @@ public class OSOperationRepo: NSObject {
 
         self.start()
 
+        // Executors persist their queues as part of this flush, synchronize those saves once at the end
+        let userDefaults = OneSignalUserDefaults.initShared()
+        let synchronizeCountBeforeFlush = OneSignalUserDefaults.synchronizeCount()
+        userDefaults.beginBatchedWrites()
+
+        if needsCoalescing {
+            let uncoalesced = self.deltaQueue
+            self.deltaQueue = []
+            for delta in uncoalesced {
+                insertCoalesced(delta)
+            }
+            needsCoalescing = false
+        }
+
         if !self.deltaQueue.isEmpty {
             OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo flushDeltaQueue in background: \(inBackground) with queue: \(self.deltaQueue)")
         }
@@ -169,7 +265,10 @@ public class OSOperationRepo: NSObject {
         self.deltaQueue = unmatched
 
         // Persist the deltas (including removed deltas) to storage after they are divvy'd up to executors.
-        OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_OPERATION_REPO_DELTA_QUEUE_KEY, withValue: self.deltaQueue)
+        // Skip the rewrite when nothing was journaled since the last compaction.
+        if self.journal.recordCount != self.deltaQueue.count || !self.journal.exists {
+            self.journal.rewrite(self.deltaQueue)
+        }
 
         for executor in self.executors {
             executor.cacheDeltaQueue()
@@ -179,6 +278,14 @@ public class OSOperationRepo: NSObject {
             executor.processDeltaQueue(inBackground: inBackground)
         }
 
+        // Checking every executor waits on each of their queues, so the work dispatched above has run before the batch ends
+        let hasPendingRequests = self.executors.map { $0.hasUnsentRequests }.contains(true)
+        userDefaults.endBatchedWrites()
+        OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSOperationRepo flush synchronized UserDefaults \(OneSignalUserDefaults.synchronizeCount() - synchronizeCountBeforeFlush) time(s), \(OneSignalUserDefaults.suiteAllocationCount()) suite(s) allocated")
+
+        // Keep flushing periodically only while requests are waiting to be sent, ie: for a user to be created
+        flushScheduler.didFlush(hasPendingRequests: hasPendingRequests)
+
         if inBackground {
             OSBackgroundTaskManager.endBackgroundTask(OPERATION_REPO_BACKGROUND_TASK)
         }
@@ -44,6 +44,8 @@ public final class OSResilientStorage: NSObject {
     /// Needed because the NSE reads this flag from shared UserDefaults while the device may be locked
     /// and the read silently returns the default (NO). Stored as "1" / "0".
     @objc public static let keyReceiveReceiptsEnabled = "receive_receipts_enabled"
+    /// Read by the NSE for the same reason, "1" when receipts are sent in batches.
+    @objc public static let keyReceiveReceiptsBatchEnabled = "receive_receipts_batch_enabled"
     /// Set to `"1"` once `OneSignalUserManagerImpl.start()` has completed at least once on this app
     /// install; cleared on app-id change. Read at startup to distinguish a true fresh install from
     /// a prior session whose UserDefaults isn't readable yet (ie: during iOS prewarm before first unlock).
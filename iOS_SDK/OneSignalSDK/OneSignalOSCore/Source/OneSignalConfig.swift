@@ -39,6 +39,18 @@ public final class OneSignalConfig: NSObject {
     /// which is correct for NSE since it reads identifiers through `OSResilientStorage`.
     @objc public static var isProtectedDataAvailableProvider: (() -> Bool)?
 
+    /// Operation Repo flush scheduling. A flush happens once no delta has been enqueued for the debounce window,
+    /// but never later than the maximum latency after the first pending delta, or as soon as the batch size is reached.
+    @objc public static var operationRepoFlushDebounceMilliseconds = Int(OP_REPO_FLUSH_DEBOUNCE_MS)
+    @objc public static var operationRepoMaxFlushLatencyMilliseconds = Int(POLL_INTERVAL_MS)
+    @objc public static var operationRepoMaxFlushBatchSize = Int(OP_REPO_MAX_FLUSH_BATCH_SIZE)
+
+    /// Custom events batching. A user's events are sent together once there are enough of them to fill a request by count or size,
+    /// once the oldest has waited for the maximum linger time, or when the app is backgrounded.
+    @objc public static var customEventsMaxBatchSize = Int(CUSTOM_EVENTS_MAX_BATCH_SIZE)
+    @objc public static var customEventsMaxBatchBytes = Int(CUSTOM_EVENTS_MAX_BATCH_BYTES)
+    @objc public static var customEventsMaxLingerMilliseconds = Int(CUSTOM_EVENTS_MAX_LINGER_MS)
+
     /// Returns true when the SDK shouldn't perform an operation yet because:
     ///   * `app_id` hasn't been set via `OneSignal.initialize`, or
     ///   * the host app hasn't granted privacy consent, or
@@ -0,0 +1,194 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import XCTest
+import OneSignalCore
+@testable import OneSignalOSCore
+
+/// Drives `OSFlushScheduler` with a virtual clock, so wakeups and flush latency are deterministic.
+final class OSFlushSchedulerTests: XCTestCase {
+
+    private var clock: VirtualClockDispatchQueue!
+    private var scheduler: OSFlushScheduler!
+    private var flushTimes: [UInt64] = []
+    private var hasPendingRequests = false
+
+    override func setUp() {
+        super.setUp()
+        clock = VirtualClockDispatchQueue()
+        flushTimes = []
+        hasPendingRequests = false
+        scheduler = OSFlushScheduler(queue: clock, now: { [unowned self] in self.clock.now }) { [unowned self] in
+            self.flushTimes.append(self.clock.elapsedMilliseconds)
+            self.scheduler.didFlush(hasPendingRequests: self.hasPendingRequests)
+        }
+        scheduler.debounceMilliseconds = { 1_000 }
+        scheduler.maxLatencyMilliseconds = { 5_000 }
+        scheduler.maxBatchSize = { 100 }
+    }
+
+    func testIdle_hasZeroWakeups() {
+        clock.advance(byMilliseconds: 60 * 60 * 1_000)
+
+        XCTAssertEqual(scheduler.wakeups, 0)
+        XCTAssertEqual(clock.scheduledCount, 0)
+        XCTAssertTrue(flushTimes.isEmpty)
+    }
+
+    func testSingleEnqueue_flushesAfterDebounce_thenGoesIdle() {
+        scheduler.deltaEnqueued(pendingCount: 1)
+        clock.advance(byMilliseconds: 60_000)
+
+        XCTAssertEqual(flushTimes, [1_000])
+        XCTAssertEqual(scheduler.wakeups, 1)
+        XCTAssertFalse(scheduler.isArmed)
+    }
+
+    func testBurstWithinDebounce_flushesOnceAfterLastEnqueue() {
+        for _ in 0..<10 {
+            scheduler.deltaEnqueued(pendingCount: 1)
+            clock.advance(byMilliseconds: 100)
+        }
+        clock.advance(byMilliseconds: 60_000)
+
+        // The last enqueue happened at 900ms
+        XCTAssertEqual(flushTimes, [1_900])
+        // Re-arming is lazy: one wakeup at the first deadline, one at the extended deadline
+        XCTAssertEqual(scheduler.wakeups, 2)
+    }
+
+    func testSustainedLoad_latencyIsBoundedByMaxLatency() {
+        // An enqueue every 500ms never lets the debounce window elapse
+        for _ in 0..<40 {
+            scheduler.deltaEnqueued(pendingCount: 1)
+            clock.advance(byMilliseconds: 500)
+        }
+
+        XCTAssertEqual(flushTimes, [5_000, 10_000, 15_000, 20_000])
+        var previous: UInt64 = 0
+        for time in flushTimes {
+            XCTAssertLessThanOrEqual(time - previous, 5_000)
+            previous = time
+        }
+    }
+
+    func testFullBatch_flushesImmediately() {
+        scheduler.deltaEnqueued(pendingCount: 1)
+        clock.advance(byMilliseconds: 10)
+        scheduler.deltaEnqueued(pendingCount: 100)
+        clock.advance(byMilliseconds: 0)
+
+        XCTAssertEqual(flushTimes, [10])
+    }
+
+    func testUnsentRequests_keepPollingUntilSent() {
+        hasPendingRequests = true
+        scheduler.deltaEnqueued(pendingCount: 1)
+        clock.advance(byMilliseconds: 11_000)
+        XCTAssertEqual(flushTimes, [1_000, 6_000, 11_000])
+
+        hasPendingRequests = false
+        clock.advance(byMilliseconds: 60_000)
+        XCTAssertEqual(flushTimes, [1_000, 6_000, 11_000, 16_000])
+        XCTAssertFalse(scheduler.isArmed)
+    }
+
+    func testRequestRetry_afterIdle_flushesAtMaxLatencyWithoutEnqueue() {
+        // The request is still in flight when the flush ends, so the scheduler goes idle
+        scheduler.deltaEnqueued(pendingCount: 1)
+        clock.advance(byMilliseconds: 3_000)
+        XCTAssertEqual(flushTimes, [1_000])
+        XCTAssertFalse(scheduler.isArmed)
+
+        // It then fails with a retryable error and is requeued by its executor
+        scheduler.requestRetry()
+        clock.advance(byMilliseconds: 60_000)
+
+        XCTAssertEqual(flushTimes, [1_000, 8_000])
+        XCTAssertFalse(scheduler.isArmed)
+    }
+
+    func testRequestRetry_doesNotDelayArmedFlush() {
+        scheduler.deltaEnqueued(pendingCount: 1)
+        scheduler.requestRetry()
+        clock.advance(byMilliseconds: 60_000)
+
+        XCTAssertEqual(flushTimes, [1_000])
+        XCTAssertEqual(scheduler.wakeups, 1)
+    }
+
+    func testExplicitFlush_cancelsArmedTimer() {
+        scheduler.deltaEnqueued(pendingCount: 1)
+        scheduler.didFlush(hasPendingRequests: false)
+        clock.advance(byMilliseconds: 60_000)
+
+        XCTAssertTrue(flushTimes.isEmpty)
+        XCTAssertEqual(scheduler.wakeups, 0)
+    }
+}
+
+/// An `OSDispatchQueue` whose time only moves when the test advances it. Work runs inline on the test thread.
+private final class VirtualClockDispatchQueue: OSDispatchQueue {
+    private let origin = DispatchTime(uptimeNanoseconds: 1_000_000_000)
+    private var elapsedNanoseconds: UInt64 = 0
+    private var scheduled: [(deadline: DispatchTime, sequence: Int, work: () -> Void)] = []
+    private var sequence = 0
+
+    var now: DispatchTime {
+        DispatchTime(uptimeNanoseconds: origin.uptimeNanoseconds + elapsedNanoseconds)
+    }
+
+    var elapsedMilliseconds: UInt64 {
+        elapsedNanoseconds / 1_000_000
+    }
+
+    var scheduledCount: Int {
+        scheduled.count
+    }
+
+    func async(execute work: @escaping @convention(block) () -> Void) {
+        asyncAfterTime(deadline: now, execute: work)
+    }
+
+    func asyncAfterTime(deadline: DispatchTime, execute work: @escaping @Sendable @convention(block) () -> Void) {
+        sequence += 1
+        scheduled.append((deadline, sequence, work))
+    }
+
+    /// Runs due work in deadline order, including work scheduled while advancing.
+    func advance(byMilliseconds milliseconds: UInt64) {
+        let target = elapsedNanoseconds + milliseconds * 1_000_000
+        while let next = scheduled.min(by: { ($0.deadline, $0.sequence) < ($1.deadline, $1.sequence) }),
+              next.deadline.uptimeNanoseconds <= origin.uptimeNanoseconds + target {
+            scheduled.removeAll { $0.sequence == next.sequence }
+            elapsedNanoseconds = max(elapsedNanoseconds, next.deadline.uptimeNanoseconds - origin.uptimeNanoseconds)
+            next.work()
+        }
+        elapsedNanoseconds = target
+    }
+}
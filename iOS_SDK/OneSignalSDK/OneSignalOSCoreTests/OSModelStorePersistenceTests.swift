@@ -0,0 +1,151 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import XCTest
+import OneSignalCore
+@testable import OneSignalOSCore
+
+final class OSModelStorePersistenceTestModel: OSModel {
+    var name: String?
+    var count = 0
+    var enabled = false
+    var tags: [String: String] = [:]
+
+    override func encode(with coder: NSCoder) {
+        super.encode(with: coder)
+        coder.encode(name, forKey: "name")
+        coder.encode(count, forKey: "count")
+        coder.encode(enabled, forKey: "enabled")
+        coder.encode(tags, forKey: "tags")
+    }
+
+    init() {
+        super.init(changeNotifier: OSEventProducer())
+    }
+
+    required init?(coder: NSCoder) {
+        super.init(coder: coder)
+        name = coder.decodeObject(forKey: "name") as? String
+        count = coder.decodeInteger(forKey: "count")
+        enabled = coder.decodeBool(forKey: "enabled")
+        tags = coder.decodeObject(forKey: "tags") as? [String: String] ?? [:]
+    }
+}
+
+final class OSModelStorePersistenceTests: XCTestCase {
+
+    private let storeKey = "OSModelStorePersistenceTests_storeKey"
+
+    override func setUp() {
+        super.setUp()
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
+    }
+
+    override func tearDown() {
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
+        super.tearDown()
+    }
+
+    private func makeStore() -> OSModelStore<OSModelStorePersistenceTestModel> {
+        return OSModelStore<OSModelStorePersistenceTestModel>(changeSubscription: OSEventProducer(), storeKey: storeKey)
+    }
+
+    private func makeModel(_ name: String) -> OSModelStorePersistenceTestModel {
+        let model = OSModelStorePersistenceTestModel()
+        model.name = name
+        model.count = 7
+        model.enabled = true
+        // A dictionary that looks like an encoded object must survive as a dictionary
+        model.tags = ["a": "1", OSModelBinaryCoder.classKey: "not a class"]
+        return model
+    }
+
+    func testBinaryCoder_roundTripsModel() throws {
+        let model = makeModel("model")
+
+        let data = try XCTUnwrap(OSModelBinaryCoder.encode(model))
+        let decoded = try XCTUnwrap(OSModelBinaryCoder.decode(data) as? OSModelStorePersistenceTestModel)
+
+        XCTAssertEqual(decoded.modelId, model.modelId)
+        XCTAssertEqual(decoded.name, "model")
+        XCTAssertEqual(decoded.count, 7)
+        XCTAssertTrue(decoded.enabled)
+        XCTAssertEqual(decoded.tags, model.tags)
+        XCTAssertLessThan(data.count, try NSKeyedArchiver.archivedData(withRootObject: model, requiringSecureCoding: false).count)
+    }
+
+    func testStore_persistsModelsIndividually() {
+        let store = makeStore()
+        let first = makeModel("first")
+        let second = makeModel("second")
+        store.add(id: "first", model: first, hydrating: true)
+        store.add(id: "second", model: second, hydrating: true)
+
+        second.name = "second updated"
+        second.set(property: "name", newValue: "second updated")
+        store.remove("first")
+
+        let reloaded = makeStore().getModels()
+        XCTAssertEqual(Set(reloaded.keys), ["second"])
+        XCTAssertEqual(reloaded["second"]?.modelId, second.modelId)
+        XCTAssertEqual(reloaded["second"]?.name, "second updated")
+
+        // The removed model's entry is gone, not just dropped from the index
+        let firstKey = storeKey + "_MODEL_" + first.modelId
+        XCTAssertFalse(OneSignalUserDefaults.initShared().keyExists(firstKey))
+    }
+
+    func testStore_migratesLegacyBlob() {
+        let model = makeModel("legacy")
+        OneSignalUserDefaults.initShared().saveCodeableData(forKey: storeKey, withValue: ["legacy": model])
+
+        let store = makeStore()
+
+        XCTAssertEqual(store.getModel(key: "legacy")?.modelId, model.modelId)
+        XCTAssertEqual(store.getModel(key: "legacy")?.name, "legacy")
+        XCTAssertTrue(OneSignalUserDefaults.initShared().keyExists(storeKey), "The legacy blob is kept for SDKs that only read it")
+        XCTAssertTrue(OSModelStorePersistence.hasPersistedModels(storeKey: storeKey))
+        XCTAssertEqual(makeStore().getModel(key: "legacy")?.modelId, model.modelId)
+
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
+        XCTAssertFalse(OneSignalUserDefaults.initShared().keyExists(storeKey))
+        XCTAssertFalse(OSModelStorePersistence.hasPersistedModels(storeKey: storeKey))
+    }
+
+    func testRemoveAll_thenUpdate_rewritesIndex() {
+        let store = makeStore()
+        let model = makeModel("model")
+        store.add(id: "model", model: model, hydrating: true)
+
+        store.removeModelsFromUserDefaults()
+        XCTAssertFalse(OSModelStorePersistence.hasPersistedModels(storeKey: storeKey))
+
+        model.set(property: "name", newValue: "model")
+        XCTAssertEqual(makeStore().getModel(key: "model")?.modelId, model.modelId)
+    }
+}
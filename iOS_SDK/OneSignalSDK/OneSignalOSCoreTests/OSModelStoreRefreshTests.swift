@@ -39,16 +39,16 @@ final class OSModelStoreRefreshTests: XCTestCase {
 
     override func setUp() {
         super.setUp()
-        OneSignalUserDefaults.initShared().removeValue(forKey: storeKey)
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
     }
 
     override func tearDown() {
-        OneSignalUserDefaults.initShared().removeValue(forKey: storeKey)
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
         super.tearDown()
     }
 
-    /// Seed UserDefaults with a serialized models dict, the same way `OSModelStore.add`
-    /// persists. Mimics "prior session wrote models to disk".
+    /// Seed UserDefaults with a serialized models dict, the way older SDKs persisted a store.
+    /// Mimics "prior session wrote models to disk"; the store migrates it on load.
     private func seedUserDefaults(with models: [String: OSModel]) {
         OneSignalUserDefaults.initShared().saveCodeableData(forKey: storeKey, withValue: models)
     }
@@ -114,13 +114,15 @@ final class OSModelStoreRefreshTests: XCTestCase {
 
         // Mutate via set(property:) — triggers fire() on changeNotifier. If refresh() wired
         // the subscription, the store's onModelUpdated will receive it and persist the
-        // dict back to UserDefaults.
-        OneSignalUserDefaults.initShared().removeValue(forKey: storeKey)
+        // model back to UserDefaults.
+        store.removeModelsFromUserDefaults()
+        XCTAssertFalse(OSModelStorePersistence.hasPersistedModels(storeKey: storeKey))
         loaded.set(property: "test_prop", newValue: "test_value")
 
         // After the mutation, UD should be repopulated by onModelUpdated.
-        let written = OneSignalUserDefaults.initShared().getSavedCodeableData(forKey: storeKey, defaultValue: nil)
-        XCTAssertNotNil(written, "Mutating a refresh()-hydrated model should persist via the store's onModelUpdated handler")
+        XCTAssertTrue(OSModelStorePersistence.hasPersistedModels(storeKey: storeKey),
+                      "Mutating a refresh()-hydrated model should persist via the store's onModelUpdated handler")
+        XCTAssertEqual(makeStore().getModel(key: "key_x")?.modelId, loaded.modelId)
     }
 
     /// Sanity: when there's nothing on disk, refresh() leaves an empty store empty.
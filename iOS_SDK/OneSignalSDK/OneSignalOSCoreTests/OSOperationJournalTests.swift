@@ -0,0 +1,137 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import Foundation
+import XCTest
+import OneSignalCore
+@testable import OneSignalOSCore
+
+final class OSOperationJournalTests: XCTestCase {
+
+    private var fileURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        fileURL = FileManager.default.temporaryDirectory.appendingPathComponent("journal_\(UUID().uuidString)")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: fileURL)
+        super.tearDown()
+    }
+
+    func testLoad_returnsNilWhenJournalDoesNotExist() {
+        XCTAssertNil(OSOperationJournal(fileURL: fileURL).load())
+    }
+
+    func testAppendThenLoad_preservesOrderAcrossInstances() {
+        let journal = OSOperationJournal(fileURL: fileURL)
+        journal.append(makeDelta(property: "a"))
+        journal.append(makeDelta(property: "b"))
+        journal.append(makeDelta(property: "c"))
+
+        // A new instance simulates a process restart
+        let loaded = OSOperationJournal(fileURL: fileURL).load() as? [OSDelta]
+        XCTAssertEqual(loaded?.map(\.property), ["a", "b", "c"])
+    }
+
+    func testRewrite_compactsToLiveRecords() {
+        let journal = OSOperationJournal(fileURL: fileURL)
+        journal.append(makeDelta(property: "a"))
+        journal.append(makeDelta(property: "b"))
+        journal.rewrite([makeDelta(property: "c")])
+        XCTAssertEqual(journal.recordCount, 1)
+
+        journal.append(makeDelta(property: "d"))
+        let loaded = OSOperationJournal(fileURL: fileURL).load() as? [OSDelta]
+        XCTAssertEqual(loaded?.map(\.property), ["c", "d"])
+    }
+
+    func testLoad_discardsTruncatedTrailingRecord() throws {
+        let journal = OSOperationJournal(fileURL: fileURL)
+        journal.append(makeDelta(property: "a"))
+        journal.append(makeDelta(property: "b"))
+
+        // Simulate a crash in the middle of the second append
+        let data = try Data(contentsOf: fileURL)
+        try data.prefix(data.count - 10).write(to: fileURL)
+
+        let reloaded = OSOperationJournal(fileURL: fileURL)
+        XCTAssertEqual((reloaded.load() as? [OSDelta])?.map(\.property), ["a"])
+
+        // The torn tail is dropped so later appends stay readable
+        reloaded.append(makeDelta(property: "c"))
+        XCTAssertEqual((OSOperationJournal(fileURL: fileURL).load() as? [OSDelta])?.map(\.property), ["a", "c"])
+    }
+
+    /// Compares enqueueing 10k deltas through the journal against re-archiving the whole queue into
+    /// UserDefaults per enqueue, as `OSOperationRepo` did previously. Set `ONESIGNAL_RUN_BENCHMARKS`
+    /// to run it; the UserDefaults path is quadratic and takes minutes.
+    func testBenchmark_journalVersusUserDefaultsEnqueue() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let deltaCount = 10_000
+        let deltas = (0..<deltaCount).map { makeDelta(property: "tag_\($0)") }
+
+        let journal = OSOperationJournal(fileURL: fileURL)
+        var start = Date()
+        for delta in deltas {
+            journal.append(delta)
+        }
+        let journalSeconds = Date().timeIntervalSince(start)
+
+        let suiteName = "OSOperationJournalTests.\(UUID().uuidString)"
+        let userDefaults = try XCTUnwrap(UserDefaults(suiteName: suiteName))
+        defer { userDefaults.removePersistentDomain(forName: suiteName) }
+        var queue: [OSDelta] = []
+        var userDefaultsBytes = 0
+        start = Date()
+        for delta in deltas {
+            queue.append(delta)
+            let data = try NSKeyedArchiver.archivedData(withRootObject: queue, requiringSecureCoding: false)
+            userDefaults.set(data, forKey: OS_OPERATION_REPO_DELTA_QUEUE_KEY)
+            userDefaults.synchronize()
+            userDefaultsBytes += data.count
+        }
+        let userDefaultsSeconds = Date().timeIntervalSince(start)
+
+        print("OSOperationJournal benchmark (\(deltaCount) deltas): journal \(journalSeconds)s / \(journal.bytesWritten) bytes, UserDefaults \(userDefaultsSeconds)s / \(userDefaultsBytes) bytes")
+        XCTAssertEqual(OSOperationJournal(fileURL: fileURL).load()?.count, deltaCount)
+        XCTAssertLessThan(journal.bytesWritten, userDefaultsBytes)
+    }
+
+    // MARK: - Helpers
+
+    private func makeDelta(property: String) -> OSDelta {
+        OSDelta(
+            name: "test_delta",
+            identityModelId: UUID().uuidString,
+            model: OSModel(changeNotifier: OSEventProducer()),
+            property: property,
+            value: property
+        )
+    }
+}
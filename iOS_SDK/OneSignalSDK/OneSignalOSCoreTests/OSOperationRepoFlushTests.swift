@@ -41,13 +41,16 @@ final class OSOperationRepoFlushTests: XCTestCase {
         super.setUp()
         OneSignalIdentifiers.currentAppId = "test-app-id"
         resetOperationRepo()
-        // Pause so the poller (started by addExecutor/start) cannot flush mid-setup.
+        // Pause so the flush scheduler cannot flush mid-setup.
         OSOperationRepo.sharedInstance.paused = true
-        OSOperationRepo.sharedInstance.pollIntervalMilliseconds = 60_000
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = 60_000
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = 60_000
     }
 
     override func tearDown() {
         resetOperationRepo()
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = Int(OP_REPO_FLUSH_DEBOUNCE_MS)
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = Int(POLL_INTERVAL_MS)
         super.tearDown()
     }
 
@@ -119,6 +122,57 @@ final class OSOperationRepoFlushTests: XCTestCase {
         XCTAssertEqual(repo.deltaQueue.map(\.property), ["unknown-1", "unknown-2"])
     }
 
+    func testEnqueue_coalescesThroughExecutorAndKeepsOtherDeltasInPlace() {
+        let executor = MockOperationExecutor(supportedDeltas: [knownDelta])
+        executor.coalescesByProperty = true
+        let processExpectation = expectation(description: "processDeltaQueue")
+        executor.onProcessDeltaQueue = { processExpectation.fulfill() }
+
+        let repo = OSOperationRepo.sharedInstance
+        repo.addExecutor(executor)
+
+        repo.enqueueDelta(makeDelta(name: knownDelta, property: "a"))
+        repo.enqueueDelta(makeDelta(name: unknownDelta, property: "unknown-1"))
+        repo.enqueueDelta(makeDelta(name: knownDelta, property: "a"))
+        repo.enqueueDelta(makeDelta(name: knownDelta, property: "b"))
+        repo.enqueueDelta(makeDelta(name: knownDelta, property: "a"))
+        waitUntil("all deltas enqueued") { repo.deltaQueue.count == 3 && repo.deltaQueue.last?.property == "b" }
+
+        XCTAssertEqual(repo.deltaQueue.map(\.property), ["a", "unknown-1", "b"])
+
+        repo.paused = false
+        repo.addFlushDeltaQueueToDispatchQueue()
+        wait(for: [processExpectation], timeout: 2.0)
+
+        XCTAssertEqual(executor.enqueued.map(\.property), ["a", "b"])
+        XCTAssertEqual(repo.deltaQueue.map(\.property), ["unknown-1"])
+    }
+
+    func testFlush_synchronizesUserDefaultsOnce() {
+        let executor = MockOperationExecutor(supportedDeltas: [knownDelta])
+        executor.savesOnCache = 5
+        let processExpectation = expectation(description: "processDeltaQueue")
+        executor.onProcessDeltaQueue = { processExpectation.fulfill() }
+
+        let repo = OSOperationRepo.sharedInstance
+        repo.addExecutor(executor)
+        repo.enqueueDelta(makeDelta(name: knownDelta, property: "a"))
+        waitUntil("delta enqueued") { repo.deltaQueue.count == 1 }
+
+        let suiteAllocationCount = OneSignalUserDefaults.suiteAllocationCount()
+        let synchronizeCount = OneSignalUserDefaults.synchronizeCount()
+        // Unpausing flushes
+        repo.paused = false
+        wait(for: [processExpectation], timeout: 2.0)
+        waitUntil("batch ended") { OneSignalUserDefaults.synchronizeCount() > synchronizeCount }
+
+        XCTAssertEqual(OneSignalUserDefaults.synchronizeCount() - synchronizeCount, 1)
+        XCTAssertEqual(OneSignalUserDefaults.suiteAllocationCount(), suiteAllocationCount)
+        for index in 0..<executor.savesOnCache {
+            OneSignalUserDefaults.initShared().removeValue(forKey: "OSOperationRepoFlushTests_\(index)")
+        }
+    }
+
     // MARK: - Helpers
 
     private func resetOperationRepo() {
@@ -163,6 +217,10 @@ private final class MockOperationExecutor: OSOperationExecutor {
     let supportedDeltas: [String]
     private(set) var enqueued: [OSDelta] = []
     var onProcessDeltaQueue: (() -> Void)?
+    // When set, a delta replaces the queued delta with the same property
+    var coalescesByProperty = false
+    // The number of values saved to UserDefaults when caching the delta queue
+    var savesOnCache = 0
 
     init(supportedDeltas: [String]) {
         self.supportedDeltas = supportedDeltas
@@ -172,7 +230,20 @@ private final class MockOperationExecutor: OSOperationExecutor {
         enqueued.append(delta)
     }
 
-    func cacheDeltaQueue() {}
+    func cacheDeltaQueue() {
+        for index in 0..<savesOnCache {
+            OneSignalUserDefaults.initShared().saveInteger(forKey: "OSOperationRepoFlushTests_\(index)", withValue: enqueued.count)
+        }
+    }
+
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta] {
+        guard coalescesByProperty, let index = queued.firstIndex(where: { $0.property == delta.property }) else {
+            return queued + [delta]
+        }
+        var coalesced = queued
+        coalesced[index] = delta
+        return coalesced
+    }
 
     func processDeltaQueue(inBackground: Bool) {
         onProcessDeltaQueue?()
@@ -36,6 +36,10 @@ NSString * const WEIGHT = @"weight";
 NSString * const IS_DIRECT = @"direct";
 NSString * const NOTIFICATION_IDS = @"notification_ids";
 
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 + (instancetype _Nonnull)directWithOutcome:(OSOutcomeEvent * _Nonnull)outcome
                                      appId:(NSString * _Nonnull)appId
                                 deviceType:(NSNumber * _Nonnull)deviceType {
@@ -108,6 +112,10 @@ NSString * const NOTIFICATION_IDS = @"notification_ids";
 @end
 
 @implementation OSRequestSendOutcomesV2ToServer
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 NSString * const OUTCOME_SOURCE = @"source";
 
 + (instancetype)measureOutcomeEvent:(OSOutcomeEventParams *)outcome appId:(NSString *)appId deviceType:(NSNumber *)deviceType {
@@ -127,6 +135,10 @@ NSString * const OUTCOME_SOURCE = @"source";
 @end
 
 @implementation OSRequestSendSessionEndOutcomes
+- (OSRequestLane)lane {
+    return OSRequestLaneAnalytics;
+}
+
 
 + (instancetype _Nonnull)withActiveTime:(NSNumber * _Nonnull)activeTime
                                   appId:(NSString * _Nonnull)appId
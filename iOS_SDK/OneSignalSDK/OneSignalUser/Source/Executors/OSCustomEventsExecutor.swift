@@ -29,26 +29,12 @@ import OneSignalOSCore
 import OneSignalCore
 
 class OSCustomEventsExecutor: OSOperationExecutor {
-    private enum EventConstants {
-        static let name = "name"
-        static let onesignalId = "onesignal_id"
-        static let timestamp = "timestamp"
-        static let payload = "payload"
-        static let deviceType = "device_type"
-        static let sdk = "sdk"
-        static let appVersion = "app_version"
-        static let type = "type"
-        static let deviceModel = "device_model"
-        static let deviceOs = "device_os"
-        static let osSdk = "os_sdk"
-        static let ios = "ios"
-        static let iOSPush = "iOSPush"
-    }
-
     var supportedDeltas: [String] = [OS_CUSTOM_EVENT_DELTA]
     private var deltaQueue: [OSDelta] = []
     private var requestQueue: [OSRequestCustomEvents] = []
     private let newRecordsState: OSNewRecordsState
+    // When the scheduled send of lingering partial batches fires, if one is scheduled
+    private var lingerFlushDeadline: Date?
 
     // The executor dispatch queue, serial. This synchronizes access to `deltaQueue` and `requestQueue`.
     private let dispatchQueue = DispatchQueue(label: "OneSignal.OSCustomEventsExecutor", target: .global())
@@ -116,144 +102,131 @@ class OSCustomEventsExecutor: OSOperationExecutor {
         }
     }
 
-    /// The `deltaQueue` can contain events for multiple users. They will remain as Deltas if there is no onesignal ID yet for its user.
-    /// This method will be used in an upcoming release that combine multiple events.
-    func processDeltaQueueWithBatching(inBackground: Bool) {
-        self.dispatchQueue.async {
-            if self.deltaQueue.isEmpty {
-                // Delta queue is empty but there may be pending requests
-                self.processRequestQueue(inBackground: inBackground)
-                return
-            }
-            OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor processDeltaQueue with queue: \(self.deltaQueue)")
-
-            // Holds mapping of identity model ID to the events for it
-            var combinedEvents: [String: [[String: Any]]] = [:]
-
-            // 1. Combine the events for every distinct user
-            for (index, delta) in self.deltaQueue.enumerated().reversed() {
-                guard let identityModel = OneSignalUserManagerImpl.sharedInstance.getIdentityModel(delta.identityModelId),
-                      let onesignalId = identityModel.onesignalId
-                else {
-                    OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor.processDeltaQueue skipping: \(delta)")
-                    // keep this Delta in the queue, as it is not yet ready to be processed
-                    continue
-                }
-
-                guard let properties = delta.value as? [String: Any] else {
-                    // This should not happen as there are preventative typing measures before this step
-                    OneSignalLog.onesignalLog(.LL_ERROR, message: "OSCustomEventsExecutor.processDeltaQueue dropped due to invalid properties: \(delta)")
-                    self.deltaQueue.remove(at: index)
-                    continue
-                }
-
-                let event: [String: Any] = [
-                    EventConstants.name: delta.property,
-                    EventConstants.onesignalId: onesignalId,
-                    EventConstants.timestamp: ISO8601DateFormatter().string(from: delta.timestamp),
-                    EventConstants.payload: self.addSdkMetadata(properties: properties)
-                ]
-
-                combinedEvents[identityModel.modelId, default: []].append(event)
-                self.deltaQueue.remove(at: index)
-            }
-
-            // 2. Turn each user's events into a Request
-            for (modelId, events) in combinedEvents {
-                guard let identityModel = OneSignalUserManagerImpl.sharedInstance.getIdentityModel(modelId)
-                else {
-                    // This should never happen as we already checked this during Deltas processing above
-                    continue
-                }
-                let request = OSRequestCustomEvents(
-                    events: events,
-                    identityModel: identityModel
-                )
-                self.requestQueue.append(request)
+    var hasUnsentRequests: Bool {
+        self.dispatchQueue.sync {
+            // Lingering partial batches are sent by the linger flush, only deltas waiting for their user's onesignal ID need another flush
+            self.requestQueue.contains { !$0.sentToClient } || self.deltaQueue.contains { delta in
+                OneSignalUserManagerImpl.sharedInstance.getIdentityModel(delta.identityModelId)?.onesignalId == nil
             }
-
-            // Persist executor's requests (including new request) to storage
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY, withValue: self.requestQueue)
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY, withValue: self.deltaQueue)
-
-            self.processRequestQueue(inBackground: inBackground)
         }
     }
 
+    /**
+     The `deltaQueue` can contain events for multiple users. They will remain as Deltas if there is no onesignal ID yet for its user.
+     Each user's events are combined into requests of up to `customEventsMaxBatchSize` events and `customEventsMaxBatchBytes`.
+     A partial batch stays in the `deltaQueue`, which is persisted, until its oldest event has lingered for `customEventsMaxLingerMilliseconds`
+     or the app is backgrounded.
+     */
     func processDeltaQueue(inBackground: Bool) {
         self.dispatchQueue.async {
-            if self.deltaQueue.isEmpty {
-                // Delta queue is empty but there may be pending requests
-                self.processRequestQueue(inBackground: inBackground)
-                return
+            self.batchDeltaQueue(sendPartialBatches: inBackground)
+            self.processRequestQueue(inBackground: inBackground)
+        }
+    }
+
+    /// This method is called on the dispatchQueue only.
+    private func batchDeltaQueue(sendPartialBatches: Bool) {
+        if self.deltaQueue.isEmpty {
+            return
+        }
+        OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor processDeltaQueue with queue: \(self.deltaQueue)")
+
+        // Holds each user's events in the order they were tracked, keyed by identity model ID
+        var pendingBatches: [String: OSCustomEventsBatch] = [:]
+        var userOrder: [String] = []
+        var remainingDeltas: [OSDelta] = []
+
+        for delta in self.deltaQueue {
+            guard let identityModel = OneSignalUserManagerImpl.sharedInstance.getIdentityModel(delta.identityModelId),
+                  let onesignalId = identityModel.onesignalId
+            else {
+                OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor.processDeltaQueue skipping: \(delta)")
+                // keep this Delta in the queue, as it is not yet ready to be processed
+                remainingDeltas.append(delta)
+                continue
             }
-            OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor processDeltaQueue with queue: \(self.deltaQueue)")
-
-            for (index, delta) in self.deltaQueue.enumerated().reversed() {
-                guard let identityModel = OneSignalUserManagerImpl.sharedInstance.getIdentityModel(delta.identityModelId),
-                      let onesignalId = identityModel.onesignalId
-                else {
-                    OneSignalLog.onesignalLog(.LL_VERBOSE, message: "OSCustomEventsExecutor.processDeltaQueue skipping: \(delta)")
-                    // keep this Delta in the queue, as it is not yet ready to be processed
-                    continue
-                }
 
-                guard let properties = delta.value as? [String: Any] else {
-                    // This should not happen as there are preventative typing measures before this step
-                    OneSignalLog.onesignalLog(.LL_ERROR, message: "OSCustomEventsExecutor.processDeltaQueue dropped due to invalid properties: \(delta)")
-                    self.deltaQueue.remove(at: index)
-                    continue
-                }
+            guard let properties = delta.value as? [String: Any] else {
+                // This should not happen as there are preventative typing measures before this step
+                OneSignalLog.onesignalLog(.LL_ERROR, message: "OSCustomEventsExecutor.processDeltaQueue dropped due to invalid properties: \(delta)")
+                continue
+            }
 
-                let event: [String: Any] = [
-                    EventConstants.name: delta.property,
-                    EventConstants.onesignalId: onesignalId,
-                    EventConstants.timestamp: ISO8601DateFormatter().string(from: delta.timestamp),
-                    EventConstants.payload: self.addSdkMetadata(properties: properties)
-                ]
+            let event = OSCustomEvent(name: delta.property, onesignalId: onesignalId, timestamp: delta.timestamp, properties: properties)
 
-                self.deltaQueue.remove(at: index)
+            if pendingBatches[identityModel.modelId] == nil {
+                userOrder.append(identityModel.modelId)
+            }
+            var batch = pendingBatches[identityModel.modelId] ?? OSCustomEventsBatch(identityModel: identityModel)
+            let eventSize = event.estimatedSize
+            if batch.isFull(adding: eventSize) {
+                self.requestQueue.append(batch.makeRequest())
+                batch = OSCustomEventsBatch(identityModel: identityModel)
+            }
+            batch.add(event.jsonObject(), delta: delta, size: eventSize)
+            pendingBatches[identityModel.modelId] = batch
+        }
 
-                let request = OSRequestCustomEvents(
-                    events: [event],
-                    identityModel: identityModel
-                )
-                self.requestQueue.append(request)
+        // Send what is left of each user's events if it has lingered long enough, otherwise keep it for a later flush
+        let maxLinger = Double(OneSignalConfig.customEventsMaxLingerMilliseconds) / 1000
+        var nextLingerDeadline: Date?
+        for modelId in userOrder {
+            guard let batch = pendingBatches[modelId], let oldest = batch.oldestTimestamp else {
+                continue
+            }
+            let lingerDeadline = oldest.addingTimeInterval(maxLinger)
+            if sendPartialBatches || batch.isFull(adding: 0) || lingerDeadline <= Date() {
+                self.requestQueue.append(batch.makeRequest())
+            } else {
+                remainingDeltas.append(contentsOf: batch.deltas)
+                nextLingerDeadline = min(nextLingerDeadline ?? lingerDeadline, lingerDeadline)
             }
+        }
+        // Keep the remaining deltas in the order they were queued
+        let remaining = Set(remainingDeltas.map { ObjectIdentifier($0) })
+        self.deltaQueue.removeAll { !remaining.contains(ObjectIdentifier($0)) }
 
-            // Persist executor's requests (including new request) to storage
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY, withValue: self.requestQueue)
-            OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY, withValue: self.deltaQueue)
+        // Persist executor's requests (including new requests) to storage
+        OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY, withValue: self.requestQueue)
+        OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY, withValue: self.deltaQueue)
 
-            self.processRequestQueue(inBackground: inBackground)
+        if let nextLingerDeadline {
+            scheduleLingerFlush(at: nextLingerDeadline)
         }
     }
 
-    /**
-     Adds additional data about the SDK to the event payload.
-     */
-    private func addSdkMetadata(properties: [String: Any]) -> [String: Any] {
-        // TODO: Exact information contained in payload should be confirmed before the custom events GA release
-        let metadata = [
-            EventConstants.deviceType: EventConstants.ios,
-            EventConstants.sdk: ONESIGNAL_VERSION,
-            EventConstants.appVersion: Bundle.main.infoDictionary?["CFBundleShortVersionString"] as? String,
-            EventConstants.type: EventConstants.iOSPush,
-            EventConstants.deviceModel: OSDeviceUtils.getDeviceVariant(),
-            EventConstants.deviceOs: UIDevice.current.systemVersion
-        ]
-        var payload = properties
-        payload[EventConstants.osSdk] = metadata
-        return payload
+    /// Sends partial batches once they have lingered, without waiting for the next Operation Repo flush.
+    /// This method is called on the dispatchQueue only.
+    private func scheduleLingerFlush(at deadline: Date) {
+        if let lingerFlushDeadline, lingerFlushDeadline <= deadline {
+            return
+        }
+        lingerFlushDeadline = deadline
+        let delay = max(0, deadline.timeIntervalSinceNow)
+        self.dispatchQueue.asyncAfter(deadline: .now() + delay) { [weak self] in
+            guard let self, self.lingerFlushDeadline == deadline else {
+                return
+            }
+            self.lingerFlushDeadline = nil
+            // Unpausing flushes the Operation Repo, which sends what lingered in the meantime
+            guard !OSOperationRepo.sharedInstance.paused else {
+                OneSignalLog.onesignalLog(.LL_DEBUG, message: "OSCustomEventsExecutor not sending lingering events due to the Operation Repo being paused")
+                return
+            }
+            self.batchDeltaQueue(sendPartialBatches: false)
+            self.processRequestQueue(inBackground: false)
+        }
     }
 
-    /// This method is called by `processDeltaQueue` only and does not need to be added to the dispatchQueue.
+    /// Requests for a user are sent one at a time, in order. The first request of each user is sent if it is not already in flight.
+    /// This method is called on the dispatchQueue only.
     private func processRequestQueue(inBackground: Bool) {
         if requestQueue.isEmpty {
             return
         }
 
-        for request in requestQueue {
+        var seenUsers = Set<String>()
+        for request in requestQueue where seenUsers.insert(request.identityModel.modelId).inserted {
             executeRequest(request, inBackground: inBackground)
         }
     }
@@ -276,6 +249,8 @@ class OSCustomEventsExecutor: OSOperationExecutor {
             self.dispatchQueue.async {
                 self.requestQueue.removeAll(where: { $0 == request})
                 OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY, withValue: self.requestQueue)
+                // Send this user's next request, if any
+                self.processRequestQueue(inBackground: inBackground)
                 if inBackground {
                     OSBackgroundTaskManager.endBackgroundTask(backgroundTaskIdentifier)
                 }
@@ -288,6 +263,11 @@ class OSCustomEventsExecutor: OSOperationExecutor {
                     // Fail, no retry, remove from cache and queue
                     self.requestQueue.removeAll(where: { $0 == request})
                     OneSignalUserDefaults.initShared().saveCodeableData(forKey: OS_CUSTOM_EVENTS_EXECUTOR_REQUEST_QUEUE_KEY, withValue: self.requestQueue)
+                    self.processRequestQueue(inBackground: inBackground)
+                } else {
+                    // Keep it at the front of this user's requests, so it is retried before any later events on the next flush
+                    request.sentToClient = false
+                    OSOperationRepo.sharedInstance.requestRetry()
                 }
                 // TODO: Handle payload too large (not necessary for alpha release)
                 if inBackground {
@@ -297,3 +277,39 @@ class OSCustomEventsExecutor: OSOperationExecutor {
         }
     }
 }
+
+/**
+ A user's events that are combined into one `OSRequestCustomEvents`, within the configured count and size limits.
+ */
+private struct OSCustomEventsBatch {
+    let identityModel: OSIdentityModel
+    private(set) var events: [[String: Any]] = []
+    private(set) var deltas: [OSDelta] = []
+    private(set) var size = 0
+
+    init(identityModel: OSIdentityModel) {
+        self.identityModel = identityModel
+    }
+
+    var oldestTimestamp: Date? {
+        deltas.first?.timestamp
+    }
+
+    /// Whether this batch cannot take an event of the given size. An oversized event still gets a batch of its own.
+    func isFull(adding eventSize: Int) -> Bool {
+        guard !events.isEmpty else {
+            return false
+        }
+        return events.count >= OneSignalConfig.customEventsMaxBatchSize || size + eventSize > OneSignalConfig.customEventsMaxBatchBytes
+    }
+
+    mutating func add(_ event: [String: Any], delta: OSDelta, size eventSize: Int) {
+        events.append(event)
+        deltas.append(delta)
+        size += eventSize
+    }
+
+    func makeRequest() -> OSRequestCustomEvents {
+        return OSRequestCustomEvents(events: events, identityModel: identityModel)
+    }
+}
@@ -126,6 +126,53 @@ class OSIdentityOperationExecutor: OSOperationExecutor {
         }
     }
 
+    var hasUnsentRequests: Bool {
+        self.dispatchQueue.sync {
+            self.addRequestQueue.contains { !$0.sentToClient } || self.removeRequestQueue.contains { !$0.sentToClient }
+        }
+    }
+
+    /// Folds an alias delta into the queued alias deltas for the same identity model.
+    /// Labels in `delta` are stripped from queued deltas of the opposite kind (dropping any left empty),
+    /// then merged into the queued delta of the same kind, so add-then-remove of a label only removes it.
+    /// Called on the Operation Repo's queue and does not touch executor state.
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta] {
+        guard let aliases = delta.value as? [String: String] else {
+            return queued + [delta]
+        }
+
+        var coalesced: [OSDelta] = []
+        for existing in queued {
+            guard existing.identityModelId == delta.identityModelId,
+                  existing.name != delta.name,
+                  let existingAliases = existing.value as? [String: String]
+            else {
+                coalesced.append(existing)
+                continue
+            }
+            let remaining = existingAliases.filter { aliases[$0.key] == nil }
+            if remaining.count == existingAliases.count {
+                coalesced.append(existing)
+            } else if !remaining.isEmpty {
+                coalesced.append(OSDelta(name: existing.name, identityModelId: existing.identityModelId, model: existing.model, property: existing.property, value: remaining))
+            }
+        }
+
+        if let index = coalesced.lastIndex(where: { $0.identityModelId == delta.identityModelId && $0.name == delta.name }),
+           let existingAliases = coalesced[index].value as? [String: String] {
+            coalesced[index] = OSDelta(
+                name: delta.name,
+                identityModelId: delta.identityModelId,
+                model: delta.model,
+                property: delta.property,
+                value: existingAliases.merging(aliases) { _, new in new }
+            )
+        } else {
+            coalesced.append(delta)
+        }
+        return coalesced
+    }
+
     func processDeltaQueue(inBackground: Bool) {
         self.dispatchQueue.async {
             if !self.deltaQueue.isEmpty {
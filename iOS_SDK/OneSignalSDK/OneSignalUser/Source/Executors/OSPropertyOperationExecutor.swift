@@ -129,6 +129,53 @@ class OSPropertyOperationExecutor: OSOperationExecutor {
         }
     }
 
+    var hasUnsentRequests: Bool {
+        self.dispatchQueue.sync {
+            self.updateRequestQueue.contains { !$0.sentToClient }
+        }
+    }
+
+    /// Folds a properties delta into the queued delta for the same user and property, ie: churny tag updates
+    /// collapse into one tags delta, and repeated `setLanguage` calls keep only the last value.
+    /// Called on the Operation Repo's queue and does not touch executor state.
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta] {
+        guard let property = OSPropertiesSupportedProperty(rawValue: delta.property),
+              let index = queued.lastIndex(where: { $0.identityModelId == delta.identityModelId && $0.property == delta.property })
+        else {
+            return queued + [delta]
+        }
+        let existing = queued[index]
+        let value: Any
+
+        switch property {
+        case .tags:
+            guard let existingTags = existing.value as? [String: String],
+                  let tags = delta.value as? [String: String]
+            else {
+                return queued + [delta]
+            }
+            // A later value wins, including "" which removes the tag
+            value = existingTags.merging(tags) { _, new in new }
+        case .session_time, .session_count:
+            value = (existing.value as? Int ?? 0) + (delta.value as? Int ?? 0)
+        case .purchases:
+            value = (existing.value as? [[String: AnyObject]] ?? []) + (delta.value as? [[String: AnyObject]] ?? [])
+        default:
+            // Last value wins for un-nested properties such as "language" and "location"
+            value = delta.value
+        }
+
+        var coalesced = queued
+        coalesced[index] = OSDelta(
+            name: delta.name,
+            identityModelId: delta.identityModelId,
+            model: delta.model,
+            property: delta.property,
+            value: value
+        )
+        return coalesced
+    }
+
     /// The `deltaQueue` should only contain updates for one user.
     /// Even when login -> addTag -> login -> addTag are called in immediate succession.
     func processDeltaQueue(inBackground: Bool) {
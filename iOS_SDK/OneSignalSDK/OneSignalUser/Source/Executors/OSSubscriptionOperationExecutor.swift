@@ -180,6 +180,29 @@ class OSSubscriptionOperationExecutor: OSOperationExecutor {
         }
     }
 
+    var hasUnsentRequests: Bool {
+        self.dispatchQueue.sync {
+            self.addRequestQueue.contains { !$0.sentToClient }
+                || self.removeRequestQueue.contains { !$0.sentToClient }
+                || self.updateRequestQueue.contains { !$0.sentToClient }
+        }
+    }
+
+    /// An update request is built from the subscription model rather than the delta's value, so an update delta
+    /// replaces the queued one for the same subscription, as long as no add or remove for it was queued after.
+    /// Called on the Operation Repo's queue and does not touch executor state.
+    func coalesce(_ delta: OSDelta, into queued: [OSDelta]) -> [OSDelta] {
+        guard delta.name == OS_UPDATE_SUBSCRIPTION_DELTA,
+              let index = queued.lastIndex(where: { $0.model.modelId == delta.model.modelId }),
+              queued[index].name == OS_UPDATE_SUBSCRIPTION_DELTA
+        else {
+            return queued + [delta]
+        }
+        var coalesced = queued
+        coalesced[index] = delta
+        return coalesced
+    }
+
     func processDeltaQueue(inBackground: Bool) {
         self.dispatchQueue.async {
             if !self.deltaQueue.isEmpty {
@@ -452,6 +475,7 @@ class OSSubscriptionOperationExecutor: OSOperationExecutor {
                 } else {
                     // Make the request eligible for the next flush
                     request.sentToClient = false
+                    OSOperationRepo.sharedInstance.requestRetry()
                 }
                 if inBackground {
                     OSBackgroundTaskManager.endBackgroundTask(backgroundTaskIdentifier)
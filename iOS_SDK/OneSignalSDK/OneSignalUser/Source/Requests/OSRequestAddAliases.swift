@@ -34,6 +34,9 @@ class OSRequestAddAliases: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .user
+    }
 
     var identityModel: OSIdentityModel
     let aliases: [String: String]
@@ -40,6 +40,9 @@ class OSRequestCreateUser: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .user
+    }
 
     var identityModel: OSIdentityModel
     var pushSubscriptionModel: OSSubscriptionModel?
@@ -34,6 +34,9 @@ class OSRequestCustomEvents: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .analytics
+    }
 
     var identityModel: OSIdentityModel
 
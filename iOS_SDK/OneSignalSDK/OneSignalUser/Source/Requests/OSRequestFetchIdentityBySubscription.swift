@@ -35,6 +35,9 @@ class OSRequestFetchIdentityBySubscription: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .user
+    }
 
     var identityModel: OSIdentityModel
     var pushSubscriptionModel: OSSubscriptionModel
@@ -41,6 +41,9 @@ class OSRequestIdentifyUser: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .user
+    }
 
     var identityModelToIdentify: OSIdentityModel
     var identityModelToUpdate: OSIdentityModel
@@ -34,6 +34,9 @@ class OSRequestRemoveAlias: OneSignalRequest, OSUserRequest {
     override var description: String {
         return stringDescription
     }
+    override var lane: OSRequestLane {
+        return .user
+    }
 
     let labelToRemove: String
     var identityModel: OSIdentityModel
@@ -0,0 +1,138 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import OneSignalCore
+import OneSignalOSCore
+
+/**
+ A tracked custom event, turned into the JSON object sent in `OSRequestCustomEvents`.
+ The SDK metadata added to every event is computed once, and timestamps are formatted without a `DateFormatter`.
+ */
+struct OSCustomEvent {
+    private enum EventConstants {
+        static let name = "name"
+        static let onesignalId = "onesignal_id"
+        static let timestamp = "timestamp"
+        static let payload = "payload"
+        static let deviceType = "device_type"
+        static let sdk = "sdk"
+        static let appVersion = "app_version"
+        static let type = "type"
+        static let deviceModel = "device_model"
+        static let deviceOs = "device_os"
+        static let osSdk = "os_sdk"
+        static let ios = "ios"
+        static let iOSPush = "iOSPush"
+    }
+
+    let name: String
+    let onesignalId: String
+    let timestamp: Date
+    let properties: [String: Any]
+
+    /**
+     Additional data about the SDK that is added to the event payload. None of it changes while the app is running.
+     */
+    private static let sdkMetadata: [String: Any] = {
+        // TODO: Exact information contained in payload should be confirmed before the custom events GA release
+        var metadata: [String: Any] = [
+            EventConstants.deviceType: EventConstants.ios,
+            EventConstants.sdk: ONESIGNAL_VERSION,
+            EventConstants.type: EventConstants.iOSPush,
+            EventConstants.deviceOs: UIDevice.current.systemVersion
+        ]
+        // Sent as null when missing
+        let appVersion: Any = (Bundle.main.infoDictionary?["CFBundleShortVersionString"] as? String) ?? NSNull()
+        let deviceModel: Any = (OSDeviceUtils.getDeviceVariant() as String?) ?? NSNull()
+        metadata[EventConstants.appVersion] = appVersion
+        metadata[EventConstants.deviceModel] = deviceModel
+        return metadata
+    }()
+
+    /// The encoded size of an event with empty strings and no properties, see `estimatedSize`.
+    private static let emptyEventSize: Int = {
+        let event = OSCustomEvent(name: "", onesignalId: "", timestamp: Date(timeIntervalSince1970: 0), properties: [:])
+        return (try? JSONSerialization.data(withJSONObject: event.jsonObject()).count) ?? 0
+    }()
+
+    func jsonObject() -> [String: Any] {
+        var payload = properties
+        payload[EventConstants.osSdk] = OSCustomEvent.sdkMetadata
+        return [
+            EventConstants.name: name,
+            EventConstants.onesignalId: onesignalId,
+            EventConstants.timestamp: OSISO8601DateEncoder.string(from: timestamp),
+            EventConstants.payload: payload
+        ]
+    }
+
+    /// Estimates the size of this event in the request body. Only the properties are serialized to find it.
+    var estimatedSize: Int {
+        var size = OSCustomEvent.emptyEventSize + name.utf8.count + onesignalId.utf8.count
+        if !properties.isEmpty,
+           JSONSerialization.isValidJSONObject(properties),
+           let data = try? JSONSerialization.data(withJSONObject: properties) {
+            // Less the braces, plus a comma before os_sdk
+            size += data.count - 1
+        }
+        return size
+    }
+}
+
+/**
+ Formats dates like an `ISO8601DateFormatter` with its default options, ie: `2024-05-01T09:30:00Z`.
+ */
+enum OSISO8601DateEncoder {
+    static func string(from date: Date) -> String {
+        var seconds = time_t(floor(date.timeIntervalSince1970))
+        var components = tm()
+        gmtime_r(&seconds, &components)
+
+        return withUnsafeTemporaryAllocation(of: UInt8.self, capacity: 20) { buffer in
+            func write(_ value: Int32, digits: Int, at offset: Int) {
+                var remaining = value
+                for index in stride(from: offset + digits - 1, through: offset, by: -1) {
+                    buffer[index] = UInt8(ascii: "0") + UInt8(remaining % 10)
+                    remaining /= 10
+                }
+            }
+            write(components.tm_year + 1900, digits: 4, at: 0)
+            buffer[4] = UInt8(ascii: "-")
+            write(components.tm_mon + 1, digits: 2, at: 5)
+            buffer[7] = UInt8(ascii: "-")
+            write(components.tm_mday, digits: 2, at: 8)
+            buffer[10] = UInt8(ascii: "T")
+            write(components.tm_hour, digits: 2, at: 11)
+            buffer[13] = UInt8(ascii: ":")
+            write(components.tm_min, digits: 2, at: 14)
+            buffer[16] = UInt8(ascii: ":")
+            write(components.tm_sec, digits: 2, at: 17)
+            buffer[19] = UInt8(ascii: "Z")
+            return String(decoding: buffer, as: UTF8.self)
+        }
+    }
+}
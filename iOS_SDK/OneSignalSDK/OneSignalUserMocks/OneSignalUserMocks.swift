@@ -41,6 +41,7 @@ public class OneSignalUserMocks: NSObject {
             OSResilientStorage.keyAppId: "",
             OSResilientStorage.keySubscriptionId: "",
             OSResilientStorage.keyReceiveReceiptsEnabled: "",
+            OSResilientStorage.keyReceiveReceiptsBatchEnabled: "",
             OSResilientStorage.keyHasPriorSession: ""
         ])
         _ = OSResilientStorage.snapshot()
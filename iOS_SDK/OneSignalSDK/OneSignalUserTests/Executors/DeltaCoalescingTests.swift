@@ -0,0 +1,140 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+import OneSignalOSCore
+import OneSignalCoreMocks
+import OneSignalOSCoreMocks
+import OneSignalUserMocks
+@testable import OneSignalUser
+
+/// Covers the executors' `coalesce` rules applied by the Operation Repo before persisting and dispatching.
+final class DeltaCoalescingTests: XCTestCase {
+    private let newRecordsState = MockNewRecordsState()
+    private let identityModel = OSIdentityModel(aliases: nil, changeNotifier: OSEventProducer())
+    private let propertiesModel = OSPropertiesModel(changeNotifier: OSEventProducer())
+
+    override func setUpWithError() throws {
+        OneSignalCoreMocks.clearUserDefaults()
+        OneSignalUserMocks.reset()
+        OneSignalIdentifiers.currentAppId = "test-app-id"
+    }
+
+    // MARK: - Properties
+
+    func testProperties_setThenRemoveTag_coalescesToRemoval() {
+        let executor = OSPropertyOperationExecutor(newRecordsState: newRecordsState)
+        let deltas = [
+            propertiesDelta(.tags, ["a": "1", "b": "2"]),
+            propertiesDelta(.tags, ["a": ""])
+        ]
+
+        let queue = fold(deltas, with: executor)
+
+        XCTAssertEqual(queue.count, 1)
+        XCTAssertEqual(queue.first?.value as? [String: String], ["a": "", "b": "2"])
+    }
+
+    func testProperties_repeatedLanguage_keepsLastValue() {
+        let executor = OSPropertyOperationExecutor(newRecordsState: newRecordsState)
+        let deltas = [
+            propertiesDelta(.language, "en"),
+            propertiesDelta(.tags, ["a": "1"]),
+            propertiesDelta(.language, "fr"),
+            propertiesDelta(.language, "de")
+        ]
+
+        let queue = fold(deltas, with: executor)
+
+        XCTAssertEqual(queue.map(\.property), ["language", "tags"])
+        XCTAssertEqual(queue.first?.value as? String, "de")
+    }
+
+    func testProperties_sessionTime_isSummed() {
+        let executor = OSPropertyOperationExecutor(newRecordsState: newRecordsState)
+        let queue = fold([propertiesDelta(.session_time, 10), propertiesDelta(.session_time, 5)], with: executor)
+
+        XCTAssertEqual(queue.count, 1)
+        XCTAssertEqual(queue.first?.value as? Int, 15)
+    }
+
+    func testProperties_differentUsers_areNotCoalesced() {
+        let executor = OSPropertyOperationExecutor(newRecordsState: newRecordsState)
+        let otherUser = OSIdentityModel(aliases: nil, changeNotifier: OSEventProducer())
+        let deltas = [
+            propertiesDelta(.tags, ["a": "1"]),
+            OSDelta(name: OS_UPDATE_PROPERTIES_DELTA, identityModelId: otherUser.modelId, model: propertiesModel, property: "tags", value: ["a": "2"])
+        ]
+
+        XCTAssertEqual(fold(deltas, with: executor).count, 2)
+    }
+
+    // MARK: - Identity
+
+    func testIdentity_addThenRemoveAlias_keepsOnlyRemoval() {
+        let executor = OSIdentityOperationExecutor(newRecordsState: newRecordsState)
+        let deltas = [
+            aliasDelta(OS_ADD_ALIAS_DELTA, ["x": "1", "y": "2"]),
+            aliasDelta(OS_REMOVE_ALIAS_DELTA, ["x": ""])
+        ]
+
+        let queue = fold(deltas, with: executor)
+
+        XCTAssertEqual(queue.map(\.name), [OS_ADD_ALIAS_DELTA, OS_REMOVE_ALIAS_DELTA])
+        XCTAssertEqual(queue[0].value as? [String: String], ["y": "2"])
+        XCTAssertEqual(queue[1].value as? [String: String], ["x": ""])
+    }
+
+    func testIdentity_addRemoveAddPairs_coalesceToFinalState() {
+        let executor = OSIdentityOperationExecutor(newRecordsState: newRecordsState)
+        let deltas = [
+            aliasDelta(OS_ADD_ALIAS_DELTA, ["x": "1"]),
+            aliasDelta(OS_REMOVE_ALIAS_DELTA, ["x": ""]),
+            aliasDelta(OS_ADD_ALIAS_DELTA, ["x": "2"])
+        ]
+
+        let queue = fold(deltas, with: executor)
+
+        XCTAssertEqual(queue.map(\.name), [OS_ADD_ALIAS_DELTA])
+        XCTAssertEqual(queue.first?.value as? [String: String], ["x": "2"])
+    }
+
+    // MARK: - Helpers
+
+    private func fold(_ deltas: [OSDelta], with executor: OSOperationExecutor) -> [OSDelta] {
+        deltas.reduce([]) { executor.coalesce($1, into: $0) }
+    }
+
+    private func propertiesDelta(_ property: OSPropertiesSupportedProperty, _ value: Any) -> OSDelta {
+        OSDelta(name: OS_UPDATE_PROPERTIES_DELTA, identityModelId: identityModel.modelId, model: propertiesModel, property: property.rawValue, value: value)
+    }
+
+    private func aliasDelta(_ name: String, _ aliases: [String: String]) -> OSDelta {
+        OSDelta(name: name, identityModelId: identityModel.modelId, model: identityModel, property: "aliases", value: aliases)
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+@testable import OneSignalUser
+
+final class OSCustomEventTests: XCTestCase {
+
+    func testISO8601DateEncoder_matchesISO8601DateFormatter() {
+        let formatter = ISO8601DateFormatter()
+        let dates = [
+            Date(timeIntervalSince1970: 0),
+            Date(timeIntervalSince1970: 951_782_400.999), // 2000-02-29, fractional seconds are dropped
+            Date(timeIntervalSince1970: 1_735_689_599), // 2024-12-31T23:59:59Z
+            Date()
+        ]
+        for date in dates {
+            XCTAssertEqual(OSISO8601DateEncoder.string(from: date), formatter.string(from: date))
+        }
+    }
+
+    func testJsonObject_includesSdkMetadata() throws {
+        let event = OSCustomEvent(name: "purchase", onesignalId: "osid", timestamp: Date(timeIntervalSince1970: 0), properties: ["price": 9.99])
+        let json = event.jsonObject()
+
+        XCTAssertEqual(json["name"] as? String, "purchase")
+        XCTAssertEqual(json["onesignal_id"] as? String, "osid")
+        XCTAssertEqual(json["timestamp"] as? String, "1970-01-01T00:00:00Z")
+        let payload = try XCTUnwrap(json["payload"] as? [String: Any])
+        XCTAssertEqual(payload["price"] as? Double, 9.99)
+        let osSdk = try XCTUnwrap(payload["os_sdk"] as? [String: Any])
+        XCTAssertEqual(osSdk["sdk"] as? String, ONESIGNAL_VERSION)
+        XCTAssertEqual(osSdk["device_type"] as? String, "ios")
+
+        let encodedSize = try JSONSerialization.data(withJSONObject: json).count
+        XCTAssertEqual(event.estimatedSize, encodedSize, accuracy: 2)
+    }
+
+    /// Serializes 100k events the way `OSCustomEventsExecutor` used to, with a new `ISO8601DateFormatter` and SDK metadata per event,
+    /// and with `OSCustomEvent`. Set `ONESIGNAL_RUN_BENCHMARKS` to run it; see the memory metric in the test report for allocations.
+    func testBenchmark_serialize100kEvents() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let eventCount = 100_000
+        let properties: [String: Any] = ["sku": "abc-123", "price": 9.99, "quantity": 2]
+        let timestamp = Date()
+
+        var legacySeconds = 0.0
+        var currentSeconds = 0.0
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            var start = Date()
+            var legacyEvents: [[String: Any]] = []
+            legacyEvents.reserveCapacity(eventCount)
+            for index in 0..<eventCount {
+                let metadata = [
+                    "device_type": "ios",
+                    "sdk": ONESIGNAL_VERSION,
+                    "app_version": Bundle.main.infoDictionary?["CFBundleShortVersionString"] as? String,
+                    "type": "iOSPush",
+                    "device_model": OSDeviceUtils.getDeviceVariant(),
+                    "device_os": UIDevice.current.systemVersion
+                ]
+                var payload = properties
+                payload["os_sdk"] = metadata
+                legacyEvents.append([
+                    "name": "event_\(index)",
+                    "onesignal_id": "osid",
+                    "timestamp": ISO8601DateFormatter().string(from: timestamp),
+                    "payload": payload
+                ])
+            }
+            legacySeconds = Date().timeIntervalSince(start)
+
+            start = Date()
+            var events: [[String: Any]] = []
+            events.reserveCapacity(eventCount)
+            for index in 0..<eventCount {
+                events.append(OSCustomEvent(name: "event_\(index)", onesignalId: "osid", timestamp: timestamp, properties: properties).jsonObject())
+            }
+            currentSeconds = Date().timeIntervalSince(start)
+        }
+
+        print("OSCustomEvent benchmark (\(eventCount) events): legacy \(legacySeconds)s, OSCustomEvent \(currentSeconds)s")
+        XCTAssertLessThan(currentSeconds, legacySeconds)
+    }
+}
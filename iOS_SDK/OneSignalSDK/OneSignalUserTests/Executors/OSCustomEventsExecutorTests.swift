@@ -59,6 +59,14 @@ final class OSCustomEventsExecutorTests: XCTestCase {
         )
     }
 
+    /// The event names of each custom events request, in the order the requests were sent.
+    func eventNames(_ requests: [OneSignalRequest]) -> [[String]] {
+        return requests.compactMap { $0 as? OSRequestCustomEvents }.map { request in
+            let events = request.parameters?["events"] as? [[String: Any]] ?? []
+            return events.compactMap { $0["name"] as? String }
+        }
+    }
+
     override func setUpWithError() throws {
         OneSignalCoreMocks.clearUserDefaults()
         OneSignalUserMocks.reset()
@@ -217,9 +225,9 @@ final class OSCustomEventsExecutorTests: XCTestCase {
         XCTAssertEqual(nested["number"] as? Double, 3.14)
     }
 
-    // MARK: - Multiple Events Tests (No Batching)
+    // MARK: - Batching Tests
 
-    func testProcessDeltaQueue_withMultipleEventsForSameUser_createsSeparateRequests() {
+    func testProcessDeltaQueue_withMultipleEventsForSameUser_combinesIntoOneRequest() {
         /* Setup */
         let mocks = CustomEventsMocks()
         let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
@@ -235,39 +243,16 @@ final class OSCustomEventsExecutorTests: XCTestCase {
         mocks.customEventsExecutor.enqueueDelta(delta2)
         mocks.customEventsExecutor.enqueueDelta(delta3)
         mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
-        OneSignalCoreMocks.waitUntil("Custom event requests did not complete") {
-            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self, expectedCount: 3)
+        OneSignalCoreMocks.waitUntil("Custom event request did not complete") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self)
         }
 
         /* Then */
-        // Should have 3 separate requests, one per event (no batching)
-        XCTAssertEqual(mocks.client.executedRequests.count, 3)
-
-        let requests = mocks.client.executedRequests.compactMap { $0 as? OSRequestCustomEvents }
-        XCTAssertEqual(requests.count, 3)
-
-        // Verify each request has exactly 1 event
-        for request in requests {
-            guard let events = request.parameters!["events"] as? [[String: Any]] else {
-                XCTFail("Expected events array in request")
-                return
-            }
-            XCTAssertEqual(events.count, 1, "Each request should contain exactly 1 event")
-        }
-
-        // Verify all event names are present
-        let eventNames = requests.compactMap { request -> String? in
-            guard let events = request.parameters!["events"] as? [[String: Any]],
-                  let event = events.first else {
-                return nil
-            }
-            return event["name"] as? String
-        }.sorted()
-
-        XCTAssertEqual(eventNames, ["event1", "event2", "event3"])
+        XCTAssertEqual(mocks.client.executedRequests.count, 1)
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1", "event2", "event3"]])
     }
 
-    func testProcessDeltaQueue_withEventsForMultipleUsers_createsSeparateRequestsPerEvent() {
+    func testProcessDeltaQueue_withEventsForMultipleUsers_createsOneRequestPerUser() {
         /* Setup */
         let mocks = CustomEventsMocks()
         let userA = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
@@ -281,41 +266,155 @@ final class OSCustomEventsExecutorTests: XCTestCase {
 
         /* When */
         mocks.customEventsExecutor.enqueueDelta(deltaUserA1)
-        mocks.customEventsExecutor.enqueueDelta(deltaUserA2)
         mocks.customEventsExecutor.enqueueDelta(deltaUserB1)
+        mocks.customEventsExecutor.enqueueDelta(deltaUserA2)
         mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
+        OneSignalCoreMocks.waitUntil("Custom event requests did not complete") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self, expectedCount: 2)
+        }
+
+        /* Then */
+        XCTAssertEqual(mocks.client.executedRequests.count, 2)
+        XCTAssertEqual(Set(eventNames(mocks.client.executedRequests)), [["userA_event1", "userA_event2"], ["userB_event1"]])
+    }
+
+    func testProcessDeltaQueue_splitsBatchesAtMaxSize_andSendsThemInOrder() {
+        /* Setup */
+        let mocks = CustomEventsMocks()
+        let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
+        OneSignalConfig.customEventsMaxBatchSize = 2
+        defer { OneSignalConfig.customEventsMaxBatchSize = Int(CUSTOM_EVENTS_MAX_BATCH_SIZE) }
+
+        mocks.client.fireSuccessForAllRequests = true
+        mocks.client.holdResponses = true
+
+        /* When */
+        for index in 1...5 {
+            mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event\(index)", properties: nil, identityModel: user.identityModel))
+        }
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
+        OneSignalCoreMocks.waitUntil("First request was not sent") {
+            mocks.client.startedRequestCount(ofType: OSRequestCustomEvents.self) > 0
+        }
+        RunLoop.current.run(until: Date().addingTimeInterval(0.1))
+
+        /* Then */
+        // A user's next request waits for the previous one to complete
+        XCTAssertEqual(eventNames(mocks.client.startedRequests), [["event1", "event2"]])
+
+        mocks.client.releaseHeldResponses()
         OneSignalCoreMocks.waitUntil("Custom event requests did not complete") {
             mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self, expectedCount: 3)
         }
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1", "event2"], ["event3", "event4"], ["event5"]])
+    }
+
+    func testProcessDeltaQueue_splitsBatchesAtMaxBytes() {
+        /* Setup */
+        let mocks = CustomEventsMocks()
+        let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
+        // Each event is a few hundred bytes with the SDK metadata, so this fits one event per request
+        OneSignalConfig.customEventsMaxBatchBytes = 100
+        defer { OneSignalConfig.customEventsMaxBatchBytes = Int(CUSTOM_EVENTS_MAX_BATCH_BYTES) }
+
+        mocks.client.fireSuccessForAllRequests = true
+
+        /* When */
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event1", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event2", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
+        OneSignalCoreMocks.waitUntil("Custom event requests did not complete") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self, expectedCount: 2)
+        }
+
+        /* Then */
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1"], ["event2"]])
+    }
+
+    func testProcessDeltaQueue_holdsPartialBatchUntilBackgrounded() {
+        /* Setup */
+        let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
+        OneSignalConfig.customEventsMaxLingerMilliseconds = 60_000
+        defer { OneSignalConfig.customEventsMaxLingerMilliseconds = Int(CUSTOM_EVENTS_MAX_LINGER_MS) }
+
+        var mocks = CustomEventsMocks()
+        mocks.client.fireSuccessForAllRequests = true
+
+        /* When */
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event1", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event2", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
 
         /* Then */
-        // Should have 3 separate requests, one per event (no batching)
-        XCTAssertEqual(mocks.client.executedRequests.count, 3)
-
-        let requests = mocks.client.executedRequests.compactMap { $0 as? OSRequestCustomEvents }
-        XCTAssertEqual(requests.count, 3)
-
-        // Verify each request has exactly 1 event
-        for request in requests {
-            guard let events = request.parameters!["events"] as? [[String: Any]] else {
-                XCTFail("Expected events array in request")
-                return
-            }
-            XCTAssertEqual(events.count, 1, "Each request should contain exactly 1 event")
+        // The partial batch is persisted as deltas, so it survives a restart
+        OneSignalCoreMocks.waitUntil("Partial batch was not cached") {
+            let deltas = OneSignalUserDefaults.initShared().getSavedCodeableData(
+                forKey: OS_CUSTOM_EVENTS_EXECUTOR_DELTA_QUEUE_KEY,
+                defaultValue: []
+            ) as? [OSDelta]
+            return deltas?.map(\.property) == ["event1", "event2"]
         }
+        XCTAssertEqual(mocks.client.executedRequests.count, 0)
+        XCTAssertFalse(mocks.customEventsExecutor.hasUnsentRequests, "The executor flushes lingering events itself")
 
-        // Count events by user
-        let eventsByUser = requests.reduce(into: [String: Int]()) { counts, request in
-            guard let events = request.parameters!["events"] as? [[String: Any]],
-                  let event = events.first,
-                  let onesignalId = event["onesignal_id"] as? String else {
-                return
-            }
-            counts[onesignalId, default: 0] += 1
+        /* When - Restart, then background the app */
+        mocks = CustomEventsMocks()
+        mocks.client.fireSuccessForAllRequests = true
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: true)
+        OneSignalCoreMocks.waitUntil("Custom event request did not complete") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self)
         }
 
-        XCTAssertEqual(eventsByUser[userA_OSID], 2, "Should have 2 events for userA")
-        XCTAssertEqual(eventsByUser[userB_OSID], 1, "Should have 1 event for userB")
+        /* Then */
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1", "event2"]])
+    }
+
+    func testProcessDeltaQueue_sendsPartialBatchAfterLingering() {
+        /* Setup */
+        let mocks = CustomEventsMocks()
+        let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
+        OneSignalConfig.customEventsMaxLingerMilliseconds = 200
+        defer { OneSignalConfig.customEventsMaxLingerMilliseconds = Int(CUSTOM_EVENTS_MAX_LINGER_MS) }
+
+        mocks.client.fireSuccessForAllRequests = true
+
+        /* When */
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event1", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
+
+        /* Then */
+        XCTAssertFalse(mocks.client.hasExecutedRequestOfType(OSRequestCustomEvents.self))
+        OneSignalCoreMocks.waitUntil("Lingering custom event was not sent") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self)
+        }
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1"]])
+    }
+
+    func testProcessDeltaQueue_doesNotSendLingeringEventsWhilePaused() {
+        /* Setup */
+        let mocks = CustomEventsMocks()
+        let user = OneSignalUserMocks.setUserManagerInternalUser(onesignalId: userA_OSID)
+        OneSignalConfig.customEventsMaxLingerMilliseconds = 100
+        defer { OneSignalConfig.customEventsMaxLingerMilliseconds = Int(CUSTOM_EVENTS_MAX_LINGER_MS) }
+
+        mocks.client.fireSuccessForAllRequests = true
+        OSOperationRepo.sharedInstance.addExecutor(mocks.customEventsExecutor)
+        OSOperationRepo.sharedInstance.paused = true
+
+        /* When */
+        mocks.customEventsExecutor.enqueueDelta(createCustomEventDelta(name: "event1", properties: nil, identityModel: user.identityModel))
+        mocks.customEventsExecutor.processDeltaQueue(inBackground: false)
+        Thread.sleep(forTimeInterval: 0.5)
+
+        /* Then */
+        XCTAssertFalse(mocks.client.hasExecutedRequestOfType(OSRequestCustomEvents.self), "The linger flush must respect the pause")
+
+        /* When - Unpausing flushes the Operation Repo */
+        OSOperationRepo.sharedInstance.paused = false
+        OneSignalCoreMocks.waitUntil("Lingering custom event was not sent after unpausing") {
+            mocks.client.hasCompletedRequestOfType(OSRequestCustomEvents.self)
+        }
+        XCTAssertEqual(eventNames(mocks.client.executedRequests), [["event1"]])
     }
 
     // MARK: - Missing OneSignal ID Tests
@@ -344,6 +443,7 @@ final class OSCustomEventsExecutorTests: XCTestCase {
         // No request should be made
         XCTAssertFalse(mocks.client.hasExecutedRequestOfType(OSRequestCustomEvents.self))
         XCTAssertEqual(mocks.client.executedRequests.count, 0)
+        XCTAssertTrue(mocks.customEventsExecutor.hasUnsentRequests, "The Operation Repo keeps flushing until the user has a onesignal ID")
     }
 
     // MARK: - Caching Tests
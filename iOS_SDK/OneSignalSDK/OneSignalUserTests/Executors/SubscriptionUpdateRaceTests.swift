@@ -50,7 +50,10 @@ final class SubscriptionUpdateRaceTests: XCTestCase {
         OneSignalLog.setLogLevel(.LL_VERBOSE)
     }
 
-    override func tearDownWithError() throws { }
+    override func tearDownWithError() throws {
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = Int(OP_REPO_FLUSH_DEBOUNCE_MS)
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = Int(POLL_INTERVAL_MS)
+    }
 
     /**
      Parameters are built from the live model at init and refreshed again in prepareForExecution before send
@@ -267,6 +270,53 @@ final class SubscriptionUpdateRaceTests: XCTestCase {
         XCTAssertEqual(lastPayload["enabled"] as? Bool, true)
     }
 
+    /**
+     A request that fails retryably is resent by the Operation Repo's next flush, without any new delta waking it up.
+     */
+    func testRetryableFailureIsResentWithoutNewEnqueue() throws {
+        let client = MockOneSignalClient()
+        OneSignalCoreImpl.setSharedClient(client)
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = 100
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = 100
+
+        let executor = OSSubscriptionOperationExecutor(newRecordsState: OSNewRecordsState())
+        OSOperationRepo.sharedInstance.addExecutor(executor)
+        let model = makePushSubscriptionModel(notificationTypes: subscribedNotificationTypes, subscriptionId: subscriptionId)
+
+        let requestKey = "OSRequestUpdateSubscription with model: \(model.modelId)"
+        client.setMockFailureResponseForRequest(
+            request: requestKey,
+            error: OneSignalClientError(code: 500, message: "retryable", responseHeaders: nil, response: nil, underlyingError: nil)
+        )
+
+        OSOperationRepo.sharedInstance.enqueueDelta(OSDelta(
+            name: OS_UPDATE_SUBSCRIPTION_DELTA,
+            identityModelId: UUID().uuidString,
+            model: model,
+            property: "notificationTypes",
+            value: subscribedNotificationTypes
+        ))
+        OSOperationRepo.sharedInstance.flushAndWait()
+        OneSignalCoreMocks.waitUntil("Retryable subscription update did not complete") {
+            client.hasCompletedRequestOfType(OSRequestUpdateSubscription.self)
+        }
+
+        // Server recovers, nothing else is enqueued
+        client.setMockResponseForRequest(request: requestKey, response: [:])
+        OneSignalCoreMocks.waitUntil("Failed subscription update was not resent") {
+            client.hasCompletedRequestOfType(OSRequestUpdateSubscription.self, expectedCount: 2)
+        }
+
+        XCTAssertEqual(client.executedRequests.compactMap { $0 as? OSRequestUpdateSubscription }.count, 2)
+        OneSignalCoreMocks.waitUntil("Subscription update was not removed from the cache") {
+            let requests = OneSignalUserDefaults.initShared().getSavedCodeableData(
+                forKey: OS_SUBSCRIPTION_EXECUTOR_UPDATE_REQUEST_QUEUE_KEY,
+                defaultValue: []
+            ) as? [OSRequestUpdateSubscription]
+            return requests?.isEmpty == true
+        }
+    }
+
     // MARK: - Helpers
 
     private func makePushSubscriptionModel(notificationTypes: Int, subscriptionId: String?) -> OSSubscriptionModel {
@@ -0,0 +1,102 @@
+/*
+ Modified MIT License
+
+ Copyright 2026 OneSignal
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ 1. The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ 2. All copies of substantial portions of the Software may only be used in connection
+ with services provided by OneSignal.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+import XCTest
+import OneSignalCore
+import OneSignalCoreMocks
+@testable import OneSignalOSCore
+@testable import OneSignalUser
+
+/**
+ Measures the time `OSModelStore` spends persisting under its lock for one model update,
+ for a user with 50 email and SMS subscriptions.
+ */
+final class OSModelStoreBenchmarkTests: XCTestCase {
+
+    private let storeKey = "OSModelStoreBenchmarkTests_storeKey"
+    private let subscriptionCount = 50
+    private let updateCount = 500
+
+    override func setUpWithError() throws {
+        OneSignalCoreMocks.clearUserDefaults()
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
+    }
+
+    override func tearDownWithError() throws {
+        OSModelStorePersistence.removeAll(storeKey: storeKey)
+    }
+
+    private func makeSubscriptions() -> [String: OSSubscriptionModel] {
+        var subscriptions: [String: OSSubscriptionModel] = [:]
+        for index in 0..<subscriptionCount {
+            let isEmail = index % 2 == 0
+            let address = isEmail ? "user\(index)@example.com" : "+1555000\(String(format: "%04d", index))"
+            subscriptions[address] = OSSubscriptionModel(
+                type: isEmail ? .email : .sms,
+                address: address,
+                subscriptionId: UUID().uuidString,
+                reachable: true,
+                isDisabled: false,
+                changeNotifier: OSEventProducer()
+            )
+        }
+        return subscriptions
+    }
+
+    /// Compares a per-model update against re-archiving every subscription into `storeKey`, as the store did previously.
+    /// Set `ONESIGNAL_RUN_BENCHMARKS` to run it.
+    func testBenchmark_updateOneOf50Subscriptions() throws {
+        try XCTSkipUnless(ProcessInfo.processInfo.environment["ONESIGNAL_RUN_BENCHMARKS"] != nil, "Benchmarks are opt-in")
+        let subscriptions = makeSubscriptions()
+        let store = OSModelStore<OSSubscriptionModel>(changeSubscription: OSEventProducer(), storeKey: storeKey)
+        for (address, model) in subscriptions {
+            store.add(id: address, model: model, hydrating: true)
+        }
+        let models = Array(subscriptions.values)
+
+        // The store persists synchronously inside its lock and has no listeners, so this is the time under `lock`
+        var start = Date()
+        for index in 0..<updateCount {
+            models[index % models.count].set(property: "enabled", newValue: index % 2 == 0)
+        }
+        let perModelMicroseconds = Date().timeIntervalSince(start) * 1_000_000 / Double(updateCount)
+
+        let lock = NSLock()
+        start = Date()
+        for _ in 0..<updateCount {
+            lock.withLock {
+                OneSignalUserDefaults.initShared().saveCodeableData(forKey: storeKey + "_legacy", withValue: subscriptions)
+            }
+        }
+        let legacyMicroseconds = Date().timeIntervalSince(start) * 1_000_000 / Double(updateCount)
+        OneSignalUserDefaults.initShared().removeValue(forKey: storeKey + "_legacy")
+
+        print("OSModelStore benchmark (\(subscriptionCount) subscriptions): per-model \(perModelMicroseconds)µs, whole store \(legacyMicroseconds)µs per update under lock")
+        XCTAssertEqual(OSModelStore<OSSubscriptionModel>(changeSubscription: OSEventProducer(), storeKey: storeKey).getModels().count, subscriptionCount)
+        XCTAssertLessThan(perModelMicroseconds, legacyMicroseconds)
+    }
+}
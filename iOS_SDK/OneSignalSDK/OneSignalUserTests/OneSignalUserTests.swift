@@ -126,8 +126,9 @@ final class OneSignalUserTests: XCTestCase {
         MockUserRequests.setDefaultCreateAnonUserResponses(with: client)
         OneSignalCoreImpl.setSharedClient(client)
 
-        // Increase flush interval to allow all the updates to batch
-        OSOperationRepo.sharedInstance.pollIntervalMilliseconds = 300
+        // Increase flush debounce and latency to allow all the updates to batch
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = 300
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = 300
 
         OSOperationRepo.sharedInstance.flushAndWait()
 
@@ -344,8 +344,9 @@ final class SwitchUserIntegrationTests: XCTestCase {
         let client = MockOneSignalClient()
         OneSignalCoreImpl.setSharedClient(client)
 
-        // Increase flush interval to allow all the updates to batch
-        OSOperationRepo.sharedInstance.pollIntervalMilliseconds = 300
+        // Increase flush debounce and latency to allow all the updates to batch
+        OneSignalConfig.operationRepoFlushDebounceMilliseconds = 300
+        OneSignalConfig.operationRepoMaxFlushLatencyMilliseconds = 300
         OSOperationRepo.sharedInstance.flushAndWait()
 
         // 1. Set up mock responses for the first anonymous user
@@ -370,6 +370,9 @@ static OneSignalReceiveReceiptsController* _receiveReceiptsController;
 
     [[OSSessionManager sharedSessionManager] restartSessionIfNeeded];
     
+    // Send the confirmed deliveries the notification service extension saved but did not get to send
+    [self.receiveReceiptsController sendPendingReceiveReceipts];
+
     [OneSignalTrackFirebaseAnalytics trackInfluenceOpenEvent];
     
     // Clear last location after attaching data to user state or not
@@ -468,9 +471,9 @@ static OneSignalReceiveReceiptsController* _receiveReceiptsController;
 /// Computes the initial value for `gProtectedDataAvailable` (see the case table in
 /// `+setupProtectedDataObserverOnce`).
 static BOOL ComputeInitialStorageReadable(void) {
-    NSDictionary *pushModels = [OneSignalUserDefaults.initShared getSavedCodeableDataForKey:OS_PUSH_SUBSCRIPTION_MODEL_STORE_KEY defaultValue:@{}];
+    BOOL hasPushModels = [OSModelStorePersistence hasPersistedModelsWithStoreKey:OS_PUSH_SUBSCRIPTION_MODEL_STORE_KEY];
     BOOL hasPriorSession = [OSResilientStorage stringForKey:OSResilientStorage.keyHasPriorSession] != nil;
-    if (pushModels.count > 0) { // UD is readable
+    if (hasPushModels) { // UD is readable
         return YES;
     }
     if (hasPriorSession) { // returning user during prewarm; defer
@@ -675,12 +678,14 @@ static BOOL ComputeInitialStorageReadable(void) {
         [standardUserDefaults removeValueForKey:OSUD_LEGACY_PLAYER_ID];
         [sharedUserDefaults removeValueForKey:OSUD_LEGACY_PLAYER_ID];
         [sharedUserDefaults removeValueForKey:OSUD_RECEIVE_RECEIPTS_ENABLED];
-        [sharedUserDefaults removeValueForKey:OS_PUSH_SUBSCRIPTION_MODEL_STORE_KEY];
+        [sharedUserDefaults removeValueForKey:OSUD_RECEIVE_RECEIPTS_BATCH_ENABLED];
+        [OSModelStorePersistence removeAllWithStoreKey:OS_PUSH_SUBSCRIPTION_MODEL_STORE_KEY];
 
         // Drop cached identifiers — a real app-id change invalidates them.
         [OSResilientStorage setStrings:@{
             OSResilientStorage.keySubscriptionId: @"",
             OSResilientStorage.keyReceiveReceiptsEnabled: @"",
+            OSResilientStorage.keyReceiveReceiptsBatchEnabled: @"",
             OSResilientStorage.keyHasPriorSession: @""
         }];
 
@@ -746,6 +751,12 @@ static BOOL ComputeInitialStorageReadable(void) {
             [OSResilientStorage setString:enabled ? @"1" : @"0" forKey:OSResilientStorage.keyReceiveReceiptsEnabled];
         }
 
+        if (result[IOS_RECEIVE_RECEIPTS_BATCH_ENABLE] != (id)[NSNull null]) {
+            BOOL enabled = [result[IOS_RECEIVE_RECEIPTS_BATCH_ENABLE] boolValue];
+            [OneSignalUserDefaults.initShared saveBoolForKey:OSUD_RECEIVE_RECEIPTS_BATCH_ENABLED withValue:enabled];
+            [OSResilientStorage setString:enabled ? @"1" : @"0" forKey:OSResilientStorage.keyReceiveReceiptsBatchEnabled];
+        }
+
         [[OSRemoteParamController sharedController] saveRemoteParams:result];
         [OSRemoteLoggingController configure];
         if ([[OSRemoteParamController sharedController] hasLocationKey]) {
@@ -105,6 +105,9 @@ static OneSignalLifecycleObserver* _instance = nil;
 
 - (void)didEnterBackground {
     [OneSignalLog onesignalLog:ONE_S_LL_VERBOSE message:@"application/scene didEnterBackground"];
+    // Write out saves a batch is still holding back before the app is suspended
+    [OneSignalUserDefaults.initShared flush];
+    [OneSignalUserDefaults.initStandard flush];
     if (OneSignalIdentifiers.currentAppId) {
         let oneSignalLocation = NSClassFromString(ONE_SIGNAL_LOCATION_CLASS_NAME);
         if (oneSignalLocation != nil && [oneSignalLocation respondsToSelector:@selector(onFocus:)]) {
@@ -35,11 +35,6 @@
 @implementation NSURLSessionOverrider
 
 + (void)load {
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wundeclared-selector"
-    // Swizzle an injected method defined in OneSignalHelper
-    injectStaticSelector([NSURLSessionOverrider class], @selector(overrideDownloadItemAtURL:toFile:error:), [NSURLSession class], @selector(downloadItemAtURL:toFile:error:));
-    #pragma clang diagnostic pop
     injectSelector(
         [NSURLSession class],
         @selector(dataTaskWithRequest:completionHandler:),
@@ -48,22 +43,6 @@
    );
 }
 
-// Override downloading of media attachment
-+ (NSString *)overrideDownloadItemAtURL:(NSURL*)url toFile:(NSString*)localPath error:(NSError**)error {
-    NSString *content = @"File Contents";
-    NSData *fileContents = [content dataUsingEncoding:NSUTF8StringEncoding];
-    [[NSFileManager defaultManager] createFileAtPath:localPath
-                                            contents:fileContents
-                                          attributes:nil];
-    
-    if ([url.absoluteString isEqualToString:@"http://domain.com/file"])
-        return @"image/png";
-    else if ([url.path isEqualToString:@"/secondFile"])
-        return @"image/heic";
-    else
-        return @"image/jpg";
-}
-
 - (NSURLSessionDataTask *)overrideDataTaskWithRequest:(NSURLRequest *)request completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
     
     // mimics no active network connection